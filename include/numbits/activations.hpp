@@ -0,0 +1,412 @@
+/**
+ * @file activations.hpp
+ * @brief Fused activation, softmax and normalization kernels.
+ *
+ * Provides:
+ *   - softmax(), log_softmax(), logsumexp(): along an axis, shifted by
+ *     the lane maximum for numerical stability
+ *   - sigmoid(), gelu(): element-wise activations
+ *   - layer_norm(): normalization over the last axis with optional affine
+ *     parameters
+ *   - standardize(): zero-mean, unit-variance scaling along any axis
+ *
+ * Each function reads its input at most twice and writes its output once,
+ * without temporaries: softmax takes one pass for the maximum and one
+ * that writes exp(x - max) while summing it, followed by an in-cache
+ * rescale. Mean and variance are accumulated in one pass with Welford's
+ * update. Lanes along an inner axis are processed in groups of adjacent
+ * columns, so the inner loops run across contiguous memory; contiguous
+ * lanes keep FUSED_WIDTH independent partial results that are combined at
+ * the end. Both forms vectorize without depending on the serial chain of
+ * a single accumulator. Lane groups are distributed over threads.
+ *
+ * All functions require a floating-point element type.
+ *
+ * @namespace numbits
+ */
+
+#pragma once
+
+#include "ndarray.hpp"
+#include "indexing.hpp"
+#include "utils.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+namespace numbits {
+
+/**
+ * @brief Independent partial results kept per contiguous lane.
+ */
+constexpr size_t FUSED_WIDTH = 16;
+
+/**
+ * @brief Minimum number of bytes processed before work is split across threads.
+ */
+constexpr size_t FUSED_PARALLEL_BYTES = size_t(1) << 16;
+
+/**
+ * @brief Maximum that propagates NaN from either argument.
+ */
+template<typename T>
+inline T nan_max(T a, T b) {
+    return (b > a || b != b) ? b : a;
+}
+
+/**
+ * @brief `m[c]` = maximum of lane `c` of a group of `width` lanes (NaN propagates).
+ */
+template<typename T>
+void lane_max(const T* x, size_t len, size_t stride, size_t width, T* m) {
+    if (width == 1 && stride == 1 && len >= 2 * FUSED_WIDTH) {
+        // One contiguous lane: FUSED_WIDTH interleaved partial maxima
+        T part[FUSED_WIDTH];
+        const size_t rows = len / FUSED_WIDTH;
+        lane_max(x, rows, FUSED_WIDTH, FUSED_WIDTH, part);
+        T best = part[0];
+        for (size_t c = 1; c < FUSED_WIDTH; ++c) best = nan_max(best, part[c]);
+        for (size_t j = rows * FUSED_WIDTH; j < len; ++j) best = nan_max(best, x[j]);
+        m[0] = best;
+        return;
+    }
+    for (size_t c = 0; c < width; ++c) m[c] = x[c];
+    for (size_t j = 1; j < len; ++j) {
+        const T* row = x + j * stride;
+        for (size_t c = 0; c < width; ++c) m[c] = nan_max(m[c], row[c]);
+    }
+}
+
+/**
+ * @brief `s[c]` = sum over lane `c` of exp(x - shift[c]); also stores the terms to `out` if given.
+ */
+template<typename T>
+void lane_sum_exp(const T* x, size_t len, size_t stride, size_t width,
+                  const T* shift, T* s, T* out) {
+    if (width == 1 && stride == 1 && len >= 2 * FUSED_WIDTH) {
+        T sh[FUSED_WIDTH], part[FUSED_WIDTH];
+        std::fill(sh, sh + FUSED_WIDTH, shift[0]);
+        const size_t rows = len / FUSED_WIDTH;
+        lane_sum_exp(x, rows, FUSED_WIDTH, FUSED_WIDTH, sh, part, out);
+        T total = T(0);
+        for (size_t c = 0; c < FUSED_WIDTH; ++c) total += part[c];
+        for (size_t j = rows * FUSED_WIDTH; j < len; ++j) {
+            T e = std::exp(x[j] - shift[0]);
+            if (out) out[j] = e;
+            total += e;
+        }
+        s[0] = total;
+        return;
+    }
+    std::fill(s, s + width, T(0));
+    for (size_t j = 0; j < len; ++j) {
+        const T* row = x + j * stride;
+        if (out) {
+            T* dst = out + j * stride;
+            for (size_t c = 0; c < width; ++c) {
+                T e = std::exp(row[c] - shift[c]);
+                dst[c] = e;
+                s[c] += e;
+            }
+        } else {
+            for (size_t c = 0; c < width; ++c) s[c] += std::exp(row[c] - shift[c]);
+        }
+    }
+}
+
+/**
+ * @brief Mean and sum of squared deviations of each lane, by Welford's update.
+ *
+ * Contiguous lanes accumulate FUSED_WIDTH interleaved partial results and
+ * merge them with Chan's pairwise formula.
+ */
+template<typename T>
+void lane_moments(const T* x, size_t len, size_t stride, size_t width, T* mean, T* m2) {
+    if (width == 1 && stride == 1 && len >= 2 * FUSED_WIDTH) {
+        T pm[FUSED_WIDTH], pm2[FUSED_WIDTH];
+        const size_t rows = len / FUSED_WIDTH;
+        lane_moments(x, rows, FUSED_WIDTH, FUSED_WIDTH, pm, pm2);
+        T mu = pm[0], sq = pm2[0];
+        T count = static_cast<T>(rows);
+        for (size_t c = 1; c < FUSED_WIDTH; ++c) {
+            const T total = count + static_cast<T>(rows);
+            const T d = pm[c] - mu;
+            mu += d * (static_cast<T>(rows) / total);
+            sq += pm2[c] + d * d * (count * static_cast<T>(rows) / total);
+            count = total;
+        }
+        for (size_t j = rows * FUSED_WIDTH; j < len; ++j) {
+            count += T(1);
+            const T d = x[j] - mu;
+            mu += d / count;
+            sq += d * (x[j] - mu);
+        }
+        mean[0] = mu;
+        m2[0] = sq;
+        return;
+    }
+    std::fill(mean, mean + width, T(0));
+    std::fill(m2, m2 + width, T(0));
+    for (size_t j = 0; j < len; ++j) {
+        const T* row = x + j * stride;
+        const T inv = T(1) / static_cast<T>(j + 1);
+        for (size_t c = 0; c < width; ++c) {
+            const T d = row[c] - mean[c];
+            mean[c] += d * inv;
+            m2[c] += d * (row[c] - mean[c]);
+        }
+    }
+}
+
+/**
+ * @brief Shift used for exp(): the lane maximum, or 0 if it is infinite or NaN.
+ */
+template<typename T>
+inline T softmax_shift(T m) {
+    return std::isfinite(m) ? m : T(0);
+}
+
+/**
+ * @brief Softmax along an axis: exp(x - max) / sum(exp(x - max)).
+ *
+ * @code
+ * auto probs = softmax(logits);        // over the last axis
+ * auto per_col = softmax(scores, 0);
+ * @endcode
+ *
+ * @throws std::runtime_error If axis is out of range
+ */
+template<typename T>
+ndarray<T> softmax(const ndarray<T>& arr, int axis = -1) {
+    static_assert(std::is_floating_point_v<T>, "softmax requires a floating-point type");
+    const AxisSplit split = split_axis(arr.shape(), normalize_axis(axis, arr.ndim()));
+    ndarray<T> result(arr.shape());
+    if (arr.size() == 0) return result;
+    const T* in = arr.data();
+    T* out = result.data();
+    const size_t stride = split.inner, len = split.len;
+    for_each_lane_group(split, arr.size() * sizeof(T) >= FUSED_PARALLEL_BYTES, [=](size_t base, size_t width) {
+        T shift[LANE_GROUP_COLUMNS] = {}, s[LANE_GROUP_COLUMNS] = {};
+        lane_max(in + base, len, stride, width, shift);
+        for (size_t c = 0; c < width; ++c) shift[c] = softmax_shift(shift[c]);
+        lane_sum_exp(in + base, len, stride, width, shift, s, out + base);
+        for (size_t c = 0; c < width; ++c) s[c] = T(1) / s[c];
+        for (size_t j = 0; j < len; ++j) {
+            T* row = out + base + j * stride;
+            for (size_t c = 0; c < width; ++c) row[c] *= s[c];
+        }
+    });
+    return result;
+}
+
+/**
+ * @brief Log-softmax along an axis: x - logsumexp(x).
+ *
+ * More accurate than log(softmax(x)) for strongly negative logits.
+ *
+ * @throws std::runtime_error If axis is out of range
+ */
+template<typename T>
+ndarray<T> log_softmax(const ndarray<T>& arr, int axis = -1) {
+    static_assert(std::is_floating_point_v<T>, "log_softmax requires a floating-point type");
+    const AxisSplit split = split_axis(arr.shape(), normalize_axis(axis, arr.ndim()));
+    ndarray<T> result(arr.shape());
+    if (arr.size() == 0) return result;
+    const T* in = arr.data();
+    T* out = result.data();
+    const size_t stride = split.inner, len = split.len;
+    for_each_lane_group(split, arr.size() * sizeof(T) >= FUSED_PARALLEL_BYTES, [=](size_t base, size_t width) {
+        T shift[LANE_GROUP_COLUMNS] = {}, s[LANE_GROUP_COLUMNS] = {};
+        lane_max(in + base, len, stride, width, shift);
+        for (size_t c = 0; c < width; ++c) shift[c] = softmax_shift(shift[c]);
+        lane_sum_exp(in + base, len, stride, width, shift, s, static_cast<T*>(nullptr));
+        for (size_t c = 0; c < width; ++c) s[c] = shift[c] + std::log(s[c]);
+        for (size_t j = 0; j < len; ++j) {
+            const T* src = in + base + j * stride;
+            T* row = out + base + j * stride;
+            for (size_t c = 0; c < width; ++c) row[c] = src[c] - s[c];
+        }
+    });
+    return result;
+}
+
+/**
+ * @brief log(sum(exp(x))) along an axis, computed without overflow.
+ *
+ * @return ndarray<T> The input shape with `axis` removed
+ * @throws std::runtime_error If axis is out of range
+ */
+template<typename T>
+ndarray<T> logsumexp(const ndarray<T>& arr, int axis) {
+    static_assert(std::is_floating_point_v<T>, "logsumexp requires a floating-point type");
+    const size_t ax = normalize_axis(axis, arr.ndim());
+    const AxisSplit split = split_axis(arr.shape(), ax);
+    Shape out_shape;
+    for (size_t i = 0; i < arr.ndim(); ++i)
+        if (i != ax) out_shape.push_back(arr.shape()[i]);
+    ndarray<T> result(out_shape);
+    if (result.size() == 0) return result;
+    const T* in = arr.data();
+    T* out = result.data();
+    const size_t stride = split.inner, len = split.len;
+    if (len == 0) {
+        result.fill(-std::numeric_limits<T>::infinity());
+        return result;
+    }
+    for_each_lane_group(split, arr.size() * sizeof(T) >= FUSED_PARALLEL_BYTES, [=](size_t base, size_t width) {
+        T shift[LANE_GROUP_COLUMNS] = {}, s[LANE_GROUP_COLUMNS] = {};
+        lane_max(in + base, len, stride, width, shift);
+        for (size_t c = 0; c < width; ++c) shift[c] = softmax_shift(shift[c]);
+        lane_sum_exp(in + base, len, stride, width, shift, s, static_cast<T*>(nullptr));
+        // Lane (o, c0 + c) reduces to output element o * inner + c0 + c
+        T* dst = out + (base / (len * stride)) * stride + base % stride;
+        for (size_t c = 0; c < width; ++c) dst[c] = shift[c] + std::log(s[c]);
+    });
+    return result;
+}
+
+/**
+ * @brief log(sum(exp(x))) over all elements.
+ */
+template<typename T>
+T logsumexp(const ndarray<T>& arr) {
+    static_assert(std::is_floating_point_v<T>, "logsumexp requires a floating-point type");
+    if (arr.size() == 0) return -std::numeric_limits<T>::infinity();
+    T shift, s;
+    lane_max(arr.data(), arr.size(), 1, 1, &shift);
+    shift = softmax_shift(shift);
+    lane_sum_exp(arr.data(), arr.size(), 1, 1, &shift, &s, static_cast<T*>(nullptr));
+    return shift + std::log(s);
+}
+
+/**
+ * @brief Apply `f` to every element in parallel for large arrays.
+ */
+template<typename T, typename F>
+ndarray<T> map_elements(const ndarray<T>& arr, F f) {
+    ndarray<T> result(arr.shape());
+    const T* in = arr.data();
+    T* out = result.data();
+    const index_t n = static_cast<index_t>(arr.size());
+    const bool parallel = arr.size() * sizeof(T) >= FUSED_PARALLEL_BYTES;
+    (void)parallel;
+#ifdef _OPENMP
+    #pragma omp parallel for if(parallel) schedule(static)
+#endif
+    for (index_t i = 0; i < n; ++i) out[i] = f(in[i]);
+    return result;
+}
+
+/**
+ * @brief Element-wise logistic sigmoid 1 / (1 + exp(-x)).
+ *
+ * Evaluated through exp(-|x|), which never overflows.
+ */
+template<typename T>
+ndarray<T> sigmoid(const ndarray<T>& arr) {
+    static_assert(std::is_floating_point_v<T>, "sigmoid requires a floating-point type");
+    return map_elements(arr, [](T x) {
+        const T e = std::exp(-std::fabs(x));
+        const T r = T(1) / (T(1) + e);
+        return x >= T(0) ? r : e * r;
+    });
+}
+
+/**
+ * @brief Element-wise Gaussian error linear unit x * Phi(x).
+ *
+ * @param approximate Use the tanh approximation instead of erf
+ */
+template<typename T>
+ndarray<T> gelu(const ndarray<T>& arr, bool approximate = false) {
+    static_assert(std::is_floating_point_v<T>, "gelu requires a floating-point type");
+    if (approximate) {
+        const T k = static_cast<T>(0.7978845608028654);  // sqrt(2 / pi)
+        return map_elements(arr, [k](T x) {
+            return T(0.5) * x * (T(1) + std::tanh(k * (x + T(0.044715) * x * x * x)));
+        });
+    }
+    const T inv_sqrt2 = static_cast<T>(0.7071067811865476);
+    return map_elements(arr, [inv_sqrt2](T x) {
+        return T(0.5) * x * (T(1) + std::erf(x * inv_sqrt2));
+    });
+}
+
+/**
+ * @brief (x - mean) / sqrt(var + eps) along an axis, optionally scaled by
+ *        `gamma[j]` and shifted by `beta[j]` at position `j` of the axis.
+ */
+template<typename T>
+ndarray<T> normalize_lanes(const ndarray<T>& arr, size_t axis, T eps, const T* gamma, const T* beta) {
+    const AxisSplit split = split_axis(arr.shape(), axis);
+    ndarray<T> result(arr.shape());
+    if (arr.size() == 0) return result;
+    const T* in = arr.data();
+    T* out = result.data();
+    const size_t stride = split.inner, len = split.len;
+    for_each_lane_group(split, arr.size() * sizeof(T) >= FUSED_PARALLEL_BYTES, [=](size_t base, size_t width) {
+        T mean[LANE_GROUP_COLUMNS] = {}, scale[LANE_GROUP_COLUMNS] = {};
+        lane_moments(in + base, len, stride, width, mean, scale);
+        for (size_t c = 0; c < width; ++c)
+            scale[c] = T(1) / std::sqrt(scale[c] / static_cast<T>(len) + eps);
+        for (size_t j = 0; j < len; ++j) {
+            const T* src = in + base + j * stride;
+            T* row = out + base + j * stride;
+            const T g = gamma ? gamma[j] : T(1), b = beta ? beta[j] : T(0);
+            for (size_t c = 0; c < width; ++c) row[c] = (src[c] - mean[c]) * scale[c] * g + b;
+        }
+    });
+    return result;
+}
+
+/**
+ * @brief Layer normalization over the last axis.
+ *
+ * @code
+ * auto h = layer_norm(x, gamma, beta);   // x: {batch, features}
+ * @endcode
+ *
+ * @param gamma Per-feature scale, one value per element of the last axis
+ * @param beta Per-feature shift, one value per element of the last axis
+ * @param eps Added to the variance before the square root
+ *
+ * @throws std::runtime_error If arr is 0-D or gamma/beta have the wrong size
+ */
+template<typename T>
+ndarray<T> layer_norm(const ndarray<T>& arr, const ndarray<T>& gamma, const ndarray<T>& beta,
+                      T eps = static_cast<T>(1e-5)) {
+    static_assert(std::is_floating_point_v<T>, "layer_norm requires a floating-point type");
+    if (arr.ndim() == 0) throw std::runtime_error("layer_norm: array must have at least one axis");
+    const size_t features = arr.shape()[arr.ndim() - 1];
+    if (gamma.size() != features || beta.size() != features)
+        throw std::runtime_error("layer_norm: gamma and beta must match the last dimension");
+    return normalize_lanes(arr, arr.ndim() - 1, eps, gamma.data(), beta.data());
+}
+
+/**
+ * @brief Layer normalization over the last axis without affine parameters.
+ * @throws std::runtime_error If arr is 0-D
+ */
+template<typename T>
+ndarray<T> layer_norm(const ndarray<T>& arr, T eps = static_cast<T>(1e-5)) {
+    static_assert(std::is_floating_point_v<T>, "layer_norm requires a floating-point type");
+    if (arr.ndim() == 0) throw std::runtime_error("layer_norm: array must have at least one axis");
+    return normalize_lanes(arr, arr.ndim() - 1, eps, static_cast<const T*>(nullptr), static_cast<const T*>(nullptr));
+}
+
+/**
+ * @brief Scale each lane along an axis to zero mean and unit (population) variance.
+ *
+ * @param eps Added to the variance; with the default 0 a constant lane yields NaN
+ * @throws std::runtime_error If axis is out of range
+ */
+template<typename T>
+ndarray<T> standardize(const ndarray<T>& arr, int axis = -1, T eps = T(0)) {
+    static_assert(std::is_floating_point_v<T>, "standardize requires a floating-point type");
+    return normalize_lanes(arr, normalize_axis(axis, arr.ndim()), eps,
+                           static_cast<const T*>(nullptr), static_cast<const T*>(nullptr));
+}
+
+} // namespace numbits
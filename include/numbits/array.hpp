@@ -0,0 +1,293 @@
+/**
+ * @file array.hpp
+ * @brief Type-erased array handle with a runtime DType.
+ *
+ * Provides:
+ *   - array: shared handle to an ndarray of any supported element type
+ *   - load_any(), dump(): `.cb` files of any dtype
+ *   - promote_types(): common dtype of two operands
+ *   - add(), subtract(), multiply(), divide(): element-wise with promotion
+ *     and broadcasting
+ *   - sum(), mean(), min(), max(): reductions returned as double
+ *
+ * Each function resolves the dtype once with visit_dtype() and runs the
+ * typed ndarray implementation, so code that handles arbitrary files is
+ * compiled once instead of once per element type. Copying an array
+ * shares its storage; astype() to the same dtype and operands that
+ * already have the common dtype are not copied.
+ *
+ * @namespace numbits
+ */
+
+#pragma once
+
+#include "ndarray.hpp"
+#include "cast.hpp"
+#include "operations.hpp"
+#include "io.hpp"
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace numbits {
+
+/**
+ * @class array
+ * @brief Reference-counted ndarray whose element type is a runtime DType.
+ *
+ * @code
+ * array a = load_any("features.cb");          // any stored dtype
+ * array b = add(a, array(ndarray<double>({1}, {0.5})));
+ * double total = sum(b);
+ * ndarray<float>& typed = b.astype(DType::FLOAT32).as<float>();
+ * @endcode
+ */
+class array {
+public:
+    /** @brief Empty handle (no storage); dtype() is FLOAT32 and size() is 0. */
+    array() = default;
+
+    /**
+     * @brief Take ownership of a typed ndarray.
+     *
+     * Explicit, so typed calls never silently convert and type-promote
+     * through the array overloads (e.g. add(ndarray<float>, ndarray<double>)).
+     */
+    template<typename T>
+    explicit array(ndarray<T> arr)
+        : dtype_(dtype_from_type<T>()), storage_(std::make_shared<ndarray<T>>(std::move(arr))) {}
+
+    /**
+     * @brief Zero-filled array of the given shape and dtype.
+     *
+     * @throws std::runtime_error If the dtype is not supported
+     */
+    array(const Shape& shape, DType dtype) : dtype_(dtype) {
+        storage_ = visit_dtype(dtype, [&](auto tag) -> std::shared_ptr<void> {
+            using T = typename decltype(tag)::type;
+            return std::make_shared<ndarray<T>>(shape);
+        });
+    }
+
+    /**
+     * @brief The stored ndarray as its concrete type.
+     *
+     * @throws std::runtime_error If T does not match dtype() or the handle is empty
+     */
+    template<typename T>
+    ndarray<T>& as() {
+        check_type<T>();
+        return *static_cast<ndarray<T>*>(storage_.get());
+    }
+
+    template<typename T>
+    const ndarray<T>& as() const {
+        check_type<T>();
+        return *static_cast<const ndarray<T>*>(storage_.get());
+    }
+
+    /**
+     * @brief Call `fn(ndarray<T>&)` with the stored ndarray and return its result.
+     */
+    template<typename Fn>
+    decltype(auto) visit(Fn&& fn) {
+        return visit_dtype(dtype_, [&](auto tag) -> decltype(auto) {
+            return fn(as<typename decltype(tag)::type>());
+        });
+    }
+
+    template<typename Fn>
+    decltype(auto) visit(Fn&& fn) const {
+        return visit_dtype(dtype_, [&](auto tag) -> decltype(auto) {
+            return fn(as<typename decltype(tag)::type>());
+        });
+    }
+
+    DType dtype() const { return dtype_; }
+    bool empty() const { return storage_ == nullptr; }
+    const Shape& shape() const {
+        static const Shape none;
+        return storage_ ? visit([](const auto& arr) -> const Shape& { return arr.shape(); }) : none;
+    }
+    size_t ndim() const { return shape().size(); }
+    size_t size() const { return storage_ ? visit([](const auto& arr) { return arr.size(); }) : 0; }
+    size_t nbytes() const { return size() * dtype_size(dtype_); }
+
+    /** @brief Raw pointer to the contiguous elements (nullptr when empty). */
+    void* data() { return storage_ ? visit([](auto& arr) -> void* { return arr.data(); }) : nullptr; }
+    const void* data() const {
+        return storage_ ? visit([](const auto& arr) -> const void* { return arr.data(); }) : nullptr;
+    }
+
+    /**
+     * @brief Convert to another dtype; returns a handle to the same storage if it already matches.
+     */
+    array astype(DType to, CastOptions options = CastOptions()) const {
+        if (to == dtype_ || !storage_) return *this;
+        array out(shape(), to);
+        cast(data(), dtype_, out.data(), to, size(), options);
+        return out;
+    }
+
+    /**
+     * @brief Deep copy with its own storage.
+     */
+    array copy() const {
+        if (!storage_) return array();
+        return visit([](const auto& arr) { return array(arr); });  // ndarray copies are deep
+    }
+
+    void print(std::ostream& os = std::cout) const {
+        if (storage_) visit([&](const auto& arr) { arr.print(os); });
+    }
+
+private:
+    template<typename T>
+    void check_type() const {
+        if (!storage_) throw std::runtime_error("array is empty");
+        if (dtype_from_type<T>() != dtype_) throw std::runtime_error("Type mismatch: array holds a different dtype");
+    }
+
+    DType dtype_ = DType::FLOAT32;
+    std::shared_ptr<void> storage_; ///< Owns an ndarray<T> with T = dtype_to_type<dtype_>
+};
+
+/**
+ * @brief Load a `.cb` file of any stored dtype.
+ *
+ * @throws std::runtime_error If the file cannot be read or its dtype is unknown
+ */
+inline array load_any(const std::string& filename) {
+    const std::string full_filename = ensure_cb_extension(filename);
+    DType dtype;
+    {
+        std::ifstream file(full_filename, std::ios::binary);
+        if (!file) throw std::runtime_error("Cannot open file: " + full_filename);
+        dtype = read_cb_header(file, full_filename).dtype;
+    }
+    return visit_dtype(dtype, [&](auto tag) {
+        using T = typename decltype(tag)::type;
+        return array(load<T>(full_filename));
+    });
+}
+
+/**
+ * @brief Dump an array with its runtime dtype (see dump(const ndarray<T>&, ...)).
+ */
+inline void dump(const array& arr, const std::string& filename) {
+    arr.visit([&](const auto& typed) { dump(typed, filename); });
+}
+
+/**
+ * @brief Common dtype for an operation between two dtypes.
+ *
+ * Integers of the same signedness widen to the larger type; mixed signed
+ * and unsigned integers use the smallest signed type that holds both, or
+ * FLOAT64 if there is none. Any integer or bool with a floating-point
+ * type gives that type, with float16/bfloat16 widened to FLOAT32;
+ * float16 with bfloat16 also gives FLOAT32. bool yields to any other type.
+ */
+inline DType promote_types(DType a, DType b) {
+    if (a == b) return a;
+    if (a == DType::BOOL) return b;
+    if (b == DType::BOOL) return a;
+    return visit_dtype(a, [&](auto ta) {
+        return visit_dtype(b, [&](auto tb) {
+            using A = typename decltype(ta)::type;
+            using B = typename decltype(tb)::type;
+            constexpr bool fa = std::is_floating_point_v<A> || is_half_v<A>;
+            constexpr bool fb = std::is_floating_point_v<B> || is_half_v<B>;
+            if constexpr (fa && fb) {
+                if constexpr (is_half_v<A> && is_half_v<B>) return DType::FLOAT32;
+                else return sizeof(A) >= sizeof(B) ? dtype_from_type<A>() : dtype_from_type<B>();
+            } else if constexpr (fa || fb) {
+                using F = std::conditional_t<fa, A, B>;
+                return is_half_v<F> ? DType::FLOAT32 : dtype_from_type<F>();
+            } else if constexpr (std::is_signed_v<A> == std::is_signed_v<B>) {
+                return sizeof(A) >= sizeof(B) ? dtype_from_type<A>() : dtype_from_type<B>();
+            } else {
+                constexpr size_t need = std::is_signed_v<A> ? std::max(sizeof(A), 2 * sizeof(B))
+                                                            : std::max(sizeof(B), 2 * sizeof(A));
+                if constexpr (need <= 4) return DType::INT32;
+                else if constexpr (need <= 8) return DType::INT64;
+                else return DType::FLOAT64;
+            }
+        });
+    });
+}
+
+/**
+ * @brief Promote both operands to their common dtype and call `fn(ndarray<T>, ndarray<T>)`.
+ */
+template<typename Fn>
+array binary_dispatch(const array& a, const array& b, Fn fn) {
+    const DType common = promote_types(a.dtype(), b.dtype());
+    const array x = a.astype(common), y = b.astype(common);
+    return visit_dtype(common, [&](auto tag) {
+        using T = typename decltype(tag)::type;
+        return array(fn(x.as<T>(), y.as<T>()));
+    });
+}
+
+/** @brief Element-wise a + b with type promotion and broadcasting. */
+inline array add(const array& a, const array& b) {
+    return binary_dispatch(a, b, [](const auto& x, const auto& y) { return add(x, y); });
+}
+
+/** @brief Element-wise a - b with type promotion and broadcasting. */
+inline array subtract(const array& a, const array& b) {
+    return binary_dispatch(a, b, [](const auto& x, const auto& y) { return subtract(x, y); });
+}
+
+/** @brief Element-wise a * b with type promotion and broadcasting. */
+inline array multiply(const array& a, const array& b) {
+    return binary_dispatch(a, b, [](const auto& x, const auto& y) { return multiply(x, y); });
+}
+
+/** @brief Element-wise a / b with type promotion and broadcasting. */
+inline array divide(const array& a, const array& b) {
+    return binary_dispatch(a, b, [](const auto& x, const auto& y) { return divide(x, y); });
+}
+
+/**
+ * @brief Sum of all elements as double; integers and bool accumulate exactly in 64 bits.
+ */
+inline double sum(const array& arr) {
+    return arr.visit([](const auto& typed) {
+        using T = typename std::decay_t<decltype(typed)>::value_type;
+        using A = std::conditional_t<std::is_same_v<T, bool> || std::is_unsigned_v<T>, uint64_t,
+                                     std::conditional_t<std::is_integral_v<T>, int64_t, double>>;
+        A total = 0;
+        for (const T& v : typed) total += static_cast<A>(v);
+        return static_cast<double>(total);
+    });
+}
+
+/**
+ * @brief Mean of all elements as double (0 for an empty array).
+ */
+inline double mean(const array& arr) {
+    return arr.size() == 0 ? 0.0 : sum(arr) / static_cast<double>(arr.size());
+}
+
+/**
+ * @brief Smallest element as double.
+ * @throws std::runtime_error If the array is empty
+ */
+inline double min(const array& arr) {
+    return arr.visit([](const auto& typed) { return static_cast<double>(min(typed)); });
+}
+
+/**
+ * @brief Largest element as double.
+ * @throws std::runtime_error If the array is empty
+ */
+inline double max(const array& arr) {
+    return arr.visit([](const auto& typed) { return static_cast<double>(max(typed)); });
+}
+
+} // namespace numbits
@@ -0,0 +1,188 @@
+/**
+ * @file async_io.hpp
+ * @brief Asynchronous prefetching loader for `.cb` files.
+ *
+ * Provides AsyncLoader, which moves load() calls onto a background I/O
+ * thread so that disk reads overlap with computation:
+ *   - submit(): queue a single load and receive a std::future
+ *   - next()/has_next(): iterate over a list of shards while keeping
+ *     up to `depth` loads in flight ahead of the consumer
+ *
+ * @namespace numbits
+ */
+
+#pragma once
+
+#include "ndarray.hpp"
+#include "io.hpp"
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <stdexcept>
+
+namespace numbits {
+
+/**
+ * @class AsyncLoader
+ * @brief Loads `.cb` files on a background thread and hands them out as futures.
+ *
+ * Requests are served in submission order by a single worker thread. At most
+ * `depth` requests may be waiting in the queue; submit() blocks once the
+ * queue is full, which bounds the amount of read-ahead memory.
+ *
+ * @code
+ * AsyncLoader<float> loader({"shard0.cb", "shard1.cb", "shard2.cb"}, 2);
+ * while (loader.has_next()) {
+ *     ndarray<float> shard = loader.next();  // next shards are already loading
+ *     train_step(shard);
+ * }
+ * @endcode
+ *
+ * Errors raised by load() (missing file, type mismatch, ...) are delivered
+ * through the corresponding future. Requests still queued when the loader is
+ * destroyed are abandoned and their futures report std::future_error.
+ *
+ * @tparam T Expected element type of every file.
+ */
+template<typename T>
+class AsyncLoader {
+public:
+    /**
+     * @brief Start a loader with an empty queue.
+     *
+     * @param depth Maximum number of queued requests (must be positive).
+     * @throws std::runtime_error if depth is 0.
+     */
+    explicit AsyncLoader(size_t depth = 2) : depth_(depth) {
+        if (depth_ == 0) throw std::runtime_error("AsyncLoader: depth must be positive");
+        worker_ = std::thread(&AsyncLoader::run, this);
+    }
+
+    /**
+     * @brief Start a loader that prefetches a sequence of files.
+     *
+     * The first `depth` files are queued immediately; each call to next()
+     * queues one more.
+     *
+     * @param files Files to load, in consumption order.
+     * @param depth Number of loads kept in flight ahead of the consumer.
+     */
+    AsyncLoader(std::vector<std::string> files, size_t depth = 2)
+        : AsyncLoader(depth)
+    {
+        files_ = std::move(files);
+        while (pending_.size() < depth_ && next_file_ < files_.size()) {
+            pending_.push_back(submit(files_[next_file_++]));
+        }
+    }
+
+    AsyncLoader(const AsyncLoader&) = delete;
+    AsyncLoader& operator=(const AsyncLoader&) = delete;
+
+    /**
+     * @brief Stop the worker thread after the load in progress finishes.
+     */
+    ~AsyncLoader() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        not_empty_.notify_all();
+        not_full_.notify_all();
+        if (worker_.joinable()) worker_.join();
+    }
+
+    /** @return Maximum number of queued requests. */
+    size_t depth() const { return depth_; }
+
+    /**
+     * @brief Queue a file for loading.
+     *
+     * Blocks while `depth()` requests are already waiting.
+     *
+     * @param filename Path to a `.cb` file (extension appended if missing).
+     * @return Future that becomes ready once the array has been read.
+     */
+    std::future<ndarray<T>> submit(const std::string& filename) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        not_full_.wait(lock, [this] { return stop_ || queue_.size() < depth_; });
+        if (stop_) throw std::runtime_error("AsyncLoader: loader is shutting down");
+
+        Request request{filename, std::promise<ndarray<T>>()};
+        std::future<ndarray<T>> result = request.promise.get_future();
+        queue_.push_back(std::move(request));
+        lock.unlock();
+        not_empty_.notify_one();
+        return result;
+    }
+
+    /**
+     * @return true while files passed to the sequence constructor remain.
+     */
+    bool has_next() const { return !pending_.empty(); }
+
+    /**
+     * @brief Return the next file of the sequence, waiting if it is not ready yet.
+     *
+     * @throws std::runtime_error if the sequence is exhausted.
+     * @throws Any exception raised while loading the file.
+     */
+    ndarray<T> next() {
+        if (pending_.empty()) throw std::runtime_error("AsyncLoader: no more files");
+
+        std::future<ndarray<T>> front = std::move(pending_.front());
+        pending_.pop_front();
+        if (next_file_ < files_.size()) {
+            pending_.push_back(submit(files_[next_file_++]));
+        }
+        return front.get();
+    }
+
+private:
+    struct Request {
+        std::string filename;
+        std::promise<ndarray<T>> promise;
+    };
+
+    /**
+     * @brief Worker loop: pop requests in order and fulfil their promises.
+     */
+    void run() {
+        for (;;) {
+            Request request;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                not_empty_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+                if (stop_) return;
+                request = std::move(queue_.front());
+                queue_.pop_front();
+            }
+            not_full_.notify_one();
+
+            try {
+                request.promise.set_value(load<T>(request.filename));
+            } catch (...) {
+                request.promise.set_exception(std::current_exception());
+            }
+        }
+    }
+
+    size_t depth_;
+    std::deque<Request> queue_;
+    std::mutex mutex_;
+    std::condition_variable not_empty_;
+    std::condition_variable not_full_;
+    bool stop_ = false;
+
+    std::vector<std::string> files_;
+    size_t next_file_ = 0;
+    std::deque<std::future<ndarray<T>>> pending_;
+
+    std::thread worker_;
+};
+
+} // namespace numbits
@@ -0,0 +1,377 @@
+/**
+ * @file bitmask.hpp
+ * @brief Bit-packed boolean arrays.
+ *
+ * Provides bitmask, a boolean array storing 64 flags per machine word:
+ *   - Comparisons that emit packed results directly (equal_bits, less_bits, ...)
+ *   - Word-wise logical_and/or/xor/not and the matching operators
+ *   - all(), any(), count_nonzero() via population counts
+ *   - where() selecting between two arrays under a packed condition
+ *   - Cheap conversion to and from ndarray<bool>
+ *
+ * A bitmask uses one eighth of the memory of ndarray<bool>, so combining
+ * large masks moves eight times less data.
+ *
+ * @namespace numbits
+ */
+
+#pragma once
+
+#include "ndarray.hpp"
+#include "broadcasting.hpp"
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace numbits {
+
+/**
+ * @brief Minimum number of words processed before bitmask kernels run in parallel.
+ */
+constexpr size_t BITMASK_PARALLEL_WORDS = size_t(1) << 13;
+
+/**
+ * @brief Number of set bits in a 64-bit word.
+ */
+inline size_t popcount64(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<size_t>(__builtin_popcountll(x));
+#else
+    x = x - ((x >> 1) & 0x5555555555555555ull);
+    x = (x & 0x3333333333333333ull) + ((x >> 2) & 0x3333333333333333ull);
+    x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+    return static_cast<size_t>((x * 0x0101010101010101ull) >> 56);
+#endif
+}
+
+/**
+ * @class bitmask
+ * @brief Boolean array with one bit per element.
+ *
+ * Element `i` (row-major) is bit `i % 64` of word `i / 64`. Bits past
+ * size() in the last word are always zero, so word-wise reductions need
+ * no special tail handling.
+ *
+ * @code
+ * bitmask m = greater_bits(prices, 100.0) & less_bits(volume, 5000.0);
+ * size_t hits = m.count();
+ * ndarray<bool> bytes = m.to_ndarray();
+ * @endcode
+ */
+class bitmask {
+public:
+    /** @brief Construct an empty mask. */
+    bitmask() : size_(0) {}
+
+    /**
+     * @brief Construct a mask of `shape` with every element set to `value`.
+     */
+    explicit bitmask(const Shape& shape, bool value = false)
+        : shape_(shape), size_(compute_size(shape)),
+          words_(word_count(size_), value ? ~uint64_t(0) : uint64_t(0)) {
+        clear_tail();
+    }
+
+    /**
+     * @brief Pack an ndarray<bool>.
+     */
+    explicit bitmask(const ndarray<bool>& arr) : bitmask(arr.shape()) {
+        const bool* src = arr.data();
+        const size_t n = size_;
+        for_each_word([&](size_t w) {
+            size_t lo = w * 64;
+            size_t count = std::min<size_t>(64, n - lo);
+            uint64_t bits = 0;
+            for (size_t j = 0; j < count; ++j) bits |= uint64_t(src[lo + j]) << j;
+            words_[w] = bits;
+        });
+    }
+
+    /**
+     * @brief Unpack into an ndarray<bool> of the same shape.
+     */
+    ndarray<bool> to_ndarray() const {
+        ndarray<bool> result(shape_);
+        bool* dst = result.data();
+        const size_t n = size_;
+        for_each_word([&](size_t w) {
+            size_t lo = w * 64;
+            size_t count = std::min<size_t>(64, n - lo);
+            uint64_t bits = words_[w];
+            for (size_t j = 0; j < count; ++j) dst[lo + j] = (bits >> j) & 1u;
+        });
+        return result;
+    }
+
+    /** @return Shape of the mask. */
+    const Shape& shape() const { return shape_; }
+
+    /** @return Number of dimensions. */
+    size_t ndim() const { return shape_.size(); }
+
+    /** @return Number of elements. */
+    size_t size() const { return size_; }
+
+    /** @return Number of 64-bit storage words. */
+    size_t num_words() const { return words_.size(); }
+
+    /** @return Pointer to the storage words. */
+    uint64_t* words() { return words_.data(); }
+    const uint64_t* words() const { return words_.data(); }
+
+    /** @return Bytes used by the packed storage. */
+    size_t nbytes() const { return words_.size() * sizeof(uint64_t); }
+
+    /** @return Value of flat element `i`. */
+    bool get(size_t i) const { return (words_[i >> 6] >> (i & 63)) & 1u; }
+
+    /** @return Value of flat element `i`. */
+    bool operator[](size_t i) const { return get(i); }
+
+    /** @brief Set flat element `i` to `value`. */
+    void set(size_t i, bool value) {
+        uint64_t bit = uint64_t(1) << (i & 63);
+        words_[i >> 6] = value ? (words_[i >> 6] | bit) : (words_[i >> 6] & ~bit);
+    }
+
+    /** @return Number of true elements. */
+    size_t count() const {
+        const index_t nw = static_cast<index_t>(words_.size());
+        const bool parallel = words_.size() >= BITMASK_PARALLEL_WORDS;
+        (void)parallel;
+        size_t total = 0;
+#ifdef _OPENMP
+        #pragma omp parallel for if(parallel) reduction(+:total) schedule(static)
+#endif
+        for (index_t w = 0; w < nw; ++w) total += popcount64(words_[w]);
+        return total;
+    }
+
+    /** @return true if every element is true (true for an empty mask). */
+    bool all() const {
+        if (size_ == 0) return true;
+        const size_t full = size_ / 64;
+        for (size_t w = 0; w < full; ++w)
+            if (words_[w] != ~uint64_t(0)) return false;
+        return size_ % 64 == 0 || words_[full] == tail_bits();
+    }
+
+    /** @return true if any element is true. */
+    bool any() const {
+        for (uint64_t w : words_)
+            if (w != 0) return true;
+        return false;
+    }
+
+    /**
+     * @brief Apply `op(word_a, word_b)` to two masks of equal shape.
+     *
+     * @throws std::runtime_error If the shapes differ.
+     */
+    template<typename Op>
+    static bitmask combine(const bitmask& a, const bitmask& b, Op op) {
+        if (a.shape_ != b.shape_)
+            throw std::runtime_error("bitmask shape mismatch: " + shape_to_string(a.shape_) +
+                                     " vs " + shape_to_string(b.shape_));
+        bitmask result(a.shape_);
+        result.for_each_word([&](size_t w) { result.words_[w] = op(a.words_[w], b.words_[w]); });
+        return result;
+    }
+
+    /** @return Element-wise complement. */
+    bitmask operator~() const {
+        bitmask result(shape_);
+        result.for_each_word([&](size_t w) { result.words_[w] = ~words_[w]; });
+        result.clear_tail();
+        return result;
+    }
+
+    bitmask& operator&=(const bitmask& o) { return *this = combine(*this, o, std::bit_and<uint64_t>()); }
+    bitmask& operator|=(const bitmask& o) { return *this = combine(*this, o, std::bit_or<uint64_t>()); }
+    bitmask& operator^=(const bitmask& o) { return *this = combine(*this, o, std::bit_xor<uint64_t>()); }
+
+    friend bitmask operator&(const bitmask& a, const bitmask& b) { return combine(a, b, std::bit_and<uint64_t>()); }
+    friend bitmask operator|(const bitmask& a, const bitmask& b) { return combine(a, b, std::bit_or<uint64_t>()); }
+    friend bitmask operator^(const bitmask& a, const bitmask& b) { return combine(a, b, std::bit_xor<uint64_t>()); }
+
+    friend bool operator==(const bitmask& a, const bitmask& b) {
+        return a.shape_ == b.shape_ && a.words_ == b.words_;
+    }
+    friend bool operator!=(const bitmask& a, const bitmask& b) { return !(a == b); }
+
+    /**
+     * @brief Run `fn(w)` for every word index, in parallel for large masks.
+     */
+    template<typename Fn>
+    void for_each_word(Fn fn) const {
+        const index_t nw = static_cast<index_t>(words_.size());
+        const bool parallel = words_.size() >= BITMASK_PARALLEL_WORDS;
+        (void)parallel;
+#ifdef _OPENMP
+        #pragma omp parallel for if(parallel) schedule(static)
+#endif
+        for (index_t w = 0; w < nw; ++w) fn(static_cast<size_t>(w));
+    }
+
+private:
+    static size_t word_count(size_t n) { return (n + 63) / 64; }
+
+    /** @return Mask of the valid bits in the last word. */
+    uint64_t tail_bits() const {
+        size_t rem = size_ % 64;
+        return rem == 0 ? ~uint64_t(0) : (uint64_t(1) << rem) - 1;
+    }
+
+    void clear_tail() {
+        if (!words_.empty()) words_.back() &= tail_bits();
+    }
+
+    Shape shape_;
+    size_t size_;
+    std::vector<uint64_t> words_;
+};
+
+/**
+ * @brief Pack the element-wise comparison `cmp(a[i], b[i])` into a bitmask.
+ *
+ * Same-shape inputs are read directly, 64 elements per output word;
+ * other shapes are broadcast first.
+ *
+ * @throws std::runtime_error If the shapes cannot be broadcast.
+ */
+template<typename T, typename Cmp>
+bitmask compare_bits(const ndarray<T>& a, const ndarray<T>& b, Cmp cmp) {
+    if (a.shape() != b.shape()) {
+        Shape shape = broadcast_shapes(a.shape(), b.shape());
+        return compare_bits(broadcast_to(a, shape), broadcast_to(b, shape), cmp);
+    }
+    bitmask result(a.shape());
+    const T* pa = a.data();
+    const T* pb = b.data();
+    uint64_t* out = result.words();
+    const size_t n = a.size();
+    result.for_each_word([&](size_t w) {
+        size_t lo = w * 64;
+        size_t count = std::min<size_t>(64, n - lo);
+        uint64_t bits = 0;
+        for (size_t j = 0; j < count; ++j) bits |= uint64_t(cmp(pa[lo + j], pb[lo + j])) << j;
+        out[w] = bits;
+    });
+    return result;
+}
+
+/**
+ * @brief Pack the element-wise comparison `cmp(a[i], scalar)` into a bitmask.
+ */
+template<typename T, typename Cmp>
+bitmask compare_bits(const ndarray<T>& a, T scalar, Cmp cmp) {
+    bitmask result(a.shape());
+    const T* pa = a.data();
+    uint64_t* out = result.words();
+    const size_t n = a.size();
+    result.for_each_word([&](size_t w) {
+        size_t lo = w * 64;
+        size_t count = std::min<size_t>(64, n - lo);
+        uint64_t bits = 0;
+        for (size_t j = 0; j < count; ++j) bits |= uint64_t(cmp(pa[lo + j], scalar)) << j;
+        out[w] = bits;
+    });
+    return result;
+}
+
+// Packed counterparts of equal, not_equal, less, greater, less_equal, greater_equal,
+// for array-array (with broadcasting) and array-scalar operands
+
+template<typename T>
+bitmask equal_bits(const ndarray<T>& a, const ndarray<T>& b) { return compare_bits(a, b, std::equal_to<T>()); }
+template<typename T>
+bitmask equal_bits(const ndarray<T>& a, T s) { return compare_bits(a, s, std::equal_to<T>()); }
+
+template<typename T>
+bitmask not_equal_bits(const ndarray<T>& a, const ndarray<T>& b) { return compare_bits(a, b, std::not_equal_to<T>()); }
+template<typename T>
+bitmask not_equal_bits(const ndarray<T>& a, T s) { return compare_bits(a, s, std::not_equal_to<T>()); }
+
+template<typename T>
+bitmask less_bits(const ndarray<T>& a, const ndarray<T>& b) { return compare_bits(a, b, std::less<T>()); }
+template<typename T>
+bitmask less_bits(const ndarray<T>& a, T s) { return compare_bits(a, s, std::less<T>()); }
+
+template<typename T>
+bitmask greater_bits(const ndarray<T>& a, const ndarray<T>& b) { return compare_bits(a, b, std::greater<T>()); }
+template<typename T>
+bitmask greater_bits(const ndarray<T>& a, T s) { return compare_bits(a, s, std::greater<T>()); }
+
+template<typename T>
+bitmask less_equal_bits(const ndarray<T>& a, const ndarray<T>& b) { return compare_bits(a, b, std::less_equal<T>()); }
+template<typename T>
+bitmask less_equal_bits(const ndarray<T>& a, T s) { return compare_bits(a, s, std::less_equal<T>()); }
+
+template<typename T>
+bitmask greater_equal_bits(const ndarray<T>& a, const ndarray<T>& b) { return compare_bits(a, b, std::greater_equal<T>()); }
+template<typename T>
+bitmask greater_equal_bits(const ndarray<T>& a, T s) { return compare_bits(a, s, std::greater_equal<T>()); }
+
+/** @brief Word-wise logical AND of two masks of equal shape. */
+inline bitmask logical_and(const bitmask& a, const bitmask& b) { return a & b; }
+
+/** @brief Word-wise logical OR of two masks of equal shape. */
+inline bitmask logical_or(const bitmask& a, const bitmask& b) { return a | b; }
+
+/** @brief Word-wise logical XOR of two masks of equal shape. */
+inline bitmask logical_xor(const bitmask& a, const bitmask& b) { return a ^ b; }
+
+/** @brief Word-wise logical NOT. */
+inline bitmask logical_not(const bitmask& a) { return ~a; }
+
+/** @return true if every element of the mask is true. */
+inline bool all(const bitmask& m) { return m.all(); }
+
+/** @return true if any element of the mask is true. */
+inline bool any(const bitmask& m) { return m.any(); }
+
+/** @return Number of true elements. */
+inline size_t count_nonzero(const bitmask& m) { return m.count(); }
+
+/**
+ * @brief Elementwise selection under a packed condition.
+ *
+ * `result[i] = condition[i] ? x[i] : y[i]`. `x` and `y` are broadcast to
+ * the condition's shape; all-true and all-false words copy a whole run of
+ * 64 elements from one source.
+ *
+ * @throws std::runtime_error If x or y cannot be broadcast to the condition's shape.
+ */
+template<typename T>
+ndarray<T> where(const bitmask& condition, const ndarray<T>& x, const ndarray<T>& y) {
+    const Shape& shape = condition.shape();
+    if (x.shape() != shape) return where(condition, broadcast_to(x, shape), y);
+    if (y.shape() != shape) return where(condition, x, broadcast_to(y, shape));
+
+    ndarray<T> result(shape);
+    const T* px = x.data();
+    const T* py = y.data();
+    T* out = result.data();
+    const uint64_t* words = condition.words();
+    const size_t n = condition.size();
+    condition.for_each_word([&](size_t w) {
+        size_t lo = w * 64;
+        size_t count = std::min<size_t>(64, n - lo);
+        uint64_t bits = words[w];
+        if (bits == 0) {
+            std::copy_n(py + lo, count, out + lo);
+        } else if (count == 64 && bits == ~uint64_t(0)) {
+            std::copy_n(px + lo, count, out + lo);
+        } else {
+            for (size_t j = 0; j < count; ++j) out[lo + j] = ((bits >> j) & 1u) ? px[lo + j] : py[lo + j];
+        }
+    });
+    return result;
+}
+
+} // namespace numbits
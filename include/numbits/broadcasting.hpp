@@ -126,10 +126,42 @@ private:
     Strides ndarray_strides_;       ///< Original ndarray strides.
     Shape expanded_shape_;          ///< ndarray shape aligned to target shape.
     Strides expanded_strides_;      ///< Strides for the expanded shape.
-    std::vector<size_t> current_index_; ///< Multi-index cursor.
+    Indices current_index_;         ///< Multi-index cursor.
     size_t flat_index_;             ///< Current flat index.
 };
 
+/**
+ * @brief Strides that read an array of `shape` as if broadcast to `target`.
+ *
+ * The result has one entry per target dimension: the array's own stride
+ * where the dimension is present with full extent, and 0 where it is
+ * missing or of extent 1. No data is copied, so a broadcast operand can
+ * be traversed in place.
+ *
+ * @code
+ * Strides st = broadcast_strides({1, 3}, {4, 3}); // returns {0, 1}
+ * @endcode
+ *
+ * @throws std::runtime_error If `shape` cannot be broadcast to `target`.
+ */
+inline Strides broadcast_strides(const Shape& shape, const Shape& target) {
+    if (shape.size() > target.size())
+        throw std::runtime_error("Cannot broadcast shape " + shape_to_string(shape) +
+                                 " to " + shape_to_string(target));
+    Strides own = compute_strides(shape);
+    Strides result(target.size(), 0);
+    size_t offset = target.size() - shape.size();
+    for (size_t i = 0; i < shape.size(); ++i) {
+        if (shape[i] == target[offset + i]) {
+            result[offset + i] = shape[i] == 1 ? 0 : own[i];
+        } else if (shape[i] != 1) {
+            throw std::runtime_error("Cannot broadcast shape " + shape_to_string(shape) +
+                                     " to " + shape_to_string(target));
+        }
+    }
+    return result;
+}
+
 /**
  * @brief Broadcast an ndarray to the desired target shape.
  *
@@ -0,0 +1,288 @@
+/**
+ * @file cast.hpp
+ * @brief Element type conversion kernels.
+ *
+ * Provides:
+ *   - CastOptions: saturation of integer narrowing and float-to-integer rounding
+ *   - convert_n(): typed conversion of a contiguous buffer
+ *   - convert_scaled_n(): fused `dst = src * scale + offset` conversion
+ *   - cast(): conversion between any two runtime DType values
+ *
+ * Every conversion runs as a branch-free loop over contiguous memory that
+ * the compiler vectorizes; the mode is resolved once per call, outside
+ * the loop. Large buffers are split across threads.
+ *
+ * Float-to-integer conversions always clamp to the target range and map
+ * NaN to 0, because the C++ conversion of out-of-range values is
+ * undefined; `round` selects round-half-to-even instead of truncation.
+ * Integer-to-integer conversions wrap (modulo 2^N) unless `saturate` is
+ * set. Conversions to bool test for non-zero.
+ *
+ * float16 and bfloat16 are converted through float in small blocks, using
+ * the bulk conversions from half.hpp (F16C / AVX-512 BF16 when enabled).
+ *
+ * ndarray::astype() is built on these kernels.
+ *
+ * @namespace numbits
+ */
+
+#pragma once
+
+#include "types.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace numbits {
+
+/**
+ * @brief Minimum number of destination bytes before a conversion runs in parallel.
+ */
+constexpr size_t CAST_PARALLEL_BYTES = size_t(1) << 18;
+
+/**
+ * @brief Elements staged through a float buffer per step when converting 16-bit floats.
+ */
+constexpr size_t CAST_BLOCK = 512;
+
+/**
+ * @struct CastOptions
+ * @brief How values that do not fit the target type are converted.
+ */
+struct CastOptions {
+    bool saturate = false; ///< Clamp integer narrowing and floating-point narrowing overflow to the target range
+    bool round = false;    ///< Round floating-point values to nearest (ties to even) before integer conversion
+};
+
+/**
+ * @brief Largest and smallest values of floating-point type F that convert to integer I without overflow.
+ */
+template<typename I, typename F>
+inline void float_int_bounds(F& lo, F& hi) {
+    lo = static_cast<F>(std::numeric_limits<I>::min());  // 0 or -2^k, always exact
+    if constexpr (std::numeric_limits<F>::digits >= std::numeric_limits<I>::digits) {
+        hi = static_cast<F>(std::numeric_limits<I>::max());
+    } else {
+        // max() rounds up to 2^digits in F; step back to the float below it
+        hi = std::nextafter(std::ldexp(F(1), std::numeric_limits<I>::digits), F(0));
+    }
+}
+
+/**
+ * @brief Integer conversion that clamps to the range of U.
+ */
+template<typename U, typename T>
+inline U saturate_int(T x) {
+    if constexpr (std::is_signed_v<T> && !std::is_signed_v<U>) {
+        if (x < 0) return U(0);
+        using UT = std::make_unsigned_t<T>;
+        return static_cast<UT>(x) > std::numeric_limits<U>::max() ? std::numeric_limits<U>::max()
+                                                                  : static_cast<U>(x);
+    } else if constexpr (!std::is_signed_v<T> && std::is_signed_v<U>) {
+        using UU = std::make_unsigned_t<U>;
+        return x > static_cast<UU>(std::numeric_limits<U>::max()) ? std::numeric_limits<U>::max()
+                                                                 : static_cast<U>(x);
+    } else if constexpr (sizeof(T) > sizeof(U)) {
+        const T lo = static_cast<T>(std::numeric_limits<U>::min());
+        const T hi = static_cast<T>(std::numeric_limits<U>::max());
+        return static_cast<U>(x < lo ? lo : (x > hi ? hi : x));
+    } else {
+        return static_cast<U>(x);
+    }
+}
+
+/**
+ * @brief Clamp finite floats beyond the range of the 16-bit float type U to its largest finite value.
+ */
+template<typename U>
+inline float clamp_to_half_range(float x) {
+    const float m = static_cast<float>(std::numeric_limits<U>::max());
+    if (x > m && x <= std::numeric_limits<float>::max()) return m;
+    if (x < -m && x >= std::numeric_limits<float>::lowest()) return -m;
+    return x;
+}
+
+/**
+ * @brief Convert one value from T to U under the given mode.
+ *
+ * `lo`/`hi` are the float_int_bounds() of U when converting floating-point
+ * to integer values and unused otherwise.
+ */
+template<typename U, typename T, bool Saturate, bool Round>
+inline U convert_value(T x, T lo, T hi) {
+    (void)lo;
+    (void)hi;
+    if constexpr (std::is_same_v<U, T>) {
+        return x;
+    } else if constexpr (std::is_same_v<U, bool>) {
+        return x != T(0);
+    } else if constexpr (std::is_same_v<T, bool>) {
+        return x ? U(1) : U(0);
+    } else if constexpr (is_half_v<U>) {
+        const float f = convert_value<float, T, Saturate, Round>(x, lo, hi);
+        return U(Saturate ? clamp_to_half_range<U>(f) : f);
+    } else if constexpr (std::is_floating_point_v<U>) {
+        if constexpr (Saturate && std::is_floating_point_v<T> && sizeof(T) > sizeof(U)) {
+            // Finite values beyond the range of U clamp instead of becoming inf
+            const T m = static_cast<T>(std::numeric_limits<U>::max());
+            if (x > m && x <= std::numeric_limits<T>::max()) x = m;
+            if (x < -m && x >= std::numeric_limits<T>::lowest()) x = -m;
+        }
+        return static_cast<U>(x);
+    } else if constexpr (std::is_floating_point_v<T>) {
+        T r = Round ? std::nearbyint(x) : x;
+        r = r < lo ? lo : r;
+        r = r > hi ? hi : r;
+        r = r == r ? r : T(0);
+        return static_cast<U>(r);
+    } else {
+        return Saturate ? saturate_int<U>(x) : static_cast<U>(x);
+    }
+}
+
+/**
+ * @brief `dst[i] = f(src[i])` for `n` contiguous elements, in parallel when large.
+ */
+template<typename U, typename T, typename F>
+void transform_n(const T* src, U* dst, size_t n, F f) {
+    const index_t count = static_cast<index_t>(n);
+    const bool parallel = n * sizeof(U) >= CAST_PARALLEL_BYTES;
+    (void)parallel;
+#ifdef _OPENMP
+    #pragma omp parallel for if(parallel) schedule(static)
+#endif
+    for (index_t i = 0; i < count; ++i) dst[i] = f(src[i]);
+}
+
+/**
+ * @brief Call `fn(saturate, round)` with both options as std::bool_constant.
+ */
+template<typename Fn>
+void with_cast_mode(const CastOptions& options, Fn fn) {
+    if (options.saturate) {
+        if (options.round) fn(std::true_type(), std::true_type());
+        else fn(std::true_type(), std::false_type());
+    } else {
+        if (options.round) fn(std::false_type(), std::true_type());
+        else fn(std::false_type(), std::false_type());
+    }
+}
+
+/**
+ * @brief Convert `n` elements where T or U is a 16-bit float, staging blocks through float.
+ */
+template<typename U, typename T>
+void convert_half_n(const T* src, U* dst, size_t n, const CastOptions& options) {
+    float lo = 0.0f, hi = 0.0f;
+    if constexpr (std::is_integral_v<U> && !std::is_same_v<U, bool>) float_int_bounds<U>(lo, hi);
+    const index_t blocks = static_cast<index_t>((n + CAST_BLOCK - 1) / CAST_BLOCK);
+    const bool parallel = n * sizeof(U) >= CAST_PARALLEL_BYTES;
+    (void)parallel;
+    with_cast_mode(options, [&](auto saturate, auto round) {
+        constexpr bool S = decltype(saturate)::value, R = decltype(round)::value;
+#ifdef _OPENMP
+        #pragma omp parallel for if(parallel) schedule(static)
+#endif
+        for (index_t b = 0; b < blocks; ++b) {
+            const size_t begin = static_cast<size_t>(b) * CAST_BLOCK;
+            const size_t len = std::min(CAST_BLOCK, n - begin);
+            float buf[CAST_BLOCK];
+            if constexpr (is_half_v<T>) {
+                half_to_float_n(src + begin, buf, len);
+            } else {
+                for (size_t i = 0; i < len; ++i) buf[i] = convert_value<float, T, S, R>(src[begin + i], T(0), T(0));
+            }
+            if constexpr (is_half_v<U>) {
+                if constexpr (S) {
+                    for (size_t i = 0; i < len; ++i) buf[i] = clamp_to_half_range<U>(buf[i]);
+                }
+                float_to_half_n(buf, dst + begin, len);
+            } else {
+                for (size_t i = 0; i < len; ++i) dst[begin + i] = convert_value<U, float, S, R>(buf[i], lo, hi);
+            }
+        }
+    });
+}
+
+/**
+ * @brief Convert `n` contiguous elements from T to U.
+ */
+template<typename U, typename T>
+void convert_n(const T* src, U* dst, size_t n, CastOptions options = CastOptions()) {
+    if constexpr (is_half_v<T> || is_half_v<U>) {
+        if constexpr (std::is_same_v<U, T>) std::copy(src, src + n, dst);
+        else convert_half_n(src, dst, n, options);
+    } else {
+        T lo = T(0), hi = T(0);
+        if constexpr (std::is_floating_point_v<T> && std::is_integral_v<U> && !std::is_same_v<U, bool>)
+            float_int_bounds<U>(lo, hi);
+        with_cast_mode(options, [&](auto saturate, auto round) {
+            transform_n(src, dst, n, [lo, hi](T x) {
+                return convert_value<U, T, decltype(saturate)::value, decltype(round)::value>(x, lo, hi);
+            });
+        });
+    }
+}
+
+/**
+ * @brief Arithmetic type used for `x * scale + offset` when converting T to U.
+ *
+ * The floating-point target type if there is one, otherwise float unless
+ * either side needs double precision (double, or integers wider than 16 bits).
+ */
+template<typename U, typename T>
+using scale_compute_t = std::conditional_t<
+    std::is_floating_point_v<U>, U,
+    std::conditional_t<std::is_same_v<T, double> || (std::is_integral_v<T> && sizeof(T) > 2) ||
+                       (std::is_integral_v<U> && sizeof(U) > 2), double, float>>;
+
+/**
+ * @brief Convert `n` elements as `dst[i] = U(src[i] * scale + offset)` in one pass.
+ *
+ * Typical use is image normalization, e.g. uint8 to float with
+ * `scale = 1 / 255.0`, or quantizing back with saturation and rounding.
+ */
+template<typename U, typename T>
+void convert_scaled_n(const T* src, U* dst, size_t n, double scale, double offset,
+                      CastOptions options = CastOptions()) {
+    using C = scale_compute_t<U, T>;
+    const C s = static_cast<C>(scale), b = static_cast<C>(offset);
+    C lo = C(0), hi = C(0);
+    if constexpr (std::is_integral_v<U> && !std::is_same_v<U, bool>) float_int_bounds<U>(lo, hi);
+    with_cast_mode(options, [&](auto saturate, auto round) {
+        transform_n(src, dst, n, [s, b, lo, hi](T x) {
+            const C y = static_cast<C>(x) * s + b;
+            return convert_value<U, C, decltype(saturate)::value, decltype(round)::value>(y, lo, hi);
+        });
+    });
+}
+
+/**
+ * @brief Convert `n` elements between runtime element types.
+ *
+ * @code
+ * std::vector<float> out(n);
+ * cast(raw, DType::UINT16, out.data(), DType::FLOAT32, n);
+ * @endcode
+ *
+ * @throws std::runtime_error If either DType is not supported
+ */
+inline void cast(const void* src, DType from, void* dst, DType to, size_t n,
+                 CastOptions options = CastOptions()) {
+    visit_dtype(from, [&](auto src_tag) {
+        using T = typename decltype(src_tag)::type;
+        visit_dtype(to, [&](auto dst_tag) {
+            using U = typename decltype(dst_tag)::type;
+            convert_n(static_cast<const T*>(src), static_cast<U*>(dst), n, options);
+        });
+    });
+}
+
+} // namespace numbits
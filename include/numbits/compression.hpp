@@ -0,0 +1,434 @@
+/**
+ * @file compression.hpp
+ * @brief Lightweight, dependency-free codecs for compressed `.cb` storage.
+ *
+ * Provides the building blocks used by dump()/load() when compression is
+ * requested:
+ *   - byte_shuffle / byte_unshuffle: transpose element bytes so that the
+ *     (often constant) high bytes of numeric data become long runs
+ *   - rle_compress / rle_decompress: PackBits-style run-length codec, best
+ *     for sparse or near-constant integer data
+ *   - lz_compress / lz_decompress: LZ4-style byte-oriented LZ77 codec
+ *   - compress_chunks / decompress_chunks: split a buffer into independent
+ *     chunks and (de)compress them in parallel with OpenMP when available
+ *
+ * @namespace numbits
+ */
+
+#pragma once
+
+#include "types.hpp"
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace numbits {
+
+/**
+ * @brief Compression codec applied to each chunk of a `.cb` payload.
+ */
+enum class Codec : uint32_t {
+    NONE = 0,  ///< Store chunks uncompressed (shuffle may still apply)
+    RLE  = 1,  ///< PackBits-style run-length encoding
+    LZ   = 2   ///< LZ4-style LZ77 with a 64 KiB window
+};
+
+/**
+ * @brief Options controlling compressed dump().
+ */
+struct CompressionOptions {
+    Codec codec = Codec::LZ;          ///< Codec applied to every chunk
+    bool shuffle = true;              ///< Byte-shuffle elements before encoding
+    size_t chunk_bytes = size_t(1) << 20; ///< Uncompressed bytes per chunk
+};
+
+/**
+ * @brief Transpose the bytes of `n` elements of `elem_size` bytes each.
+ *
+ * Byte `b` of element `i` is written to `dst[b * n + i]`.
+ *
+ * @param src Source buffer of `n * elem_size` bytes.
+ * @param dst Destination buffer of the same size (must not alias src).
+ * @param n Number of elements.
+ * @param elem_size Bytes per element.
+ */
+inline void byte_shuffle(const uint8_t* src, uint8_t* dst, size_t n, size_t elem_size) {
+    for (size_t i = 0; i < n; ++i) {
+        const uint8_t* elem = src + i * elem_size;
+        for (size_t b = 0; b < elem_size; ++b) {
+            dst[b * n + i] = elem[b];
+        }
+    }
+}
+
+/**
+ * @brief Inverse of byte_shuffle().
+ */
+inline void byte_unshuffle(const uint8_t* src, uint8_t* dst, size_t n, size_t elem_size) {
+    for (size_t b = 0; b < elem_size; ++b) {
+        const uint8_t* plane = src + b * n;
+        for (size_t i = 0; i < n; ++i) {
+            dst[i * elem_size + b] = plane[i];
+        }
+    }
+}
+
+/**
+ * @brief Run-length encode a byte buffer.
+ *
+ * Output is a sequence of packets. A control byte `c < 128` is followed by
+ * `c + 1` literal bytes; a control byte `c >= 128` is followed by one byte
+ * that is repeated `c - 125` times (3 to 130).
+ *
+ * @param src Input bytes.
+ * @param n Input length.
+ * @return Encoded bytes.
+ */
+inline std::vector<uint8_t> rle_compress(const uint8_t* src, size_t n) {
+    std::vector<uint8_t> out;
+    out.reserve(n / 2 + 16);
+
+    size_t i = 0;
+    size_t lit_start = 0;
+    auto flush_literals = [&](size_t end) {
+        while (lit_start < end) {
+            size_t count = std::min<size_t>(end - lit_start, 128);
+            out.push_back(static_cast<uint8_t>(count - 1));
+            out.insert(out.end(), src + lit_start, src + lit_start + count);
+            lit_start += count;
+        }
+    };
+
+    while (i < n) {
+        size_t run = 1;
+        while (i + run < n && run < 130 && src[i + run] == src[i]) ++run;
+        if (run >= 3) {
+            flush_literals(i);
+            out.push_back(static_cast<uint8_t>(run + 125));
+            out.push_back(src[i]);
+            i += run;
+            lit_start = i;
+        } else {
+            i += run;
+        }
+    }
+    flush_literals(n);
+    return out;
+}
+
+/**
+ * @brief Decode a buffer produced by rle_compress().
+ *
+ * @param src Encoded bytes.
+ * @param src_size Encoded length.
+ * @param dst Output buffer.
+ * @param dst_size Exact expected decoded length.
+ * @throws std::runtime_error if the input is corrupt or does not decode to dst_size bytes.
+ */
+inline void rle_decompress(const uint8_t* src, size_t src_size, uint8_t* dst, size_t dst_size) {
+    size_t ip = 0, op = 0;
+    while (ip < src_size) {
+        uint8_t c = src[ip++];
+        if (c < 128) {
+            size_t count = size_t(c) + 1;
+            if (ip + count > src_size || op + count > dst_size)
+                throw std::runtime_error("rle_decompress: corrupt input");
+            std::memcpy(dst + op, src + ip, count);
+            ip += count;
+            op += count;
+        } else {
+            size_t count = size_t(c) - 125;
+            if (ip >= src_size || op + count > dst_size)
+                throw std::runtime_error("rle_decompress: corrupt input");
+            std::memset(dst + op, src[ip++], count);
+            op += count;
+        }
+    }
+    if (op != dst_size) throw std::runtime_error("rle_decompress: size mismatch");
+}
+
+/**
+ * @brief Compress a byte buffer with an LZ4-style LZ77 codec.
+ *
+ * Each sequence is a token byte (high nibble: literal count, low nibble:
+ * match length - 4, value 15 meaning "continued in following 255-run bytes"),
+ * the literals, a 16-bit little-endian back-reference offset and the match
+ * length extension. The final sequence carries literals only.
+ *
+ * @param src Input bytes.
+ * @param n Input length.
+ * @return Encoded bytes.
+ */
+inline std::vector<uint8_t> lz_compress(const uint8_t* src, size_t n) {
+    constexpr size_t MIN_MATCH = 4;
+    constexpr size_t MAX_OFFSET = 65535;
+    constexpr unsigned HASH_BITS = 14;
+
+    std::vector<uint8_t> out;
+    out.reserve(n / 2 + 16);
+
+    auto put_length = [&out](size_t len) {
+        while (len >= 255) {
+            out.push_back(255);
+            len -= 255;
+        }
+        out.push_back(static_cast<uint8_t>(len));
+    };
+    auto emit = [&](size_t lit_begin, size_t lit_len, size_t offset, size_t match_len) {
+        size_t ml = match_len ? match_len - MIN_MATCH : 0;
+        uint8_t token = static_cast<uint8_t>((std::min<size_t>(lit_len, 15) << 4) |
+                                             std::min<size_t>(ml, 15));
+        out.push_back(token);
+        if (lit_len >= 15) put_length(lit_len - 15);
+        out.insert(out.end(), src + lit_begin, src + lit_begin + lit_len);
+        if (match_len) {
+            out.push_back(static_cast<uint8_t>(offset & 0xFF));
+            out.push_back(static_cast<uint8_t>(offset >> 8));
+            if (ml >= 15) put_length(ml - 15);
+        }
+    };
+    auto read32 = [src](size_t pos) {
+        uint32_t v;
+        std::memcpy(&v, src + pos, sizeof(v));
+        return v;
+    };
+
+    std::vector<size_t> table(size_t(1) << HASH_BITS, SIZE_MAX);
+    size_t anchor = 0;
+    size_t i = 0;
+    while (i + MIN_MATCH <= n) {
+        uint32_t seq = read32(i);
+        size_t h = (seq * 2654435761u) >> (32 - HASH_BITS);
+        size_t cand = table[h];
+        table[h] = i;
+
+        if (cand != SIZE_MAX && i - cand <= MAX_OFFSET && read32(cand) == seq) {
+            size_t len = MIN_MATCH;
+            while (i + len < n && src[cand + len] == src[i + len]) ++len;
+            emit(anchor, i - anchor, i - cand, len);
+            i += len;
+            anchor = i;
+        } else {
+            ++i;
+        }
+    }
+    emit(anchor, n - anchor, 0, 0);
+    return out;
+}
+
+/**
+ * @brief Decode a buffer produced by lz_compress().
+ *
+ * @param src Encoded bytes.
+ * @param src_size Encoded length.
+ * @param dst Output buffer.
+ * @param dst_size Exact expected decoded length.
+ * @throws std::runtime_error if the input is corrupt or does not decode to dst_size bytes.
+ */
+inline void lz_decompress(const uint8_t* src, size_t src_size, uint8_t* dst, size_t dst_size) {
+    size_t ip = 0, op = 0;
+    auto get_length = [&](size_t len) {
+        if (len != 15) return len;
+        uint8_t b;
+        do {
+            if (ip >= src_size) throw std::runtime_error("lz_decompress: corrupt input");
+            b = src[ip++];
+            len += b;
+        } while (b == 255);
+        return len;
+    };
+
+    while (ip < src_size) {
+        uint8_t token = src[ip++];
+
+        size_t lit_len = get_length(token >> 4);
+        if (ip + lit_len > src_size || op + lit_len > dst_size)
+            throw std::runtime_error("lz_decompress: corrupt input");
+        std::memcpy(dst + op, src + ip, lit_len);
+        ip += lit_len;
+        op += lit_len;
+        if (ip == src_size) break;
+
+        if (ip + 2 > src_size) throw std::runtime_error("lz_decompress: corrupt input");
+        size_t offset = size_t(src[ip]) | (size_t(src[ip + 1]) << 8);
+        ip += 2;
+        size_t match_len = get_length(token & 0x0F) + 4;
+        if (offset == 0 || offset > op || op + match_len > dst_size)
+            throw std::runtime_error("lz_decompress: corrupt input");
+
+        // Byte-wise copy: source and destination may overlap for short offsets
+        const uint8_t* match = dst + op - offset;
+        for (size_t k = 0; k < match_len; ++k) dst[op + k] = match[k];
+        op += match_len;
+    }
+    if (op != dst_size) throw std::runtime_error("lz_decompress: size mismatch");
+}
+
+/**
+ * @brief Result of compress_chunks(): per-chunk sizes plus concatenated payload.
+ *
+ * A chunk whose stored size equals its uncompressed size was kept raw
+ * because the codec did not shrink it.
+ */
+struct CompressedBuffer {
+    std::vector<size_t> chunk_sizes; ///< Stored size of every chunk, in order
+    std::vector<uint8_t> payload;    ///< All chunks back to back
+};
+
+/**
+ * @brief Number of chunk bytes to use for a given element size.
+ *
+ * Rounds the requested chunk size down to a whole number of elements.
+ */
+inline size_t aligned_chunk_bytes(size_t chunk_bytes, size_t elem_size) {
+    size_t aligned = (chunk_bytes / elem_size) * elem_size;
+    return aligned ? aligned : elem_size;
+}
+
+/**
+ * @brief Encode one chunk: optional shuffle, then the codec; falls back to raw.
+ */
+inline std::vector<uint8_t> compress_chunk(const uint8_t* src, size_t bytes, size_t elem_size,
+                                           Codec codec, bool shuffle) {
+    std::vector<uint8_t> filtered;
+    const uint8_t* input = src;
+    if (shuffle && elem_size > 1) {
+        filtered.resize(bytes);
+        byte_shuffle(src, filtered.data(), bytes / elem_size, elem_size);
+        input = filtered.data();
+    }
+
+    std::vector<uint8_t> encoded;
+    switch (codec) {
+        case Codec::RLE: encoded = rle_compress(input, bytes); break;
+        case Codec::LZ:  encoded = lz_compress(input, bytes); break;
+        case Codec::NONE: break;
+    }
+    if (codec == Codec::NONE || encoded.size() >= bytes) {
+        if (!filtered.empty()) return filtered;
+        return std::vector<uint8_t>(src, src + bytes);
+    }
+    return encoded;
+}
+
+/**
+ * @brief Decode one chunk produced by compress_chunk() into `dst`.
+ */
+inline void decompress_chunk(const uint8_t* src, size_t stored, uint8_t* dst, size_t bytes,
+                             size_t elem_size, Codec codec, bool shuffle) {
+    bool shuffled = shuffle && elem_size > 1;
+    std::vector<uint8_t> filtered;
+    uint8_t* target = dst;
+    if (shuffled) {
+        filtered.resize(bytes);
+        target = filtered.data();
+    }
+
+    if (stored == bytes) {
+        std::memcpy(target, src, bytes);
+    } else if (codec == Codec::RLE) {
+        rle_decompress(src, stored, target, bytes);
+    } else if (codec == Codec::LZ) {
+        lz_decompress(src, stored, target, bytes);
+    } else {
+        throw std::runtime_error("decompress_chunk: corrupt chunk size");
+    }
+
+    if (shuffled) byte_unshuffle(filtered.data(), dst, bytes / elem_size, elem_size);
+}
+
+/**
+ * @brief Split a buffer into chunks and compress them independently.
+ *
+ * Chunks are encoded in parallel when OpenMP is enabled.
+ *
+ * @param data Source buffer.
+ * @param bytes Source length (a multiple of elem_size).
+ * @param elem_size Size of one element, used by the shuffle filter.
+ * @param options Codec, shuffle and chunk size settings.
+ * @return Per-chunk stored sizes and the concatenated payload.
+ */
+inline CompressedBuffer compress_chunks(const void* data, size_t bytes, size_t elem_size,
+                                        const CompressionOptions& options) {
+    const uint8_t* src = static_cast<const uint8_t*>(data);
+    size_t chunk = aligned_chunk_bytes(options.chunk_bytes, elem_size);
+    size_t num_chunks = (bytes + chunk - 1) / chunk;
+
+    std::vector<std::vector<uint8_t>> encoded(num_chunks);
+    index_t count = static_cast<index_t>(num_chunks);
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic)
+#endif
+    for (index_t c = 0; c < count; ++c) {
+        size_t begin = static_cast<size_t>(c) * chunk;
+        size_t len = std::min(chunk, bytes - begin);
+        encoded[c] = compress_chunk(src + begin, len, elem_size, options.codec, options.shuffle);
+    }
+
+    CompressedBuffer result;
+    result.chunk_sizes.reserve(num_chunks);
+    size_t total = 0;
+    for (const auto& e : encoded) total += e.size();
+    result.payload.reserve(total);
+    for (const auto& e : encoded) {
+        result.chunk_sizes.push_back(e.size());
+        result.payload.insert(result.payload.end(), e.begin(), e.end());
+    }
+    return result;
+}
+
+/**
+ * @brief Decompress chunks produced by compress_chunks() into `out`.
+ *
+ * Chunks are decoded in parallel when OpenMP is enabled.
+ *
+ * @param payload Concatenated stored chunks.
+ * @param chunk_sizes Stored size of every chunk.
+ * @param out Destination buffer of `bytes` bytes.
+ * @param bytes Total uncompressed size.
+ * @param elem_size Size of one element.
+ * @param chunk_bytes Uncompressed bytes per chunk used at compression time.
+ * @param codec Codec used at compression time.
+ * @param shuffle Whether the shuffle filter was applied.
+ * @throws std::runtime_error on corrupt input.
+ */
+inline void decompress_chunks(const uint8_t* payload, const std::vector<size_t>& chunk_sizes,
+                              void* out, size_t bytes, size_t elem_size, size_t chunk_bytes,
+                              Codec codec, bool shuffle) {
+    uint8_t* dst = static_cast<uint8_t*>(out);
+    size_t chunk = aligned_chunk_bytes(chunk_bytes, elem_size);
+    size_t num_chunks = (bytes + chunk - 1) / chunk;
+    if (chunk_sizes.size() != num_chunks)
+        throw std::runtime_error("decompress_chunks: chunk count mismatch");
+
+    std::vector<size_t> offsets(num_chunks + 1, 0);
+    for (size_t c = 0; c < num_chunks; ++c) offsets[c + 1] = offsets[c] + chunk_sizes[c];
+
+    bool failed = false;
+    index_t count = static_cast<index_t>(num_chunks);
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic)
+#endif
+    for (index_t c = 0; c < count; ++c) {
+        size_t begin = static_cast<size_t>(c) * chunk;
+        size_t len = std::min(chunk, bytes - begin);
+        try {
+            decompress_chunk(payload + offsets[c], chunk_sizes[c], dst + begin, len,
+                             elem_size, codec, shuffle);
+        } catch (...) {
+#ifdef _OPENMP
+            #pragma omp atomic write
+#endif
+            failed = true;
+        }
+    }
+    if (failed) throw std::runtime_error("decompress_chunks: corrupt chunk");
+}
+
+} // namespace numbits
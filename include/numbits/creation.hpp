@@ -156,13 +156,13 @@ ndarray<T> eye(size_t n, size_t m = 0, int k = 0) {
     if (m == 0) {
         m = n;
     }
-    ndarray<T> result({n, m});
-    result.fill(T{0});
+    ndarray<T> result(Shape{n, m});
+    auto R = result.template unchecked<2>();
 
     for (size_t row = 0; row < n; ++row) {
         int col = static_cast<int>(row) + k;
         if (col >= 0 && static_cast<size_t>(col) < m) {
-            result[row * m + static_cast<size_t>(col)] = T{1};
+            R(row, static_cast<size_t>(col)) = T{1};
         }
     }
     return result;
@@ -197,14 +197,15 @@ ndarray<T> diag(const ndarray<T>& arr, int k = 0) {
         size_t rows = n + (k > 0 ? k : 0);
         size_t cols = n + (k < 0 ? -k : 0);
 
-        ndarray<T> result({rows, cols});
-        result.fill(T{0});
+        ndarray<T> result(Shape{rows, cols});
+        auto R = result.template unchecked<2>();
+        auto v = arr.template unchecked<1>();
 
         for (size_t i = 0; i < n; ++i) {
             int r = static_cast<int>(i) + (k > 0 ? k : 0);
             int c = static_cast<int>(i) + (k < 0 ? -k : 0);
             if (r >= 0 && c >= 0 && static_cast<size_t>(r) < rows && static_cast<size_t>(c) < cols) {
-                result[r * cols + c] = arr[i];
+                R(static_cast<size_t>(r), static_cast<size_t>(c)) = v(i);
             }
         }
         return result;
@@ -223,9 +224,11 @@ ndarray<T> diag(const ndarray<T>& arr, int k = 0) {
             len = std::min(rows - start_row, cols - start_col);
         }
 
-        ndarray<T> result({len});
+        ndarray<T> result(Shape{len});
+        auto A = arr.template unchecked<2>();
+        auto d = result.template unchecked<1>();
         for (size_t i = 0; i < len; ++i) {
-            result[i] = arr[(start_row + i) * cols + (start_col + i)];
+            d(i) = A(start_row + i, start_col + i);
         }
         return result;
     }
@@ -261,11 +264,12 @@ ndarray<T> vander(const ndarray<T>& x, size_t N, bool increasing = false) {
     }
 
     size_t M = shape[0];
-    ndarray<T> result({M, N});
-    result.fill(T{0});
+    ndarray<T> result(Shape{M, N});
+    auto R = result.template unchecked<2>();
+    auto v = x.template unchecked<1>();
 
     for (size_t i = 0; i < M; ++i) {
-        T base = x[i];
+        T base = v(i);
 
         for (size_t j = 0; j < N; ++j) {
             size_t power = increasing ? j : (N - 1 - j);
@@ -275,7 +279,7 @@ ndarray<T> vander(const ndarray<T>& x, size_t N, bool increasing = false) {
                 val *= base;
             }
 
-            result[i * N + j] = val;
+            R(i, j) = val;
         }
     }
 
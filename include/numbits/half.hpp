@@ -0,0 +1,309 @@
+/**
+ * @file half.hpp
+ * @brief 16-bit floating-point storage types (float16, bfloat16).
+ *
+ * Provides:
+ *   - float16: IEEE 754 binary16 (1 sign, 5 exponent, 10 mantissa bits)
+ *   - bfloat16: the upper half of a binary32 (1 sign, 8 exponent, 7 mantissa bits)
+ *   - Bulk conversions to and from float (half_to_float_n, float_to_half_n, ...)
+ *   - is_half_v and accumulator_t traits
+ *
+ * Both types are storage formats: they convert implicitly to and from
+ * float, so arithmetic happens in float and results are rounded back on
+ * assignment. Conversions to 16 bits round to nearest, ties to even;
+ * NaN stays NaN and values beyond the range become infinity.
+ *
+ * Scalar and bulk float16 conversions use F16C instructions when compiled
+ * with them enabled (e.g. -mf16c or -march=native) and bit-manipulation
+ * code otherwise. Bulk bfloat16 rounding uses AVX-512 BF16 when available;
+ * widening bfloat16 to float is a shift on every target.
+ *
+ * @namespace numbits
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <type_traits>
+
+#if defined(__F16C__) || (defined(__AVX512BF16__) && defined(__AVX512F__))
+#include <immintrin.h>
+#endif
+
+namespace numbits {
+
+/**
+ * @brief Bit pattern of a float.
+ */
+inline uint32_t float_as_bits(float f) {
+    uint32_t u;
+    std::memcpy(&u, &f, sizeof(u));
+    return u;
+}
+
+/**
+ * @brief Float with the given bit pattern.
+ */
+inline float bits_as_float(uint32_t u) {
+    float f;
+    std::memcpy(&f, &u, sizeof(f));
+    return f;
+}
+
+/**
+ * @brief Round a float to binary16 bits (nearest, ties to even).
+ */
+inline uint16_t float_to_half_bits(float f) {
+#if defined(__F16C__)
+    return static_cast<uint16_t>(_cvtss_sh(f, _MM_FROUND_TO_NEAREST_INT));
+#else
+    uint32_t x = float_as_bits(f);
+    const uint32_t sign = (x >> 16) & 0x8000u;
+    x &= 0x7FFFFFFFu;
+    uint32_t h;
+    if (x >= 0x47800000u) {
+        // |f| >= 65536 (or inf/NaN): NaN becomes a quiet NaN, the rest inf
+        h = x > 0x7F800000u ? 0x7E00u : 0x7C00u;
+    } else if (x < 0x38800000u) {
+        // Below the smallest normal half: adding 0.5 aligns the mantissa so
+        // that the FPU performs the subnormal rounding
+        const uint32_t magic = 0x3F000000u;
+        h = float_as_bits(bits_as_float(x) + bits_as_float(magic)) - magic;
+    } else {
+        // Rebias the exponent and round the dropped 13 bits to even; a
+        // carry out of the mantissa correctly bumps the exponent (up to inf)
+        const uint32_t odd = (x >> 13) & 1u;
+        x += 0xC8000FFFu + odd;  // (15 - 127) << 23, plus rounding bias
+        h = x >> 13;
+    }
+    return static_cast<uint16_t>(h | sign);
+#endif
+}
+
+/**
+ * @brief Widen binary16 bits to a float (exact).
+ */
+inline float half_bits_to_float(uint16_t h) {
+#if defined(__F16C__)
+    return _cvtsh_ss(h);
+#else
+    uint32_t x = static_cast<uint32_t>(h & 0x7FFFu) << 13;
+    const uint32_t exp = x & 0x0F800000u;
+    x += 0x38000000u;  // (127 - 15) << 23
+    if (exp == 0x0F800000u) {
+        x += 0x38000000u;  // inf/NaN: exponent to 255
+    } else if (exp == 0) {
+        // Zero or subnormal: renormalize through the FPU
+        x += 0x00800000u;
+        x = float_as_bits(bits_as_float(x) - bits_as_float(0x38800000u));
+    }
+    return bits_as_float(x | (static_cast<uint32_t>(h & 0x8000u) << 16));
+#endif
+}
+
+/**
+ * @brief Round a float to bfloat16 bits (nearest, ties to even).
+ */
+inline uint16_t float_to_bfloat16_bits(float f) {
+    const uint32_t x = float_as_bits(f);
+    if ((x & 0x7FFFFFFFu) > 0x7F800000u) return static_cast<uint16_t>((x >> 16) | 0x40u);  // quiet NaN
+    return static_cast<uint16_t>((x + 0x7FFFu + ((x >> 16) & 1u)) >> 16);
+}
+
+/**
+ * @brief Widen bfloat16 bits to a float (exact).
+ */
+inline float bfloat16_bits_to_float(uint16_t b) {
+    return bits_as_float(static_cast<uint32_t>(b) << 16);
+}
+
+/**
+ * @struct float16
+ * @brief IEEE 754 half-precision value stored in 16 bits.
+ */
+struct float16 {
+    uint16_t bits = 0;
+
+    float16() = default;
+
+    /** @brief Round a float (or any arithmetic value, via float) to half precision. */
+    template<typename U, typename = std::enable_if_t<std::is_arithmetic_v<U>>>
+    float16(U value) : bits(float_to_half_bits(static_cast<float>(value))) {}
+
+    /** @brief Value with the given bit pattern. */
+    static float16 from_bits(uint16_t b) {
+        float16 h;
+        h.bits = b;
+        return h;
+    }
+
+    operator float() const { return half_bits_to_float(bits); }
+
+    float16& operator+=(float v) { return *this = float16(static_cast<float>(*this) + v); }
+    float16& operator-=(float v) { return *this = float16(static_cast<float>(*this) - v); }
+    float16& operator*=(float v) { return *this = float16(static_cast<float>(*this) * v); }
+    float16& operator/=(float v) { return *this = float16(static_cast<float>(*this) / v); }
+};
+
+/**
+ * @struct bfloat16
+ * @brief Brain floating-point value: a float with the low 16 mantissa bits dropped.
+ */
+struct bfloat16 {
+    uint16_t bits = 0;
+
+    bfloat16() = default;
+
+    /** @brief Round a float (or any arithmetic value, via float) to bfloat16. */
+    template<typename U, typename = std::enable_if_t<std::is_arithmetic_v<U>>>
+    bfloat16(U value) : bits(float_to_bfloat16_bits(static_cast<float>(value))) {}
+
+    /** @brief Value with the given bit pattern. */
+    static bfloat16 from_bits(uint16_t b) {
+        bfloat16 h;
+        h.bits = b;
+        return h;
+    }
+
+    operator float() const { return bfloat16_bits_to_float(bits); }
+
+    bfloat16& operator+=(float v) { return *this = bfloat16(static_cast<float>(*this) + v); }
+    bfloat16& operator-=(float v) { return *this = bfloat16(static_cast<float>(*this) - v); }
+    bfloat16& operator*=(float v) { return *this = bfloat16(static_cast<float>(*this) * v); }
+    bfloat16& operator/=(float v) { return *this = bfloat16(static_cast<float>(*this) / v); }
+};
+
+static_assert(sizeof(float16) == 2 && sizeof(bfloat16) == 2, "16-bit types must not be padded");
+
+/**
+ * @brief True for float16 and bfloat16.
+ */
+template<typename T>
+constexpr bool is_half_v = std::is_same_v<T, float16> || std::is_same_v<T, bfloat16>;
+
+/**
+ * @brief Type used to accumulate sums and products of T: float for 16-bit floats, T otherwise.
+ */
+template<typename T>
+using accumulator_t = std::conditional_t<is_half_v<T>, float, T>;
+
+inline std::ostream& operator<<(std::ostream& os, float16 h) { return os << static_cast<float>(h); }
+inline std::ostream& operator<<(std::ostream& os, bfloat16 h) { return os << static_cast<float>(h); }
+
+inline std::istream& operator>>(std::istream& is, float16& h) {
+    float f;
+    if (is >> f) h = float16(f);
+    return is;
+}
+
+inline std::istream& operator>>(std::istream& is, bfloat16& h) {
+    float f;
+    if (is >> f) h = bfloat16(f);
+    return is;
+}
+
+/**
+ * @brief Widen `n` float16 values to float.
+ */
+inline void half_to_float_n(const float16* src, float* dst, size_t n) {
+    size_t i = 0;
+#if defined(__F16C__)
+    for (; i + 8 <= n; i += 8) {
+        __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(h));
+    }
+#endif
+    for (; i < n; ++i) dst[i] = half_bits_to_float(src[i].bits);
+}
+
+/**
+ * @brief Round `n` floats to float16.
+ */
+inline void float_to_half_n(const float* src, float16* dst, size_t n) {
+    size_t i = 0;
+#if defined(__F16C__)
+    for (; i + 8 <= n; i += 8) {
+        __m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), h);
+    }
+#endif
+    for (; i < n; ++i) dst[i].bits = float_to_half_bits(src[i]);
+}
+
+/**
+ * @brief Widen `n` bfloat16 values to float.
+ */
+inline void half_to_float_n(const bfloat16* src, float* dst, size_t n) {
+    for (size_t i = 0; i < n; ++i) dst[i] = bfloat16_bits_to_float(src[i].bits);
+}
+
+/**
+ * @brief Round `n` floats to bfloat16.
+ */
+inline void float_to_half_n(const float* src, bfloat16* dst, size_t n) {
+    size_t i = 0;
+#if defined(__AVX512BF16__) && defined(__AVX512F__)
+    for (; i + 16 <= n; i += 16) {
+        __m256bh b = _mm512_cvtneps_pbh(_mm512_loadu_ps(src + i));
+        std::memcpy(static_cast<void*>(dst + i), &b, sizeof(b));
+    }
+#endif
+    for (; i < n; ++i) dst[i].bits = float_to_bfloat16_bits(src[i]);
+}
+
+} // namespace numbits
+
+namespace std {
+
+/**
+ * @brief Limits of float16 (binary16).
+ */
+template<>
+struct numeric_limits<numbits::float16> {
+    static constexpr bool is_specialized = true;
+    static constexpr bool is_signed = true;
+    static constexpr bool is_integer = false;
+    static constexpr bool is_exact = false;
+    static constexpr bool has_infinity = true;
+    static constexpr bool has_quiet_NaN = true;
+    static constexpr int digits = 11;
+    static constexpr int max_exponent = 16;
+    static constexpr int min_exponent = -13;
+    static numbits::float16 min() { return numbits::float16::from_bits(0x0400); }
+    static numbits::float16 max() { return numbits::float16::from_bits(0x7BFF); }
+    static numbits::float16 lowest() { return numbits::float16::from_bits(0xFBFF); }
+    static numbits::float16 epsilon() { return numbits::float16::from_bits(0x1400); }
+    static numbits::float16 infinity() { return numbits::float16::from_bits(0x7C00); }
+    static numbits::float16 quiet_NaN() { return numbits::float16::from_bits(0x7E00); }
+    static numbits::float16 denorm_min() { return numbits::float16::from_bits(0x0001); }
+};
+
+/**
+ * @brief Limits of bfloat16.
+ */
+template<>
+struct numeric_limits<numbits::bfloat16> {
+    static constexpr bool is_specialized = true;
+    static constexpr bool is_signed = true;
+    static constexpr bool is_integer = false;
+    static constexpr bool is_exact = false;
+    static constexpr bool has_infinity = true;
+    static constexpr bool has_quiet_NaN = true;
+    static constexpr int digits = 8;
+    static constexpr int max_exponent = 128;
+    static constexpr int min_exponent = -125;
+    static numbits::bfloat16 min() { return numbits::bfloat16::from_bits(0x0080); }
+    static numbits::bfloat16 max() { return numbits::bfloat16::from_bits(0x7F7F); }
+    static numbits::bfloat16 lowest() { return numbits::bfloat16::from_bits(0xFF7F); }
+    static numbits::bfloat16 epsilon() { return numbits::bfloat16::from_bits(0x3C00); }
+    static numbits::bfloat16 infinity() { return numbits::bfloat16::from_bits(0x7F80); }
+    static numbits::bfloat16 quiet_NaN() { return numbits::bfloat16::from_bits(0x7FC0); }
+    static numbits::bfloat16 denorm_min() { return numbits::bfloat16::from_bits(0x0001); }
+};
+
+} // namespace std
@@ -4,10 +4,21 @@
  *
  * Provides:
  *   - Slice specification for range-based indexing
+ *   - slice(): N-dimensional basic slicing (ranges, negative steps,
+ *     integer indices, newaxis, ellipsis) returning O(1) strided views
  *   - take(): Extract elements at specified indices along an axis
- *   - Boolean indexing via where()
+ *   - Boolean indexing via where(), with scalar operands and in-place broadcasting
+ *   - Boolean masks: masked_select(), compress(), nonzero(), argwhere(),
+ *     masked_fill(), masked_assign()
  *   - Advanced indexing with index arrays
- *   - Basic 1D slicing
+ *   - put(), scatter_add(), index_add(): indexed writes and accumulation
+ *
+ * Gathers copy whole contiguous inner rows and run in parallel over the
+ * indices (OpenMP). Accumulating scatters partition the destination between
+ * threads so results are deterministic and identical to a serial run.
+ * Mask compaction counts selected elements per block (eight mask bytes at
+ * a time), prefix-sums the counts and then compacts every block in
+ * parallel directly into its final position.
  *
  * @namespace numbits
  */
@@ -16,8 +27,19 @@
 
 #include "ndarray.hpp"
 #include "broadcasting.hpp"
+#include "strided_view.hpp"
+#include <algorithm>
 #include <vector>
+#include <cstring>
+#include <cstdint>
+#include <limits>
+#include <atomic>
 #include <stdexcept>
+#include <type_traits>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 namespace numbits {
 
@@ -30,30 +52,233 @@ namespace numbits {
  *  - `stop`: ending index of the slice (exclusive)
  *  - `step`: step size between elements
  *
- * A special case is `Slice::all()` which produces the slice (0, 0, 1),
- * interpreted by higher-level utilities as selecting the entire dimension.
+ * Semantics follow Python/NumPy `start:stop:step`: negative indices count
+ * from the end, out-of-range bounds are clamped, and a negative step walks
+ * backwards. A bound equal to `Slice::NONE` is omitted and takes its
+ * default (the whole dimension in the direction of `step`), so `Slice()`
+ * and `Slice::all()` select the entire dimension.
  */
 struct Slice {
-    size_t start; ///< Starting index (inclusive)
-    size_t stop;  ///< Ending index (exclusive)
-    size_t step;  ///< Step between indices
+    /// Marker for an omitted start or stop.
+    static constexpr index_t NONE = std::numeric_limits<index_t>::min();
+
+    index_t start; ///< Starting index (inclusive)
+    index_t stop;  ///< Ending index (exclusive)
+    index_t step;  ///< Step between indices
 
     /**
      * @brief Construct a new Slice.
-     * @param s Start index
-     * @param e Stop index
-     * @param st Step size
+     * @param s Start index (NONE for the default)
+     * @param e Stop index (NONE for the default)
+     * @param st Step size (must be non-zero)
      */
-    Slice(size_t s = 0, size_t e = 0, size_t st = 1) 
+    Slice(index_t s = NONE, index_t e = NONE, index_t st = 1)
         : start(s), stop(e), step(st) {}
 
     /**
      * @brief Create a slice that selects the entire dimension.
-     * @return Slice (0, 0, 1)
+     * @return Slice (NONE, NONE, 1)
      */
-    static Slice all() { return Slice(0, 0, 1); }
+    static Slice all() { return Slice(NONE, NONE, 1); }
 };
 
+/// Tag type of `newaxis`.
+struct newaxis_t {};
+
+/// Tag type of `ellipsis`.
+struct ellipsis_t {};
+
+/// Inserts a new dimension of extent 1 (NumPy `np.newaxis`).
+inline constexpr newaxis_t newaxis{};
+
+/// Expands to as many full slices as needed (NumPy `...`).
+inline constexpr ellipsis_t ellipsis{};
+
+/**
+ * @struct SliceArg
+ * @brief One entry of an N-dimensional slice specification.
+ *
+ * Implicitly constructed from an integer (selects one position and drops
+ * the dimension), a Slice, `newaxis` or `ellipsis`.
+ */
+struct SliceArg {
+    enum class Kind { Index, Range, NewAxis, Ellipsis };
+
+    Kind kind;
+    index_t index = 0;
+    Slice range;
+
+    template<typename I, typename = std::enable_if_t<std::is_integral_v<I>>>
+    SliceArg(I i) : kind(Kind::Index), index(static_cast<index_t>(i)) {}
+    SliceArg(const Slice& s) : kind(Kind::Range), range(s) {}
+    SliceArg(newaxis_t) : kind(Kind::NewAxis) {}
+    SliceArg(ellipsis_t) : kind(Kind::Ellipsis) {}
+};
+
+/**
+ * @brief Minimum number of bytes moved before gather/scatter kernels run in parallel.
+ */
+constexpr size_t GATHER_PARALLEL_BYTES = size_t(1) << 16;
+
+/**
+ * @brief Resolve an index along a dimension of length `len`.
+ *
+ * Negative signed indices count from the end, as in NumPy.
+ *
+ * @throws std::out_of_range If the index is outside [-len, len).
+ */
+template<typename I>
+size_t normalize_index(I idx, size_t len) {
+    if constexpr (std::is_signed_v<I>) {
+        if (idx < 0) {
+            if (static_cast<size_t>(-(idx + 1)) >= len) throw std::out_of_range("Index out of range");
+            return len - 1 - static_cast<size_t>(-(idx + 1));
+        }
+    }
+    if (static_cast<size_t>(idx) >= len) throw std::out_of_range("Index out of range");
+    return static_cast<size_t>(idx);
+}
+
+/**
+ * @brief A contiguous array viewed as `(outer, len, inner)` around one axis.
+ */
+struct AxisSplit {
+    size_t outer; ///< Product of the dimensions before the axis
+    size_t len;   ///< Length of the axis
+    size_t inner; ///< Product of the dimensions after the axis (row length)
+};
+
+/**
+ * @brief Split a shape around `axis`.
+ *
+ * @throws std::runtime_error If axis is out of range.
+ */
+inline AxisSplit split_axis(const Shape& shape, size_t axis) {
+    if (axis >= shape.size()) throw std::runtime_error("Axis out of range");
+    AxisSplit split{1, shape[axis], 1};
+    for (size_t i = 0; i < axis; ++i) split.outer *= shape[i];
+    for (size_t i = axis + 1; i < shape.size(); ++i) split.inner *= shape[i];
+    return split;
+}
+
+/**
+ * @brief Adjacent lanes handed to one for_each_lane_group() call when the axis is not innermost.
+ */
+constexpr size_t LANE_GROUP_COLUMNS = 256;
+
+/**
+ * @brief Run `fn(base, width)` over groups of adjacent lanes along an axis.
+ *
+ * Lane `c < width` of a group has elements `data[base + c + j * split.inner]`
+ * for `j < split.len`, so a kernel that walks `j` outermost reads whole
+ * contiguous rows of up to LANE_GROUP_COLUMNS lanes at a time. Contiguous
+ * lanes (`inner == 1`) come one per group. Groups are distributed over
+ * threads when `parallel` is set.
+ */
+template<typename Fn>
+void for_each_lane_group(const AxisSplit& split, bool parallel, Fn fn) {
+    const size_t groups = split.inner == 1 ? 1 : (split.inner + LANE_GROUP_COLUMNS - 1) / LANE_GROUP_COLUMNS;
+    const index_t tasks = static_cast<index_t>(split.outer * groups);
+    (void)parallel;
+#ifdef _OPENMP
+    #pragma omp parallel for if(parallel && tasks > 1) schedule(static)
+#endif
+    for (index_t t = 0; t < tasks; ++t) {
+        const size_t o = static_cast<size_t>(t) / groups;
+        const size_t c0 = (static_cast<size_t>(t) % groups) * LANE_GROUP_COLUMNS;
+        const size_t width = std::min(LANE_GROUP_COLUMNS, split.inner - c0);
+        fn(o * split.len * split.inner + c0, width);
+    }
+}
+
+/**
+ * @brief Gather rows along an axis: `dst[o, k, :] = src[o, rows[k], :]`.
+ *
+ * Rows must already be validated. Each output row is one memcpy; the
+ * `(outer, n)` row pairs are distributed over threads when enough data
+ * moves.
+ *
+ * @param src Contiguous source data.
+ * @param split Source extents around the gathered axis.
+ * @param rows Row indices along the axis.
+ * @param n Number of row indices.
+ * @param dst Contiguous destination of `split.outer * n * split.inner` elements.
+ */
+template<typename T>
+void gather_rows(const T* src, const AxisSplit& split, const size_t* rows, size_t n, T* dst) {
+    const size_t inner = split.inner;
+    const index_t total = static_cast<index_t>(split.outer * n);
+    const bool parallel = static_cast<size_t>(total) * inner * sizeof(T) >= GATHER_PARALLEL_BYTES;
+    (void)parallel;
+
+    if (inner == 1) {
+#ifdef _OPENMP
+        #pragma omp parallel for if(parallel) schedule(static)
+#endif
+        for (index_t t = 0; t < total; ++t) {
+            size_t o = static_cast<size_t>(t) / n, k = static_cast<size_t>(t) % n;
+            dst[t] = src[o * split.len + rows[k]];
+        }
+        return;
+    }
+
+#ifdef _OPENMP
+    #pragma omp parallel for if(parallel) schedule(static)
+#endif
+    for (index_t t = 0; t < total; ++t) {
+        size_t o = static_cast<size_t>(t) / n, k = static_cast<size_t>(t) % n;
+        copy_row(src + (o * split.len + rows[k]) * inner, inner, dst + static_cast<size_t>(t) * inner);
+    }
+}
+
+/**
+ * @brief Group positions of `targets` by the partition of [0, extent) that owns them.
+ *
+ * Partition p covers [extent * p / parts, extent * (p + 1) / parts). After
+ * a counting pass and a prefix sum, `order[offsets[p] .. offsets[p + 1])`
+ * lists the positions i whose target falls in partition p, in increasing i,
+ * so each thread walks only its own updates and applies them in index order.
+ */
+inline void bucket_by_partition(const std::vector<size_t>& targets, size_t extent, size_t parts,
+                                std::vector<size_t>& offsets, std::vector<size_t>& order) {
+    auto owner = [&](size_t f) {
+        size_t p = f * parts / extent;
+        while (p + 1 < parts && extent * (p + 1) / parts <= f) ++p;
+        while (p > 0 && extent * p / parts > f) --p;
+        return p;
+    };
+    std::vector<size_t> owners(targets.size());
+    offsets.assign(parts + 1, 0);
+    for (size_t i = 0; i < targets.size(); ++i) ++offsets[(owners[i] = owner(targets[i])) + 1];
+    for (size_t p = 0; p < parts; ++p) offsets[p + 1] += offsets[p];
+    order.resize(targets.size());
+    std::vector<size_t> next(offsets.begin(), offsets.end() - 1);
+    for (size_t i = 0; i < targets.size(); ++i) order[next[owners[i]]++] = i;
+}
+
+/**
+ * @brief Number of destination partitions for an accumulating scatter (1 when serial).
+ */
+inline size_t scatter_partitions(size_t extent, bool parallel) {
+#ifdef _OPENMP
+    if (parallel && extent > 1) return std::min(static_cast<size_t>(omp_get_max_threads()), extent);
+#endif
+    (void)parallel;
+    (void)extent;
+    return 1;
+}
+
+/**
+ * @brief Validate and normalize a list of indices along a dimension of length `len`.
+ */
+template<typename It>
+std::vector<size_t> normalize_indices(It first, It last, size_t len) {
+    std::vector<size_t> rows;
+    rows.reserve(static_cast<size_t>(std::distance(first, last)));
+    for (; first != last; ++first) rows.push_back(normalize_index(*first, len));
+    return rows;
+}
+
 /**
  * @brief Extract elements of an ndarray along a given axis using explicit indices.
  *
@@ -73,38 +298,266 @@ struct Slice {
  */
 template<typename T>
 ndarray<T> take(const ndarray<T>& arr, const std::vector<size_t>& indices, size_t axis = 0) {
-    if (axis >= arr.ndim()) {
-        throw std::runtime_error("Axis out of range");
-    }
-    
+    AxisSplit split = split_axis(arr.shape(), axis);
+    std::vector<size_t> rows = normalize_indices(indices.begin(), indices.end(), split.len);
+
     Shape result_shape = arr.shape();
-    result_shape[axis] = indices.size();
+    result_shape[axis] = rows.size();
     ndarray<T> result(result_shape);
-    
-    for (size_t i = 0; i < indices.size(); ++i) {
-        size_t idx = indices[i];
-        if (idx >= arr.shape()[axis]) {
-            throw std::out_of_range("Index out of range");
+    if (result.size() > 0) gather_rows(arr.data(), split, rows.data(), rows.size(), result.data());
+    return result;
+}
+
+/**
+ * @brief Gather along an axis with an integer index array (NumPy `take`).
+ *
+ * The selected axis is replaced by the shape of `indices`:
+ * `arr` of shape {N, D} with indices {B, L} along axis 0 yields {B, L, D}
+ * (an embedding lookup). Negative indices count from the end. Each output
+ * row is a single contiguous copy, parallelized over the indices.
+ *
+ * @param arr Input array
+ * @param indices Index array of any shape
+ * @param axis Axis to gather along (default: 0)
+ * @return ndarray<T> Gathered array
+ *
+ * @throws std::runtime_error If axis is out of range
+ * @throws std::out_of_range If any index is invalid
+ */
+template<typename T>
+ndarray<T> take(const ndarray<T>& arr, const ndarray<int64_t>& indices, size_t axis = 0) {
+    AxisSplit split = split_axis(arr.shape(), axis);
+    std::vector<size_t> rows = normalize_indices(indices.begin(), indices.end(), split.len);
+
+    Shape result_shape(arr.shape().begin(), arr.shape().begin() + axis);
+    result_shape.insert(result_shape.end(), indices.shape().begin(), indices.shape().end());
+    result_shape.insert(result_shape.end(), arr.shape().begin() + axis + 1, arr.shape().end());
+
+    ndarray<T> result(result_shape);
+    if (result.size() > 0) gather_rows(arr.data(), split, rows.data(), rows.size(), result.data());
+    return result;
+}
+
+/**
+ * @brief Write values at flat indices (NumPy `put`).
+ *
+ * `arr.flat[indices[i]] = values[i % values.size()]`; with repeated indices
+ * the last write wins.
+ *
+ * @throws std::out_of_range If any index is invalid
+ * @throws std::runtime_error If values is empty while indices is not
+ */
+template<typename T>
+void put(ndarray<T>& arr, const ndarray<int64_t>& indices, const ndarray<T>& values) {
+    if (indices.size() == 0) return;
+    if (values.size() == 0) throw std::runtime_error("put: values must not be empty");
+    std::vector<size_t> flat = normalize_indices(indices.begin(), indices.end(), arr.size());
+    T* dst = arr.data();
+    const T* src = values.data();
+    for (size_t i = 0; i < flat.size(); ++i) dst[flat[i]] = src[i % values.size()];
+}
+
+/**
+ * @brief Unbuffered accumulation at flat indices (NumPy `add.at`).
+ *
+ * `arr.flat[indices[i]] += values[i]` for every i, so repeated indices
+ * accumulate. In parallel, the updates are first bucketed by the contiguous
+ * range of `arr` they land in; each thread then applies its own bucket in
+ * index order, which avoids atomics and makes the result bit-identical to a
+ * serial run.
+ *
+ * @throws std::runtime_error If indices and values differ in size
+ * @throws std::out_of_range If any index is invalid
+ */
+template<typename T>
+void scatter_add(ndarray<T>& arr, const ndarray<int64_t>& indices, const ndarray<T>& values) {
+    if (indices.size() != values.size())
+        throw std::runtime_error("scatter_add: indices and values must have the same size");
+    std::vector<size_t> flat = normalize_indices(indices.begin(), indices.end(), arr.size());
+    T* dst = arr.data();
+    const T* src = values.data();
+    const size_t n = flat.size();
+    const size_t parts = scatter_partitions(arr.size(), n * sizeof(T) >= GATHER_PARALLEL_BYTES);
+    if (parts == 1) {
+        for (size_t i = 0; i < n; ++i) dst[flat[i]] += src[i];
+        return;
+    }
+    std::vector<size_t> offsets, order;
+    bucket_by_partition(flat, arr.size(), parts, offsets, order);
+    const index_t count = static_cast<index_t>(parts);
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(static, 1)
+#endif
+    for (index_t p = 0; p < count; ++p)
+        for (size_t k = offsets[static_cast<size_t>(p)]; k < offsets[static_cast<size_t>(p) + 1]; ++k)
+            dst[flat[order[k]]] += src[order[k]];
+}
+
+/**
+ * @brief Accumulate slices of `source` into `arr` along an axis (PyTorch `index_add_`).
+ *
+ * For every i: `arr[..., index[i], ...] += source[..., i, ...]`, where the
+ * indexed axis of `source` has length `index.size()` and all other
+ * dimensions match `arr`. Rows are added with contiguous inner loops; the
+ * destination rows along the axis are partitioned between threads so the
+ * result does not depend on thread count.
+ *
+ * @throws std::runtime_error If axis or shapes are invalid
+ * @throws std::out_of_range If any index is invalid
+ */
+template<typename T>
+void index_add(ndarray<T>& arr, size_t axis, const ndarray<int64_t>& index, const ndarray<T>& source) {
+    AxisSplit split = split_axis(arr.shape(), axis);
+    if (index.ndim() != 1) throw std::runtime_error("index_add: index must be 1D");
+    Shape expected = arr.shape();
+    expected[axis] = index.size();
+    if (source.shape() != expected)
+        throw std::runtime_error("index_add: source shape " + shape_to_string(source.shape()) +
+                                 " does not match " + shape_to_string(expected));
+    std::vector<size_t> rows = normalize_indices(index.begin(), index.end(), split.len);
+
+    T* dst = arr.data();
+    const T* src = source.data();
+    const size_t n = rows.size();
+    const size_t inner = split.inner;
+    const size_t parts = scatter_partitions(split.len, source.size() * sizeof(T) >= GATHER_PARALLEL_BYTES);
+    std::vector<size_t> offsets, order;
+    if (parts == 1) {
+        offsets = {0, n};
+        order.resize(n);
+        for (size_t i = 0; i < n; ++i) order[i] = i;
+    } else {
+        bucket_by_partition(rows, split.len, parts, offsets, order);
+    }
+    const index_t count = static_cast<index_t>(parts);
+#ifdef _OPENMP
+    #pragma omp parallel for if(parts > 1) schedule(static, 1)
+#endif
+    for (index_t p = 0; p < count; ++p) {
+        for (size_t o = 0; o < split.outer; ++o) {
+            for (size_t k = offsets[static_cast<size_t>(p)]; k < offsets[static_cast<size_t>(p) + 1]; ++k) {
+                const size_t i = order[k];
+                T* d = dst + (o * split.len + rows[i]) * inner;
+                const T* s = src + (o * n + i) * inner;
+                for (size_t j = 0; j < inner; ++j) d[j] += s[j];
+            }
+        }
+    }
+}
+
+/**
+ * @brief Number of output elements per work item in the where() kernel.
+ */
+constexpr size_t WHERE_CHUNK = 4096;
+
+/**
+ * @brief Blend one run: `out[j] = c[j*cs] ? x[j*xs] : y[j*ys]`.
+ *
+ * Steps of 0 (broadcast or scalar operand) and 1 (contiguous operand) get
+ * dedicated loops in which both candidates are loaded unconditionally, so
+ * the compiler turns the selection into vector blends.
+ */
+template<typename T>
+inline void blend_run(const bool* c, size_t cs, const T* x, size_t xs, const T* y, size_t ys,
+                      T* out, size_t len) {
+    if (cs == 0) {
+        // Uniform condition over the run: copy or fill from one operand
+        const T* src = c[0] ? x : y;
+        size_t step = c[0] ? xs : ys;
+        if (step == 1) copy_row(src, len, out);
+        else if (step == 0) std::fill(out, out + len, src[0]);
+        else for (size_t j = 0; j < len; ++j) out[j] = src[j * step];
+        return;
+    }
+    if (cs == 1 && xs == 1 && ys == 1) {
+        for (size_t j = 0; j < len; ++j) {
+            T a = x[j], b = y[j];
+            out[j] = c[j] ? a : b;
         }
-        
-        // Copy slice at this index
-        for (size_t j = 0; j < result.size() / indices.size(); ++j) {
-            std::vector<size_t> result_indices = unravel_index(
-                i * (result.size() / indices.size()) + j, 
-                result_shape, result.strides()
-            );
+    } else if (cs == 1 && xs == 1 && ys == 0) {
+        const T b = y[0];
+        for (size_t j = 0; j < len; ++j) {
+            T a = x[j];
+            out[j] = c[j] ? a : b;
+        }
+    } else if (cs == 1 && xs == 0 && ys == 1) {
+        const T a = x[0];
+        for (size_t j = 0; j < len; ++j) {
+            T b = y[j];
+            out[j] = c[j] ? a : b;
+        }
+    } else if (cs == 1 && xs == 0 && ys == 0) {
+        const T a = x[0], b = y[0];
+        for (size_t j = 0; j < len; ++j) out[j] = c[j] ? a : b;
+    } else {
+        for (size_t j = 0; j < len; ++j) out[j] = c[j * cs] ? x[j * xs] : y[j * ys];
+    }
+}
+
+/**
+ * @brief Strided where() kernel writing a contiguous output of `shape`.
+ *
+ * Each operand is described by a data pointer and per-dimension strides
+ * (0 where broadcast), so nothing is materialized. Trailing dimensions
+ * that every operand traverses with a constant step are merged into a
+ * single run handed to blend_run(); runs are split into WHERE_CHUNK pieces
+ * and processed in parallel for large outputs.
+ */
+template<typename T>
+void where_strided(const Shape& shape, const bool* c, const Strides& cst,
+                   const T* x, const Strides& xst, const T* y, const Strides& yst, T* out) {
+    const size_t total = compute_size(shape);
+    if (total == 0) return;
 
-            std::vector<size_t> arr_indices = result_indices;
-            arr_indices[axis] = idx;
+    // Drop unit dimensions; they never move any operand
+    Shape dims;
+    Strides sc, sx, sy;
+    for (size_t d = 0; d < shape.size(); ++d) {
+        if (shape[d] == 1) continue;
+        dims.push_back(shape[d]);
+        sc.push_back(cst[d]);
+        sx.push_back(xst[d]);
+        sy.push_back(yst[d]);
+    }
+    if (dims.empty()) {
+        out[0] = c[0] ? x[0] : y[0];
+        return;
+    }
 
-            size_t arr_idx = flatten_index(arr_indices, arr.strides());
-            size_t result_idx = flatten_index(result_indices, result.strides());
+    // Merge trailing dimensions with a constant step per operand
+    size_t nd = dims.size();
+    const size_t cs = sc[nd - 1], xs = sx[nd - 1], ys = sy[nd - 1];
+    size_t inner = dims[nd - 1];
+    size_t outer_dims = nd - 1;
+    while (outer_dims > 0) {
+        size_t d = outer_dims - 1;
+        if (sc[d] != cs * inner || sx[d] != xs * inner || sy[d] != ys * inner) break;
+        inner *= dims[d];
+        --outer_dims;
+    }
 
-            result[result_idx] = arr[arr_idx];
+    const size_t chunks = (inner + WHERE_CHUNK - 1) / WHERE_CHUNK;
+    const index_t tasks = static_cast<index_t>((total / inner) * chunks);
+    const bool parallel = tasks > 1 && total * sizeof(T) >= GATHER_PARALLEL_BYTES;
+    (void)parallel;
+#ifdef _OPENMP
+    #pragma omp parallel for if(parallel) schedule(static)
+#endif
+    for (index_t t = 0; t < tasks; ++t) {
+        size_t row = static_cast<size_t>(t) / chunks;
+        size_t lo = (static_cast<size_t>(t) % chunks) * WHERE_CHUNK;
+        size_t len = std::min(WHERE_CHUNK, inner - lo);
+        size_t oc = lo * cs, ox = lo * xs, oy = lo * ys;
+        size_t rem = row;
+        for (size_t d = outer_dims; d-- > 0;) {
+            size_t i = rem % dims[d];
+            rem /= dims[d];
+            oc += i * sc[d];
+            ox += i * sx[d];
+            oy += i * sy[d];
         }
+        blend_run(c + oc, cs, x + ox, xs, y + oy, ys, out + row * inner + lo, len);
     }
-    
-    return result;
 }
 
 /**
@@ -114,6 +567,8 @@ ndarray<T> take(const ndarray<T>& arr, const std::vector<size_t>& indices, size_
  *   result[i] = condition[i] ? x[i] : y[i]
  *
  * All inputs are broadcast to a common shape using NumPy broadcasting rules.
+ * Broadcast operands are read in place through zero strides rather than
+ * copied.
  *
  * @tparam T Element type
  * @param condition Boolean ndarray controlling selection
@@ -127,20 +582,463 @@ template<typename T>
 ndarray<T> where(const ndarray<bool>& condition, const ndarray<T>& x, const ndarray<T>& y) {
     Shape xy_shape = broadcast_shapes(x.shape(), y.shape());
     Shape broadcast_shape = broadcast_shapes(condition.shape(), xy_shape);
-    
-    ndarray<bool> cond_broadcast = broadcast_to(condition, broadcast_shape);
-    ndarray<T> x_broadcast = broadcast_to(x, broadcast_shape);
-    ndarray<T> y_broadcast = broadcast_to(y, broadcast_shape);
-    
+
     ndarray<T> result(broadcast_shape);
-    
-    for (size_t i = 0; i < result.size(); ++i) {
-        result[i] = cond_broadcast[i] ? x_broadcast[i] : y_broadcast[i];
+    where_strided(broadcast_shape,
+                  condition.data(), broadcast_strides(condition.shape(), broadcast_shape),
+                  x.data(), broadcast_strides(x.shape(), broadcast_shape),
+                  y.data(), broadcast_strides(y.shape(), broadcast_shape),
+                  result.data());
+    return result;
+}
+
+/**
+ * @brief where() with a scalar for the false branch, e.g. `where(mask, arr, 0)`.
+ *
+ * The result has the broadcast shape of condition and x.
+ */
+template<typename T>
+ndarray<T> where(const ndarray<bool>& condition, const ndarray<T>& x,
+                 const typename ndarray<T>::value_type& y) {
+    Shape shape = broadcast_shapes(condition.shape(), x.shape());
+    ndarray<T> result(shape);
+    where_strided(shape,
+                  condition.data(), broadcast_strides(condition.shape(), shape),
+                  x.data(), broadcast_strides(x.shape(), shape),
+                  &y, Strides(shape.size(), 0),
+                  result.data());
+    return result;
+}
+
+/**
+ * @brief where() with a scalar for the true branch.
+ *
+ * The result has the broadcast shape of condition and y.
+ */
+template<typename T>
+ndarray<T> where(const ndarray<bool>& condition, const typename ndarray<T>::value_type& x,
+                 const ndarray<T>& y) {
+    Shape shape = broadcast_shapes(condition.shape(), y.shape());
+    ndarray<T> result(shape);
+    where_strided(shape,
+                  condition.data(), broadcast_strides(condition.shape(), shape),
+                  &x, Strides(shape.size(), 0),
+                  y.data(), broadcast_strides(y.shape(), shape),
+                  result.data());
+    return result;
+}
+
+/**
+ * @brief where() with scalars for both branches; the result has the condition's shape.
+ */
+template<typename T>
+ndarray<T> where(const ndarray<bool>& condition, const T& x, const T& y) {
+    const Shape& shape = condition.shape();
+    ndarray<T> result(shape);
+    Strides zero(shape.size(), 0);
+    where_strided(shape, condition.data(), compute_strides(shape), &x, zero, &y, zero, result.data());
+    return result;
+}
+
+/**
+ * @brief Number of mask elements per block in the two-pass mask compaction.
+ */
+constexpr size_t MASK_BLOCK = size_t(1) << 15;
+
+/**
+ * @brief Count the true entries of a bool buffer.
+ *
+ * Reads eight mask bytes as one 64-bit word. Every byte is 0 or 1, so the
+ * population count of the word equals its byte sum, which a single
+ * multiply gathers into the top byte.
+ */
+inline size_t count_true(const bool* mask, size_t n) {
+    constexpr uint64_t ONES = 0x0101010101010101ull;
+    size_t count = 0, i = 0;
+    for (; i + 8 <= n; i += 8) {
+        uint64_t word;
+        std::memcpy(&word, mask + i, 8);
+        count += static_cast<size_t>((word * ONES) >> 56);
     }
-    
+    for (; i < n; ++i) count += mask[i];
+    return count;
+}
+
+/**
+ * @brief First pass of mask compaction: exclusive prefix sum of per-block counts.
+ *
+ * @return `blocks + 1` offsets; `offsets[b]` is where block `b` writes its
+ *         first selected element and `offsets.back()` is the total count.
+ */
+inline std::vector<size_t> mask_block_offsets(const bool* mask, size_t n, bool parallel) {
+    const size_t blocks = (n + MASK_BLOCK - 1) / MASK_BLOCK;
+    std::vector<size_t> offsets(blocks + 1, 0);
+    const index_t nb = static_cast<index_t>(blocks);
+    (void)parallel;
+#ifdef _OPENMP
+    #pragma omp parallel for if(parallel) schedule(static)
+#endif
+    for (index_t b = 0; b < nb; ++b) {
+        size_t lo = static_cast<size_t>(b) * MASK_BLOCK;
+        size_t hi = std::min(n, lo + MASK_BLOCK);
+        offsets[static_cast<size_t>(b) + 1] = count_true(mask + lo, hi - lo);
+    }
+    for (size_t b = 0; b < blocks; ++b) offsets[b + 1] += offsets[b];
+    return offsets;
+}
+
+/**
+ * @brief Second pass of mask compaction: call `emit(i, k)` for the k-th true entry i.
+ *
+ * Blocks are independent and run in parallel. Within a block, all-false
+ * words are skipped and all-true words emit eight consecutive elements
+ * without testing individual bytes.
+ */
+template<typename Emit>
+void compact_mask(const bool* mask, size_t n, const std::vector<size_t>& offsets,
+                  bool parallel, const Emit& emit) {
+    constexpr uint64_t ALL_TRUE = 0x0101010101010101ull;
+    const index_t nb = static_cast<index_t>(offsets.size() - 1);
+    (void)parallel;
+#ifdef _OPENMP
+    #pragma omp parallel for if(parallel) schedule(static)
+#endif
+    for (index_t b = 0; b < nb; ++b) {
+        size_t k = offsets[static_cast<size_t>(b)];
+        if (k == offsets[static_cast<size_t>(b) + 1]) continue;
+        size_t i = static_cast<size_t>(b) * MASK_BLOCK;
+        const size_t hi = std::min(n, i + MASK_BLOCK);
+        for (; i + 8 <= hi; i += 8) {
+            uint64_t word;
+            std::memcpy(&word, mask + i, 8);
+            if (word == 0) continue;
+            if (word == ALL_TRUE) {
+                for (size_t j = 0; j < 8; ++j) emit(i + j, k + j);
+                k += 8;
+                continue;
+            }
+            for (size_t j = 0; j < 8; ++j)
+                if (mask[i + j]) emit(i + j, k++);
+        }
+        for (; i < hi; ++i)
+            if (mask[i]) emit(i, k++);
+    }
+}
+
+/**
+ * @brief Return a bool buffer of `shape` for `mask`, broadcasting it into `storage` if needed.
+ *
+ * @throws std::runtime_error If the mask cannot be broadcast to `shape`.
+ */
+inline const bool* resolve_mask(const Shape& shape, const ndarray<bool>& mask, ndarray<bool>& storage) {
+    if (mask.shape() == shape) return mask.data();
+    if (broadcast_shapes(mask.shape(), shape) != shape)
+        throw std::runtime_error("Mask of shape " + shape_to_string(mask.shape()) +
+                                 " cannot be broadcast to array of shape " + shape_to_string(shape));
+    storage = broadcast_to(mask, shape);
+    return storage.data();
+}
+
+/**
+ * @brief Return the truth value of every element as a bool buffer.
+ *
+ * Boolean arrays are used directly; other types are compared against zero
+ * into `storage`.
+ */
+template<typename T>
+const bool* truth_mask(const ndarray<T>& arr, ndarray<bool>& storage) {
+    if constexpr (std::is_same_v<T, bool>) {
+        (void)storage;
+        return arr.data();
+    } else {
+        storage = ndarray<bool>(arr.shape());
+        const T* src = arr.data();
+        bool* dst = storage.data();
+        const index_t n = static_cast<index_t>(arr.size());
+        const bool parallel = arr.size() * sizeof(T) >= GATHER_PARALLEL_BYTES;
+        (void)parallel;
+#ifdef _OPENMP
+        #pragma omp parallel for if(parallel) schedule(static)
+#endif
+        for (index_t i = 0; i < n; ++i) dst[i] = src[i] != T{};
+        return storage.data();
+    }
+}
+
+/**
+ * @brief Copy the elements of `src[0, n)` whose mask entry is true into a new 1D array.
+ */
+template<typename T>
+ndarray<T> select_by_mask(const T* src, const bool* mask, size_t n) {
+    const bool parallel = n * sizeof(T) >= GATHER_PARALLEL_BYTES;
+    std::vector<size_t> offsets = mask_block_offsets(mask, n, parallel);
+    ndarray<T> result(Shape{offsets.back()});
+    T* dst = result.data();
+    compact_mask(mask, n, offsets, parallel, [src, dst](size_t i, size_t k) { dst[k] = src[i]; });
+    return result;
+}
+
+/**
+ * @brief Flat indices of the true entries of a bool buffer.
+ */
+inline std::vector<size_t> mask_indices(const bool* mask, size_t n) {
+    const bool parallel = n * sizeof(size_t) >= GATHER_PARALLEL_BYTES;
+    std::vector<size_t> offsets = mask_block_offsets(mask, n, parallel);
+    std::vector<size_t> rows(offsets.back());
+    size_t* dst = rows.data();
+    compact_mask(mask, n, offsets, parallel, [dst](size_t i, size_t k) { dst[k] = i; });
+    return rows;
+}
+
+/**
+ * @brief Select the elements of an array where a boolean mask is true.
+ *
+ * Equivalent to NumPy `arr[mask]` for a full-shape mask (and to
+ * `torch.masked_select`, which also broadcasts the mask). Elements are
+ * returned in row-major order as a 1D array.
+ *
+ * @code
+ * auto big = masked_select(prices, greater(prices, threshold));
+ * @endcode
+ *
+ * @param arr Source array
+ * @param mask Boolean mask of arr's shape or broadcastable to it
+ * @return ndarray<T> 1D array of the selected elements
+ *
+ * @throws std::runtime_error If the mask cannot be broadcast to arr's shape
+ */
+template<typename T>
+ndarray<T> masked_select(const ndarray<T>& arr, const ndarray<bool>& mask) {
+    ndarray<bool> storage;
+    const bool* m = resolve_mask(arr.shape(), mask, storage);
+    return select_by_mask(arr.data(), m, arr.size());
+}
+
+/**
+ * @brief Select elements of the flattened array where `condition` is true.
+ *
+ * Matches NumPy `compress(condition, a)` with no axis: `condition` may be
+ * shorter than the array, in which case the remaining elements are dropped.
+ *
+ * @throws std::runtime_error If condition is not 1D
+ * @throws std::out_of_range If condition is longer than the array
+ */
+template<typename T>
+ndarray<T> compress(const ndarray<bool>& condition, const ndarray<T>& arr) {
+    if (condition.ndim() != 1) throw std::runtime_error("compress: condition must be 1D");
+    if (condition.size() > arr.size())
+        throw std::out_of_range("compress: condition longer than array");
+    return select_by_mask(arr.data(), condition.data(), condition.size());
+}
+
+/**
+ * @brief Select the slices along `axis` where `condition` is true.
+ *
+ * Matches NumPy `compress(condition, a, axis)`. Selected slices are copied
+ * as whole contiguous rows, in parallel for large results.
+ *
+ * @throws std::runtime_error If condition is not 1D or axis is out of range
+ * @throws std::out_of_range If condition is longer than the axis
+ */
+template<typename T>
+ndarray<T> compress(const ndarray<bool>& condition, const ndarray<T>& arr, size_t axis) {
+    if (condition.ndim() != 1) throw std::runtime_error("compress: condition must be 1D");
+    AxisSplit split = split_axis(arr.shape(), axis);
+    if (condition.size() > split.len)
+        throw std::out_of_range("compress: condition longer than axis " + std::to_string(axis));
+
+    std::vector<size_t> rows = mask_indices(condition.data(), condition.size());
+    Shape result_shape = arr.shape();
+    result_shape[axis] = rows.size();
+    ndarray<T> result(result_shape);
+    if (result.size() > 0) gather_rows(arr.data(), split, rows.data(), rows.size(), result.data());
     return result;
 }
 
+/**
+ * @brief Flat (row-major) indices of the non-zero elements.
+ *
+ * Matches NumPy `flatnonzero`.
+ */
+template<typename T>
+ndarray<int64_t> flatnonzero(const ndarray<T>& arr) {
+    ndarray<bool> storage;
+    const bool* m = truth_mask(arr, storage);
+    const size_t n = arr.size();
+    const bool parallel = n * sizeof(int64_t) >= GATHER_PARALLEL_BYTES;
+    std::vector<size_t> offsets = mask_block_offsets(m, n, parallel);
+    ndarray<int64_t> result(Shape{offsets.back()});
+    int64_t* dst = result.data();
+    compact_mask(m, n, offsets, parallel,
+                 [dst](size_t i, size_t k) { dst[k] = static_cast<int64_t>(i); });
+    return result;
+}
+
+/**
+ * @brief Convert flat indices to per-dimension coordinates.
+ *
+ * Writes coordinate `d` of point `k` to `out[k * point_stride + d * dim_stride]`,
+ * which serves both nonzero() (one array per dimension) and argwhere()
+ * (one row per point).
+ */
+inline void unravel_flat_indices(const int64_t* flat, size_t count, const Shape& shape,
+                                 int64_t* out, size_t point_stride, size_t dim_stride) {
+    const index_t n = static_cast<index_t>(count);
+    const size_t nd = shape.size();
+    const bool parallel = count * nd * sizeof(int64_t) >= GATHER_PARALLEL_BYTES;
+    (void)parallel;
+#ifdef _OPENMP
+    #pragma omp parallel for if(parallel) schedule(static)
+#endif
+    for (index_t k = 0; k < n; ++k) {
+        size_t rem = static_cast<size_t>(flat[k]);
+        int64_t* point = out + static_cast<size_t>(k) * point_stride;
+        for (size_t d = nd; d-- > 0;) {
+            point[d * dim_stride] = static_cast<int64_t>(rem % shape[d]);
+            rem /= shape[d];
+        }
+    }
+}
+
+/**
+ * @brief Indices of the non-zero elements, one index array per dimension.
+ *
+ * Matches NumPy `nonzero`: `result[d][k]` is the coordinate along `d` of
+ * the k-th non-zero element in row-major order, so the result can be fed
+ * straight to advanced_indexing().
+ */
+template<typename T>
+std::vector<ndarray<int64_t>> nonzero(const ndarray<T>& arr) {
+    ndarray<int64_t> flat = flatnonzero(arr);
+    const size_t nd = arr.ndim();
+    if (nd == 1) return {flat};
+
+    const size_t count = flat.size();
+    ndarray<int64_t> coords(Shape{nd, count});
+    if (count > 0) unravel_flat_indices(flat.data(), count, arr.shape(), coords.data(), 1, count);
+
+    std::vector<ndarray<int64_t>> result;
+    result.reserve(nd);
+    for (size_t d = 0; d < nd; ++d) {
+        ndarray<int64_t> axis_idx(Shape{count});
+        if (count > 0) copy_row(coords.data() + d * count, count, axis_idx.data());
+        result.push_back(std::move(axis_idx));
+    }
+    return result;
+}
+
+/**
+ * @brief Coordinates of the non-zero elements as a `{count, ndim}` array.
+ *
+ * Matches NumPy `argwhere`.
+ */
+template<typename T>
+ndarray<int64_t> argwhere(const ndarray<T>& arr) {
+    ndarray<int64_t> flat = flatnonzero(arr);
+    const size_t nd = arr.ndim();
+    ndarray<int64_t> result(Shape{flat.size(), nd});
+    if (result.size() > 0) unravel_flat_indices(flat.data(), flat.size(), arr.shape(), result.data(), nd, 1);
+    return result;
+}
+
+/**
+ * @brief Set the elements where `mask` is true to `value`, in place.
+ *
+ * Equivalent to NumPy `arr[mask] = value`.
+ *
+ * @throws std::runtime_error If the mask cannot be broadcast to arr's shape
+ */
+template<typename T>
+void masked_fill(ndarray<T>& arr, const ndarray<bool>& mask, const T& value) {
+    ndarray<bool> storage;
+    const bool* m = resolve_mask(arr.shape(), mask, storage);
+    T* data = arr.data();
+    const index_t n = static_cast<index_t>(arr.size());
+    const bool parallel = arr.size() * sizeof(T) >= GATHER_PARALLEL_BYTES;
+    (void)parallel;
+#ifdef _OPENMP
+    #pragma omp parallel for if(parallel) schedule(static)
+#endif
+    for (index_t i = 0; i < n; ++i) data[i] = m[i] ? value : data[i];
+}
+
+/**
+ * @brief Write `values` into the elements where `mask` is true, in order.
+ *
+ * Equivalent to NumPy `arr[mask] = values`: `values` must hold exactly one
+ * element per true mask entry (or a single element, which is broadcast).
+ *
+ * @throws std::runtime_error If the mask cannot be broadcast or the value count mismatches
+ */
+template<typename T>
+void masked_assign(ndarray<T>& arr, const ndarray<bool>& mask, const ndarray<T>& values) {
+    ndarray<bool> storage;
+    const bool* m = resolve_mask(arr.shape(), mask, storage);
+    const size_t n = arr.size();
+    const bool parallel = n * sizeof(T) >= GATHER_PARALLEL_BYTES;
+    std::vector<size_t> offsets = mask_block_offsets(m, n, parallel);
+
+    if (values.size() == 1 && offsets.back() != 1) {
+        masked_fill(arr, mask, values[0]);
+        return;
+    }
+    if (values.size() != offsets.back())
+        throw std::runtime_error("masked_assign: got " + std::to_string(values.size()) +
+                                 " values for " + std::to_string(offsets.back()) + " masked elements");
+
+    const T* src = values.data();
+    T* dst = arr.data();
+    compact_mask(m, n, offsets, parallel, [src, dst](size_t i, size_t k) { dst[i] = src[k]; });
+}
+
+/**
+ * @brief Gather single elements addressed by per-dimension index lists.
+ *
+ * Computes the flat offset of every point (validating it), then copies
+ * the elements; both passes run in parallel for large inputs.
+ *
+ * @param arr Source array
+ * @param indices One index container per dimension, all of equal length
+ * @param dst Destination with room for `indices[0].size()` elements
+ * @throws std::out_of_range If any index is invalid
+ */
+template<typename T, typename IndexList>
+void gather_points(const ndarray<T>& arr, const std::vector<IndexList>& indices, T* dst) {
+    const index_t n = static_cast<index_t>(indices[0].size());
+    const size_t ndim = arr.ndim();
+    const bool parallel = static_cast<size_t>(n) * sizeof(T) >= GATHER_PARALLEL_BYTES;
+    (void)parallel;
+    const T* src = arr.data();
+    std::vector<size_t> offsets(static_cast<size_t>(n));
+    std::atomic<bool> bad{false};
+
+#ifdef _OPENMP
+    #pragma omp parallel for if(parallel) schedule(static)
+#endif
+    for (index_t i = 0; i < n; ++i) {
+        size_t flat = 0;
+        for (size_t d = 0; d < ndim; ++d) {
+            auto idx = indices[d].begin()[i];
+            size_t len = arr.shape()[d];
+            bool negative = false;
+            if constexpr (std::is_signed_v<decltype(idx)>) negative = idx < 0;
+            if (negative) idx += static_cast<decltype(idx)>(len);
+            if ((negative && idx < decltype(idx){0}) || static_cast<size_t>(idx) >= len) {
+                bad.store(true, std::memory_order_relaxed);
+                idx = 0;
+            }
+            flat += static_cast<size_t>(idx) * arr.strides()[d];
+        }
+        offsets[static_cast<size_t>(i)] = flat;
+    }
+    if (bad.load()) throw std::out_of_range("Index out of range");
+
+#ifdef _OPENMP
+    #pragma omp parallel for if(parallel) schedule(static)
+#endif
+    for (index_t i = 0; i < n; ++i) dst[i] = src[offsets[static_cast<size_t>(i)]];
+}
+
 /**
  * @brief Advanced indexing using per-dimension index arrays.
  *
@@ -178,22 +1076,182 @@ ndarray<T> advanced_indexing(const ndarray<T>& arr,
         }
     }
     
-    ndarray<T> result({result_size});
-    
-    for (size_t i = 0; i < result_size; ++i) {
-        std::vector<size_t> coords;
-        coords.reserve(indices.size());
+    ndarray<T> result(Shape{result_size});
+    gather_points(arr, indices, result.data());
+    return result;
+}
 
-        for (const auto& idx_arr : indices) {
-            coords.push_back(idx_arr[i]);
+/**
+ * @brief Advanced indexing with integer index arrays (NumPy `arr[i0, i1, ...]`).
+ *
+ * All index arrays must have the same shape, which becomes the shape of the
+ * result. Negative indices count from the end.
+ *
+ * @throws std::runtime_error If the number of index arrays mismatches ndim or their shapes differ
+ * @throws std::out_of_range If any index is invalid
+ */
+template<typename T>
+ndarray<T> advanced_indexing(const ndarray<T>& arr, const std::vector<ndarray<int64_t>>& indices) {
+    if (indices.size() != arr.ndim()) {
+        throw std::runtime_error("Number of index ndarrays must match number of dimensions");
+    }
+    if (indices.empty()) {
+        return ndarray<T>();
+    }
+    for (const auto& idx_arr : indices) {
+        if (idx_arr.shape() != indices[0].shape()) {
+            throw std::runtime_error("All index ndarrays must have the same shape");
         }
-
-        result[i] = arr.at(coords);
     }
-    
+
+    ndarray<T> result(indices[0].shape());
+    gather_points(arr, indices, result.data());
     return result;
 }
 
+/**
+ * @brief Resolve a Slice against a dimension of length `len`.
+ *
+ * @param[out] first Index of the first selected element
+ * @return Number of selected elements
+ *
+ * @throws std::runtime_error If the step is zero
+ */
+inline size_t resolve_slice(const Slice& s, size_t len, index_t& first) {
+    if (s.step == 0) throw std::runtime_error("slice step cannot be zero");
+    const index_t n = static_cast<index_t>(len);
+    index_t start, stop;
+    if (s.step > 0) {
+        auto clamp = [n](index_t v, index_t dflt) {
+            if (v == Slice::NONE) return dflt;
+            if (v < 0) v += n;
+            return v < 0 ? index_t(0) : (v > n ? n : v);
+        };
+        start = clamp(s.start, 0);
+        stop = clamp(s.stop, n);
+        first = start;
+        return stop > start ? static_cast<size_t>((stop - start + s.step - 1) / s.step) : 0;
+    }
+    auto clamp = [n](index_t v, index_t dflt) {
+        if (v == Slice::NONE) return dflt;
+        if (v < 0) v += n;
+        return v < 0 ? index_t(-1) : (v >= n ? n - 1 : v);
+    };
+    start = clamp(s.start, n - 1);
+    stop = clamp(s.stop, -1);
+    first = start;
+    return start > stop ? static_cast<size_t>((start - stop - s.step - 1) / -s.step) : 0;
+}
+
+/**
+ * @brief Apply a slice specification to raw strided storage.
+ *
+ * Shared implementation of the slice() overloads; creates no copies.
+ */
+template<typename T>
+strided_view<T> slice_strided(T* data, const Shape& shape, const ViewStrides& strides,
+                              const std::vector<SliceArg>& args) {
+    using Kind = SliceArg::Kind;
+    size_t consumed = 0, ellipses = 0;
+    for (const auto& a : args) {
+        if (a.kind == Kind::Index || a.kind == Kind::Range) ++consumed;
+        else if (a.kind == Kind::Ellipsis) ++ellipses;
+    }
+    if (ellipses > 1) throw std::runtime_error("slice: at most one ellipsis is allowed");
+    if (consumed > shape.size())
+        throw std::out_of_range("slice: too many indices for array of dimension " +
+                                std::to_string(shape.size()));
+
+    Shape out_shape;
+    ViewStrides out_strides;
+    index_t offset = 0;
+    size_t dim = 0;
+
+    auto keep = [&](size_t count) {
+        for (size_t k = 0; k < count; ++k, ++dim) {
+            out_shape.push_back(shape[dim]);
+            out_strides.push_back(strides[dim]);
+        }
+    };
+
+    for (const auto& a : args) {
+        switch (a.kind) {
+        case Kind::Index: {
+            index_t i = a.index;
+            const index_t len = static_cast<index_t>(shape[dim]);
+            if (i < 0) i += len;
+            if (i < 0 || i >= len)
+                throw std::out_of_range("slice: index " + std::to_string(a.index) +
+                                        " out of bounds for axis " + std::to_string(dim) +
+                                        " with size " + std::to_string(len));
+            offset += i * strides[dim];
+            ++dim;
+            break;
+        }
+        case Kind::Range: {
+            index_t first = 0;
+            size_t n = resolve_slice(a.range, shape[dim], first);
+            if (n > 0) offset += first * strides[dim];
+            out_shape.push_back(n);
+            out_strides.push_back(a.range.step * strides[dim]);
+            ++dim;
+            break;
+        }
+        case Kind::NewAxis:
+            out_shape.push_back(1);
+            out_strides.push_back(0);
+            break;
+        case Kind::Ellipsis:
+            keep(shape.size() - consumed);
+            break;
+        }
+    }
+    keep(shape.size() - dim);
+
+    return strided_view<T>(data + offset, out_shape, out_strides);
+}
+
+/**
+ * @brief N-dimensional basic slicing, NumPy style, without copying.
+ *
+ * Each entry of `args` is an integer (selects one position and removes the
+ * dimension), a Slice, `newaxis` or `ellipsis`. Trailing dimensions not
+ * covered by `args` are kept whole. The result aliases `arr`; call
+ * `.copy()` on it to materialize a contiguous ndarray.
+ *
+ * @code
+ * ndarray<float> img(Shape{480, 640, 3});
+ * auto flipped = slice(img, {Slice(), Slice(Slice::NONE, Slice::NONE, -1)});  // img[:, ::-1]
+ * auto red     = slice(img, {ellipsis, 0});                                   // img[..., 0]
+ * auto batch   = slice(img, {newaxis});                                       // img[None]
+ * @endcode
+ *
+ * @throws std::out_of_range If an integer index is out of bounds or there are too many indices
+ * @throws std::runtime_error On a zero step or more than one ellipsis
+ */
+template<typename T>
+strided_view<T> slice(ndarray<T>& arr, const std::vector<SliceArg>& args) {
+    return slice_strided(arr.data(), arr.shape(),
+                         ViewStrides(arr.strides().begin(), arr.strides().end()), args);
+}
+
+/**
+ * @brief Read-only N-dimensional slicing of a const array.
+ */
+template<typename T>
+strided_view<const T> slice(const ndarray<T>& arr, const std::vector<SliceArg>& args) {
+    return slice_strided(arr.data(), arr.shape(),
+                         ViewStrides(arr.strides().begin(), arr.strides().end()), args);
+}
+
+/**
+ * @brief Slice an existing view; the result aliases the same storage.
+ */
+template<typename T>
+strided_view<T> slice(const strided_view<T>& view, const std::vector<SliceArg>& args) {
+    return slice_strided(view.data(), view.shape(), view.strides(), args);
+}
+
 /**
  * @brief Perform simple slicing on a 1D ndarray.
  *
@@ -227,16 +1285,8 @@ ndarray<T> slice_1d(const ndarray<T>& arr, size_t start, size_t stop, size_t ste
         return ndarray<T>({0});
     }
     
-    size_t result_size = (stop - start + step - 1) / step;
-    ndarray<T> result({result_size});
-    
-    for (size_t i = 0; i < result_size; ++i) {
-        size_t idx = start + i * step;
-        if (idx >= stop) break;
-        result[i] = arr[idx];
-    }
-    
-    return result;
+    return slice(arr, {Slice(static_cast<index_t>(start), static_cast<index_t>(stop),
+                             static_cast<index_t>(step))}).copy();
 }
 
 } // namespace numbits
@@ -6,6 +6,8 @@
  *   - Binary structured I/O (dump/load): Stores shape, type, and data
  *   - Text I/O (tofile/fromfile): Human-readable text with custom separators
  *   - Raw binary I/O: Stores only data without metadata
+ *   - Compressed `.cb` I/O (dump with CompressionOptions): shuffle + RLE/LZ chunks
+ *   - Chunked `.cb` I/O (ChunkReader/ChunkWriter): Streams arrays larger than RAM
  *
  * @namespace numbits
  */
@@ -15,10 +17,12 @@
 #include "ndarray.hpp"
 #include "types.hpp"
 #include "utils.hpp"
+#include "compression.hpp"
 #include <fstream>
 #include <sstream>
 #include <string>
 #include <stdexcept>
+#include <algorithm>
 
 namespace numbits {
 
@@ -134,7 +138,7 @@ ndarray<T> fromfile(const std::string& filename,
             throw std::runtime_error("Binary fromfile size mismatch");
 
         size_t count = bytes / sizeof(T);
-        ndarray<T> arr({count});
+        ndarray<T> arr(Shape{count});
 
         file.read(reinterpret_cast<char*>(arr.data()), bytes);
         if (!file) throw std::runtime_error("Error reading binary fromfile");
@@ -175,11 +179,91 @@ ndarray<T> fromfile(const std::string& filename,
             }
         }
 
-        return ndarray<T>(values);
+        return ndarray<T>(Shape{values.size()}, values);
     }
 }
 
 
+/**
+ * @brief Bit set in the stored dtype word of `.cb` files with a compressed payload.
+ *
+ * Plain files store the bare DType value, so files written before
+ * compression support load unchanged.
+ */
+constexpr uint32_t CB_COMPRESSED_FLAG = 0x100;
+
+/**
+ * @struct CbHeader
+ * @brief Metadata block at the start of every `.cb` file written by dump().
+ *
+ * `data_offset` is the byte position of the first payload byte. For
+ * uncompressed files this is the first element, so readers can seek
+ * directly to any row of the stored array.
+ */
+struct CbHeader {
+    DType dtype;                ///< Stored element type
+    Shape shape;                ///< Stored array shape
+    size_t size;                ///< Total element count
+    bool compressed = false;    ///< Payload uses the chunked compressed layout
+    std::streamoff data_offset; ///< Byte offset of the payload
+};
+
+/**
+ * @brief Write a `.cb` header (dtype, ndim, dims, size) to a stream.
+ *
+ * @param file Output stream positioned at the start of the file.
+ * @param dtype Element type tag.
+ * @param shape Array shape.
+ * @param compressed Mark the payload as compressed.
+ */
+inline void write_cb_header(std::ostream& file, DType dtype, const Shape& shape,
+                            bool compressed = false) {
+    static_assert(sizeof(DType) == sizeof(uint32_t), "DType must be stored as 32 bits");
+    uint32_t tag = static_cast<uint32_t>(dtype) | (compressed ? CB_COMPRESSED_FLAG : 0u);
+    file.write(reinterpret_cast<const char*>(&tag), sizeof(tag));
+
+    size_t ndim = shape.size();
+    file.write(reinterpret_cast<const char*>(&ndim), sizeof(size_t));
+    for (size_t dim : shape) {
+        file.write(reinterpret_cast<const char*>(&dim), sizeof(size_t));
+    }
+
+    size_t size = compute_size(shape);
+    file.write(reinterpret_cast<const char*>(&size), sizeof(size_t));
+}
+
+/**
+ * @brief Read and validate a `.cb` header from a stream.
+ *
+ * @param file Input stream positioned at the start of the file.
+ * @param filename Name used in error messages.
+ * @return Parsed header; the stream is left positioned at the payload.
+ *
+ * @throws std::runtime_error on truncated headers or shape-size mismatch.
+ */
+inline CbHeader read_cb_header(std::istream& file, const std::string& filename) {
+    CbHeader header;
+    uint32_t tag = 0;
+    file.read(reinterpret_cast<char*>(&tag), sizeof(tag));
+    header.compressed = (tag & CB_COMPRESSED_FLAG) != 0;
+    header.dtype = static_cast<DType>(tag & ~CB_COMPRESSED_FLAG);
+
+    size_t ndim = 0;
+    file.read(reinterpret_cast<char*>(&ndim), sizeof(size_t));
+    if (!file) throw std::runtime_error("Error reading header: " + filename);
+    header.shape = Shape(ndim);
+    for (size_t i = 0; i < ndim; ++i)
+        file.read(reinterpret_cast<char*>(&header.shape[i]), sizeof(size_t));
+
+    file.read(reinterpret_cast<char*>(&header.size), sizeof(size_t));
+    if (!file) throw std::runtime_error("Error reading header: " + filename);
+    if (header.size != compute_size(header.shape))
+        throw std::runtime_error("Shape-size mismatch in: " + filename);
+
+    header.data_offset = file.tellg();
+    return header;
+}
+
 /**
  * @brief Dump an ndarray to a structured binary file (similar to NumPy `.npy`/dump).
  *
@@ -205,27 +289,109 @@ void dump(const ndarray<T>& arr, const std::string& filename)
     std::ofstream file(full_filename, std::ios::binary);
     if (!file) throw std::runtime_error("Cannot open file for writing: " + full_filename);
 
-    // Write dtype
-    DType dtype = dtype_from_type<T>();
-    file.write(reinterpret_cast<const char*>(&dtype), sizeof(DType));
+    write_cb_header(file, dtype_from_type<T>(), arr.shape());
 
-    // Write shape
-    size_t ndim = arr.shape().size();
-    file.write(reinterpret_cast<const char*>(&ndim), sizeof(size_t));
-    for (size_t dim : arr.shape()) {
-        file.write(reinterpret_cast<const char*>(&dim), sizeof(size_t));
-    }
+    // Write raw binary payload
+    file.write(reinterpret_cast<const char*>(arr.data()), arr.size() * sizeof(T));
 
-    // Write size
-    size_t size = arr.size();
-    file.write(reinterpret_cast<const char*>(&size), sizeof(size_t));
+    if (!file) throw std::runtime_error("Error writing dump file: " + full_filename);
+}
 
-    // Write raw binary payload
-    file.write(reinterpret_cast<const char*>(arr.data()), size * sizeof(T));
+
+/**
+ * @brief Dump an ndarray to a compressed `.cb` file.
+ *
+ * Uses the same header as the uncompressed dump() with the
+ * CB_COMPRESSED_FLAG bit set in the dtype word, followed by:
+ *  1. Codec (uint32) and shuffle flag (uint32)
+ *  2. Uncompressed chunk size in bytes (size_t)
+ *  3. Chunk count (size_t) and the stored size of each chunk (size_t each)
+ *  4. The stored chunks back to back
+ *
+ * Chunks are compressed independently (in parallel with OpenMP), so load()
+ * can also decode them in parallel.
+ *
+ * @tparam T Element type.
+ * @param arr Array to serialize.
+ * @param filename Base filename (extension appended if needed).
+ * @param options Codec, shuffle filter and chunk size.
+ *
+ * @throws std::runtime_error if writing fails.
+ */
+template<typename T>
+void dump(const ndarray<T>& arr, const std::string& filename, const CompressionOptions& options)
+{
+    std::string full_filename = ensure_cb_extension(filename);
+    std::ofstream file(full_filename, std::ios::binary);
+    if (!file) throw std::runtime_error("Cannot open file for writing: " + full_filename);
+
+    write_cb_header(file, dtype_from_type<T>(), arr.shape(), true);
+
+    CompressedBuffer buffer = compress_chunks(arr.data(), arr.size() * sizeof(T),
+                                              sizeof(T), options);
+
+    uint32_t codec = static_cast<uint32_t>(options.codec);
+    uint32_t shuffle = options.shuffle ? 1u : 0u;
+    size_t chunk_bytes = aligned_chunk_bytes(options.chunk_bytes, sizeof(T));
+    size_t num_chunks = buffer.chunk_sizes.size();
+    file.write(reinterpret_cast<const char*>(&codec), sizeof(codec));
+    file.write(reinterpret_cast<const char*>(&shuffle), sizeof(shuffle));
+    file.write(reinterpret_cast<const char*>(&chunk_bytes), sizeof(size_t));
+    file.write(reinterpret_cast<const char*>(&num_chunks), sizeof(size_t));
+    file.write(reinterpret_cast<const char*>(buffer.chunk_sizes.data()),
+               num_chunks * sizeof(size_t));
+    file.write(reinterpret_cast<const char*>(buffer.payload.data()),
+               static_cast<std::streamsize>(buffer.payload.size()));
 
     if (!file) throw std::runtime_error("Error writing dump file: " + full_filename);
 }
 
+/**
+ * @brief Read and decode the compressed payload that follows a `.cb` header.
+ *
+ * @param file Stream positioned at the start of the payload.
+ * @param out Destination buffer of `bytes` bytes.
+ * @param bytes Expected uncompressed size.
+ * @param elem_size Size of one element.
+ * @param filename Name used in error messages.
+ *
+ * @throws std::runtime_error on truncated or corrupt data.
+ */
+inline void read_compressed_payload(std::istream& file, void* out, size_t bytes,
+                                    size_t elem_size, const std::string& filename) {
+    uint32_t codec = 0, shuffle = 0;
+    size_t chunk_bytes = 0, num_chunks = 0;
+    file.read(reinterpret_cast<char*>(&codec), sizeof(codec));
+    file.read(reinterpret_cast<char*>(&shuffle), sizeof(shuffle));
+    file.read(reinterpret_cast<char*>(&chunk_bytes), sizeof(size_t));
+    file.read(reinterpret_cast<char*>(&num_chunks), sizeof(size_t));
+    if (!file || chunk_bytes == 0 || codec > static_cast<uint32_t>(Codec::LZ) ||
+        aligned_chunk_bytes(chunk_bytes, elem_size) != chunk_bytes ||
+        num_chunks != (bytes + chunk_bytes - 1) / chunk_bytes)
+        throw std::runtime_error("Corrupt compression header: " + filename);
+
+    std::vector<size_t> chunk_sizes(num_chunks);
+    file.read(reinterpret_cast<char*>(chunk_sizes.data()), num_chunks * sizeof(size_t));
+    if (!file) throw std::runtime_error("Error reading dump: " + filename);
+    // A stored chunk is never larger than its raw bytes, so the payload fits in `bytes`
+    size_t total = 0;
+    for (size_t c = 0; c < num_chunks; ++c) {
+        if (chunk_sizes[c] > std::min(chunk_bytes, bytes - c * chunk_bytes))
+            throw std::runtime_error("Corrupt compression header: " + filename);
+        total += chunk_sizes[c];
+    }
+
+    std::vector<uint8_t> payload(total);
+    file.read(reinterpret_cast<char*>(payload.data()), static_cast<std::streamsize>(total));
+    if (!file) throw std::runtime_error("Error reading dump: " + filename);
+
+    try {
+        decompress_chunks(payload.data(), chunk_sizes, out, bytes, elem_size, chunk_bytes,
+                          static_cast<Codec>(codec), shuffle != 0);
+    } catch (const std::runtime_error&) {
+        throw std::runtime_error("Corrupt compressed data: " + filename);
+    }
+}
 
 /**
  * @brief Load an ndarray from a structured binary `.cb` file written by dump().
@@ -235,7 +401,8 @@ void dump(const ndarray<T>& arr, const std::string& filename)
  *  - Stored shape dimensions multiply to the stored element count
  *
  * On success, the ndarray is allocated with the correct shape and filled
- * with binary data from the file.
+ * with binary data from the file. Compressed files are detected from the
+ * header and decoded transparently.
  *
  * @tparam T Expected element type.
  * @param filename Path to the `.cb` binary file.
@@ -251,34 +418,278 @@ ndarray<T> load(const std::string& filename)
     std::ifstream file(full_filename, std::ios::binary);
     if (!file) throw std::runtime_error("Cannot open file: " + full_filename);
 
-    // Read dtype
-    DType dtype;
-    file.read(reinterpret_cast<char*>(&dtype), sizeof(DType));
-    if (dtype != dtype_from_type<T>())
+    CbHeader header = read_cb_header(file, full_filename);
+    if (header.dtype != dtype_from_type<T>())
         throw std::runtime_error("Type mismatch: " + full_filename);
 
-    // Read shape
-    size_t ndim;
-    file.read(reinterpret_cast<char*>(&ndim), sizeof(size_t));
-    Shape shape(ndim);
-    for (size_t i = 0; i < ndim; ++i)
-        file.read(reinterpret_cast<char*>(&shape[i]), sizeof(size_t));
-
-    // Read size
-    size_t size;
-    file.read(reinterpret_cast<char*>(&size), sizeof(size_t));
-    size_t expected = compute_size(shape);
-    if (size != expected)
-        throw std::runtime_error("Shape-size mismatch in: " + full_filename);
-
     // Allocate
-    ndarray<T> arr(shape);
+    ndarray<T> arr(header.shape);
+
+    if (header.compressed) {
+        read_compressed_payload(file, arr.data(), header.size * sizeof(T), sizeof(T),
+                                full_filename);
+        return arr;
+    }
 
     // Read raw data
-    file.read(reinterpret_cast<char*>(arr.data()), size * sizeof(T));
+    file.read(reinterpret_cast<char*>(arr.data()), header.size * sizeof(T));
     if (!file) throw std::runtime_error("Error reading dump: " + full_filename);
 
     return arr;
 }
 
+/**
+ * @class ChunkReader
+ * @brief Streams a `.cb` file in blocks of rows along the leading axis.
+ *
+ * Only one block of `rows_per_chunk` rows is ever resident in memory; each
+ * call to next() overwrites the same buffer and hands back a non-owning view
+ * of the rows that were read. This lets reductions and row-wise transforms
+ * run over arrays far larger than RAM.
+ *
+ * @code
+ * ChunkReader<float> reader("features.cb", 4096);
+ * ndarray<float> block;
+ * float total = 0;
+ * while (reader.next(block)) total += sum(block);
+ * @endcode
+ *
+ * @tparam T Expected element type.
+ */
+template<typename T>
+class ChunkReader {
+public:
+    /**
+     * @brief Open a `.cb` file for chunked reading.
+     *
+     * @param filename Path to the file (`.cb` is appended if missing).
+     * @param rows_per_chunk Maximum number of leading-axis rows per block.
+     *
+     * @throws std::runtime_error if the file cannot be opened, the type does
+     *         not match, the array is 0-dimensional or compressed, or
+     *         rows_per_chunk is 0.
+     */
+    ChunkReader(const std::string& filename, size_t rows_per_chunk)
+        : filename_(ensure_cb_extension(filename)), rows_per_chunk_(rows_per_chunk)
+    {
+        if (rows_per_chunk_ == 0)
+            throw std::runtime_error("ChunkReader: rows_per_chunk must be positive");
+
+        file_.open(filename_, std::ios::binary);
+        if (!file_) throw std::runtime_error("Cannot open file: " + filename_);
+
+        header_ = read_cb_header(file_, filename_);
+        if (header_.dtype != dtype_from_type<T>())
+            throw std::runtime_error("Type mismatch: " + filename_);
+        if (header_.shape.empty())
+            throw std::runtime_error("ChunkReader requires at least 1 dimension: " + filename_);
+        if (header_.compressed)
+            throw std::runtime_error("ChunkReader does not support compressed files: " + filename_);
+
+        row_shape_.assign(header_.shape.begin() + 1, header_.shape.end());
+        row_size_ = compute_size(row_shape_);
+
+        Shape buffer_shape = header_.shape;
+        buffer_shape[0] = std::min(rows_per_chunk_, header_.shape[0]);
+        buffer_ = ndarray<T>(buffer_shape);
+    }
+
+    /** @return Shape of the full stored array. */
+    const Shape& shape() const { return header_.shape; }
+
+    /** @return Number of rows along the leading axis. */
+    size_t rows() const { return header_.shape[0]; }
+
+    /** @return Index of the next row that will be returned by next(). */
+    size_t position() const { return row_; }
+
+    /**
+     * @brief Read the next block of rows.
+     *
+     * On success `chunk` becomes a view of shape `{n, shape()[1:]...}` into the
+     * reader's internal buffer, where `n <= rows_per_chunk`. The view is only
+     * valid until the next call to next(), seek() or destruction of the reader;
+     * copy it if the data must outlive that.
+     *
+     * @param chunk Receives a view of the rows that were read.
+     * @return false once all rows have been consumed.
+     *
+     * @throws std::runtime_error if the file is truncated.
+     */
+    bool next(ndarray<T>& chunk) {
+        if (row_ >= rows()) return false;
+
+        size_t n = std::min(rows_per_chunk_, rows() - row_);
+        file_.read(reinterpret_cast<char*>(buffer_.data()),
+                   static_cast<std::streamsize>(n * row_size_ * sizeof(T)));
+        if (!file_) throw std::runtime_error("Error reading chunk: " + filename_);
+        row_ += n;
+
+        Shape chunk_shape = header_.shape;
+        chunk_shape[0] = n;
+        chunk = buffer_.create_view(chunk_shape, compute_strides(chunk_shape), buffer_.data());
+        return true;
+    }
+
+    /**
+     * @brief Reposition the reader so that next() starts at the given row.
+     *
+     * @param row Leading-axis row index (`row == rows()` positions at end).
+     * @throws std::out_of_range if row > rows().
+     */
+    void seek(size_t row) {
+        if (row > rows()) throw std::out_of_range("ChunkReader: row out of range");
+        file_.clear();
+        file_.seekg(header_.data_offset +
+                    static_cast<std::streamoff>(row * row_size_ * sizeof(T)));
+        row_ = row;
+    }
+
+private:
+    std::string filename_;
+    std::ifstream file_;
+    CbHeader header_;
+    Shape row_shape_;
+    size_t row_size_ = 0;
+    size_t rows_per_chunk_;
+    size_t row_ = 0;
+    ndarray<T> buffer_;
+};
+
+/**
+ * @class ChunkWriter
+ * @brief Writes a `.cb` file incrementally, one block of rows at a time.
+ *
+ * The header is written up front with a leading dimension of zero and is
+ * patched with the final row count by close() (or the destructor). Files
+ * produced this way are indistinguishable from dump() output and can be read
+ * back with load() or ChunkReader.
+ *
+ * With `append = true` an existing file is reopened and new rows are added
+ * after the stored ones; its dtype and trailing dimensions must match.
+ *
+ * @code
+ * ChunkWriter<float> writer("features.cb", {256});
+ * for (auto& block : blocks) writer.append(block);  // each block is {n, 256}
+ * writer.close();
+ * @endcode
+ *
+ * @tparam T Element type.
+ */
+template<typename T>
+class ChunkWriter {
+public:
+    /**
+     * @brief Open a `.cb` file for chunked writing.
+     *
+     * @param filename Path to the file (`.cb` is appended if missing).
+     * @param row_shape Shape of a single row, i.e. all dimensions but the first.
+     * @param append Continue an existing file instead of truncating it.
+     *
+     * @throws std::runtime_error if the file cannot be opened, or when
+     *         appending to a file with a different dtype or row shape.
+     */
+    ChunkWriter(const std::string& filename, const Shape& row_shape, bool append = false)
+        : filename_(ensure_cb_extension(filename)), row_shape_(row_shape),
+          row_size_(compute_size(row_shape))
+    {
+        Shape shape = row_shape_;
+        shape.insert(shape.begin(), 0);
+
+        if (append) {
+            file_.open(filename_, std::ios::binary | std::ios::in | std::ios::out);
+        }
+        if (file_.is_open()) {
+            CbHeader header = read_cb_header(file_, filename_);
+            if (header.dtype != dtype_from_type<T>())
+                throw std::runtime_error("Type mismatch: " + filename_);
+            if (header.compressed)
+                throw std::runtime_error("ChunkWriter cannot append to compressed files: " + filename_);
+            if (header.shape.empty() ||
+                !std::equal(header.shape.begin() + 1, header.shape.end(),
+                            row_shape_.begin(), row_shape_.end()))
+                throw std::runtime_error("ChunkWriter: row shape mismatch in " + filename_);
+            rows_ = header.shape[0];
+            file_.seekp(0, std::ios::end);
+        } else {
+            file_.clear();
+            file_.open(filename_, std::ios::binary | std::ios::in | std::ios::out | std::ios::trunc);
+            if (!file_) throw std::runtime_error("Cannot open file for writing: " + filename_);
+            write_cb_header(file_, dtype_from_type<T>(), shape);
+        }
+        if (!file_) throw std::runtime_error("Error writing header: " + filename_);
+    }
+
+    ChunkWriter(const ChunkWriter&) = delete;
+    ChunkWriter& operator=(const ChunkWriter&) = delete;
+
+    /**
+     * @brief Finalizes the file if close() was not called explicitly.
+     *
+     * Errors are swallowed here; call close() to observe them.
+     */
+    ~ChunkWriter() {
+        try { close(); } catch (...) {}
+    }
+
+    /** @return Number of rows written so far (including pre-existing rows). */
+    size_t rows() const { return rows_; }
+
+    /**
+     * @brief Append a block of rows.
+     *
+     * Accepts either a block of shape `{n, row_shape...}` or a single row of
+     * shape `row_shape`.
+     *
+     * @param chunk Rows to write.
+     * @throws std::runtime_error on shape mismatch, write failure or after close().
+     */
+    void append(const ndarray<T>& chunk) {
+        if (!file_.is_open()) throw std::runtime_error("ChunkWriter: file already closed");
+
+        size_t n;
+        const Shape& s = chunk.shape();
+        if (s.size() == row_shape_.size() + 1 &&
+            std::equal(s.begin() + 1, s.end(), row_shape_.begin(), row_shape_.end())) {
+            n = s[0];
+        } else if (s == row_shape_) {
+            n = 1;
+        } else {
+            throw std::runtime_error("ChunkWriter: chunk shape " + shape_to_string(s) +
+                                     " does not match row shape " + shape_to_string(row_shape_));
+        }
+
+        file_.write(reinterpret_cast<const char*>(chunk.data()),
+                    static_cast<std::streamsize>(n * row_size_ * sizeof(T)));
+        if (!file_) throw std::runtime_error("Error writing chunk: " + filename_);
+        rows_ += n;
+    }
+
+    /**
+     * @brief Patch the header with the final shape and close the file.
+     *
+     * Safe to call more than once.
+     *
+     * @throws std::runtime_error if the header cannot be rewritten.
+     */
+    void close() {
+        if (!file_.is_open()) return;
+
+        Shape shape = row_shape_;
+        shape.insert(shape.begin(), rows_);
+        file_.seekp(0);
+        write_cb_header(file_, dtype_from_type<T>(), shape);
+        bool ok = static_cast<bool>(file_);
+        file_.close();
+        if (!ok) throw std::runtime_error("Error finalizing header: " + filename_);
+    }
+
+private:
+    std::string filename_;
+    std::fstream file_;
+    Shape row_shape_;
+    size_t row_size_;
+    size_t rows_ = 0;
+};
+
 } // namespace numbits
@@ -8,6 +8,9 @@
  *   - Determinant calculation (2x2 and 3x3)
  *   - Matrix inverse
  *   - Matrix trace (sum of diagonal elements)
+ *   - Iterative solvers (cg, bicgstab, gmres) for dense, sparse or
+ *     matrix-free operators, with Jacobi and incomplete Cholesky
+ *     preconditioners and parallel axpy/vdot kernels
  *
  * @namespace numbits
  */
@@ -16,12 +19,14 @@
 
 #include "ndarray.hpp"
 #include "operations.hpp"
+#include "sparse.hpp"
 #include <stdexcept>
 #include <cmath>
 #include <vector>
 #include <limits>
 #include <functional>
 #include <algorithm>
+#include <type_traits>
 
 namespace numbits {
 
@@ -42,17 +47,24 @@ ndarray<T> matmul(const ndarray<T>& a, const ndarray<T>& b) {
         throw std::runtime_error("matmul requires 2D ndarrays");
     if (a.shape()[1] != b.shape()[0])
         throw std::runtime_error("Matrix dimensions incompatible for multiplication");
+    if constexpr (is_half_v<T>) {
+        // 16-bit storage: multiply in float, round the result once
+        return matmul(a.template astype<float>(), b.template astype<float>()).template astype<T>();
+    }
 
     size_t m = a.shape()[0];
     size_t n = a.shape()[1];
     size_t p = b.shape()[1];
     ndarray<T> result(Shape{m, p});
+    auto A = a.template unchecked<2>();
+    auto B = b.template unchecked<2>();
+    auto C = result.template unchecked<2>();
 
+    // i-k-j order keeps the inner loop on contiguous rows of B and C
     for (size_t i = 0; i < m; ++i)
-        for (size_t j = 0; j < p; ++j) {
-            T sum = T{0};
-            for (size_t k = 0; k < n; ++k) sum += a.at({i,k}) * b.at({k,j});
-            result.at({i,j}) = sum;
+        for (size_t k = 0; k < n; ++k) {
+            const T aik = A(i, k);
+            for (size_t j = 0; j < p; ++j) C(i, j) += aik * B(k, j);
         }
 
     return result;
@@ -72,20 +84,26 @@ ndarray<T> matmul(const ndarray<T>& a, const ndarray<T>& b) {
  */
 template<typename T>
 ndarray<T> dot(const ndarray<T>& a, const ndarray<T>& b) {
+    if constexpr (is_half_v<T>) return dot(a.template astype<float>(), b.template astype<float>()).template astype<T>();
     if (a.ndim() == 1 && b.ndim() == 1) {
         if (a.size() != b.size()) throw std::runtime_error("Vectors must have same size");
         T sum = T{0};
-        for (size_t i = 0; i < a.size(); ++i) sum += a[i] * b[i];
+        const T* x = a.data();
+        const T* y = b.data();
+        for (size_t i = 0; i < a.size(); ++i) sum += x[i] * y[i];
         return ndarray<T>({1}, {sum});
     }
     else if (a.ndim() == 2 && b.ndim() == 2) return matmul(a,b);
     else if (a.ndim() == 2 && b.ndim() == 1) {
         if (a.shape()[1] != b.size()) throw std::runtime_error("Incompatible shapes");
         ndarray<T> res({a.shape()[0]});
+        auto A = a.template unchecked<2>();
+        auto x = b.template unchecked<1>();
+        auto y = res.template unchecked<1>();
         for (size_t i = 0; i < a.shape()[0]; ++i) {
             T sum = 0;
-            for (size_t j = 0; j < a.shape()[1]; ++j) sum += a.at({i,j})*b[j];
-            res[i] = sum;
+            for (size_t j = 0; j < a.shape()[1]; ++j) sum += A(i, j) * x(j);
+            y(i) = sum;
         }
         return res;
     } else throw std::runtime_error("Unsupported dimensions for dot");
@@ -157,8 +175,8 @@ ndarray<T> matrix_power(const ndarray<T>& A, int n) {
         throw std::runtime_error("matrix_power requires square matrix");
     size_t sz=A.shape()[0];
     ndarray<T> result(Shape{sz,sz});
-    for (size_t i=0;i<sz;++i)
-        for (size_t j=0;j<sz;++j) result.at({i,j})=(i==j)?1:0;
+    auto R = result.template unchecked<2>();
+    for (size_t i=0;i<sz;++i) R(i,i)=1;
 
     if (n==0) return result;
     ndarray<T> base = (n>0)?A:inverse(A);
@@ -184,8 +202,10 @@ ndarray<T> transpose(const ndarray<T>& arr) {
     if(arr.ndim()!=2) throw std::runtime_error("transpose only supports 2D");
     size_t m=arr.shape()[0], n=arr.shape()[1];
     ndarray<T> res(Shape{n,m});
+    auto A = arr.template unchecked<2>();
+    auto R = res.template unchecked<2>();
     for(size_t i=0;i<m;++i)
-        for(size_t j=0;j<n;++j) res.at({j,i})=arr.at({i,j});
+        for(size_t j=0;j<n;++j) R(j,i)=A(i,j);
     return res;
 }
 
@@ -204,19 +224,21 @@ T determinant(const ndarray<T>& arr) {
     if(arr.ndim()!=2 || arr.shape()[0]!=arr.shape()[1])
         throw std::runtime_error("determinant requires square matrix");
     size_t n=arr.shape()[0];
-    if(n==1) return arr.at({0,0});
-    if(n==2) return arr.at({0,0})*arr.at({1,1})-arr.at({0,1})*arr.at({1,0});
+    auto A = arr.template unchecked<2>();
+    if(n==1) return A(0,0);
+    if(n==2) return A(0,0)*A(1,1)-A(0,1)*A(1,0);
     T det=0;
     for(size_t j=0;j<n;++j) {
         ndarray<T> sub(Shape{n-1,n-1});
+        auto S = sub.template unchecked<2>();
         for(size_t i=1;i<n;++i) {
             size_t col_idx=0;
             for(size_t k=0;k<n;++k) {
-                if(k!=j) { sub.at({i-1,col_idx})=arr.at({i,k}); col_idx++; }
+                if(k!=j) { S(i-1,col_idx)=A(i,k); col_idx++; }
             }
         }
         T sign = (j%2==0)?1:-1;
-        det += sign*arr.at({0,j})*determinant(sub);
+        det += sign*A(0,j)*determinant(sub);
     }
     return det;
 }
@@ -237,23 +259,25 @@ ndarray<T> inverse(const ndarray<T>& A) {
     // Copy A to mutable matrix
     ndarray<T> mat = A;
     ndarray<T> inv(Shape{n,n});
-    for(size_t i=0;i<n;++i) for(size_t j=0;j<n;++j) inv.at({i,j})=(i==j)?1:0;
+    auto M = mat.template unchecked<2>();
+    auto I = inv.template unchecked<2>();
+    for(size_t i=0;i<n;++i) I(i,i)=1;
 
     // Gaussian elimination with partial pivoting
     for(size_t i=0;i<n;++i) {
         // Pivot
         size_t max_row=i;
-        for(size_t k=i+1;k<n;++k) if(std::abs(mat.at({k,i}))>std::abs(mat.at({max_row,i}))) max_row=k;
-        if(std::abs(mat.at({max_row,i}))<TOL) throw std::runtime_error("Matrix is singular");
+        for(size_t k=i+1;k<n;++k) if(std::abs(M(k,i))>std::abs(M(max_row,i))) max_row=k;
+        if(std::abs(M(max_row,i))<TOL) throw std::runtime_error("Matrix is singular");
         if(max_row!=i) {
-            for(size_t j=0;j<n;++j) { std::swap(mat.at({i,j}),mat.at({max_row,j})); std::swap(inv.at({i,j}),inv.at({max_row,j})); }
+            for(size_t j=0;j<n;++j) { std::swap(M(i,j),M(max_row,j)); std::swap(I(i,j),I(max_row,j)); }
         }
-        T pivot=mat.at({i,i});
-        for(size_t j=0;j<n;++j) { mat.at({i,j})/=pivot; inv.at({i,j})/=pivot; }
+        T pivot=M(i,i);
+        for(size_t j=0;j<n;++j) { M(i,j)/=pivot; I(i,j)/=pivot; }
         for(size_t k=0;k<n;++k) {
             if(k==i) continue;
-            T factor=mat.at({k,i});
-            for(size_t j=0;j<n;++j) { mat.at({k,j})-=factor*mat.at({i,j}); inv.at({k,j})-=factor*inv.at({i,j}); }
+            T factor=M(k,i);
+            for(size_t j=0;j<n;++j) { M(k,j)-=factor*M(i,j); I(k,j)-=factor*I(i,j); }
         }
     }
     return inv;
@@ -283,17 +307,15 @@ ndarray<T> lstsq(const ndarray<T>& A, const ndarray<T>& b) {
 
     // Compute pseudoinverse: A^+ = V Σ^+ U^T
     ndarray<T> Sigma_pinv(Shape{Vt.shape()[0],U.shape()[0]});
-    for(size_t i=0;i<k;++i) Sigma_pinv.at({i,i}) = (S[i]>TOL)?1/S[i]:0;
+    auto P = Sigma_pinv.template unchecked<2>();
+    for(size_t i=0;i<k;++i) P(i,i) = (S[i]>TOL)?1/S[i]:0;
     ndarray<T> Ut = transpose(U);
     ndarray<T> tmp = matmul(Sigma_pinv, Ut);
     ndarray<T> x;
     if(b.ndim()==1) {
-        ndarray<T> b_col({b.size(),1});
-        for(size_t i=0;i<b.size();++i) b_col.at({i,0})=b[i];
+        ndarray<T> b_col = b.reshape({b.size(),1});
         x = matmul(tmp,b_col);
-        ndarray<T> res({x.shape()[0]});
-        for(size_t i=0;i<x.shape()[0];++i) res[i]=x.at({i,0});
-        return res;
+        return x.reshape({x.shape()[0]});
     } else x = matmul(tmp,b);
     return x;
 }
@@ -315,33 +337,36 @@ void svd_full(const ndarray<T>& A, ndarray<T>& U, ndarray<T>& S, ndarray<T>& Vt)
     const int max_iter=100;
     size_t k = std::min(m,n);
     ndarray<T> V(Shape{n,n});
-    for(size_t i=0;i<n;++i) for(size_t j=0;j<n;++j) V.at({i,j})=(i==j)?1:0;
+    auto Vu = V.template unchecked<2>();
+    for(size_t i=0;i<n;++i) Vu(i,i)=1;
     ndarray<T> At = transpose(A);
     ndarray<T> AtA = matmul(At,A);
+    auto G = AtA.template unchecked<2>();
+    auto Au = A.template unchecked<2>();
 
     // Jacobi rotations
     for(int iter=0;iter<max_iter;++iter){
         bool conv=true;
         for(size_t p=0;p<n;++p) for(size_t q=p+1;q<n;++q){
-            T app=AtA.at({p,p}), aqq=AtA.at({q,q}), apq=AtA.at({p,q});
+            T app=G(p,p), aqq=G(q,q), apq=G(p,q);
             if(std::abs(apq)>TOL){
                 conv=false;
                 T phi=0.5*std::atan2(2*apq,aqq-app);
                 T c=std::cos(phi), s=std::sin(phi);
                 for(size_t k2=0;k2<n;++k2){
-                    T apk=AtA.at({p,k2}), aqk=AtA.at({q,k2});
-                    AtA.at({p,k2})=c*apk-s*aqk;
-                    AtA.at({q,k2})=s*apk+c*aqk;
+                    T apk=G(p,k2), aqk=G(q,k2);
+                    G(p,k2)=c*apk-s*aqk;
+                    G(q,k2)=s*apk+c*aqk;
                 }
                 for(size_t k2=0;k2<n;++k2){
-                    T akp=AtA.at({k2,p}), akq=AtA.at({k2,q});
-                    AtA.at({k2,p})=c*akp-s*akq;
-                    AtA.at({k2,q})=s*akp+c*akq;
+                    T akp=G(k2,p), akq=G(k2,q);
+                    G(k2,p)=c*akp-s*akq;
+                    G(k2,q)=s*akp+c*akq;
                 }
                 for(size_t k2=0;k2<n;++k2){
-                    T vkp=V.at({k2,p}), vkq=V.at({k2,q});
-                    V.at({k2,p})=c*vkp-s*vkq;
-                    V.at({k2,q})=s*vkp+c*vkq;
+                    T vkp=Vu(k2,p), vkq=Vu(k2,q);
+                    Vu(k2,p)=c*vkp-s*vkq;
+                    Vu(k2,q)=s*vkp+c*vkq;
                 }
             }
         }
@@ -349,34 +374,34 @@ void svd_full(const ndarray<T>& A, ndarray<T>& U, ndarray<T>& S, ndarray<T>& Vt)
     }
 
     S = ndarray<T>({k});
-    for(size_t i=0;i<k;++i) S[i]=std::sqrt(std::max(AtA.at({i,i}),T{0}));
+    for(size_t i=0;i<k;++i) S[i]=std::sqrt(std::max(G(i,i),T{0}));
 
     U=ndarray<T>(Shape{m,m});
-    for(size_t i=0;i<m;++i) for(size_t j=0;j<m;++j) U.at({i,j})=0;
+    auto Uu = U.template unchecked<2>();
 
     for(size_t j=0;j<k;++j){
         T sigma=S[j];
         if(sigma>TOL){
             for(size_t i=0;i<m;++i){
                 T sum=0;
-                for(size_t l=0;l<n;++l) sum+=A.at({i,l})*V.at({l,j});
-                U.at({i,j})=sum/sigma;
+                for(size_t l=0;l<n;++l) sum+=Au(i,l)*Vu(l,j);
+                Uu(i,j)=sum/sigma;
             }
-        } else for(size_t i=0;i<m;++i) U.at({i,j})=0;
+        } else for(size_t i=0;i<m;++i) Uu(i,j)=0;
     }
 
     // Complete U via modified Gram-Schmidt
     for(size_t j=k;j<m;++j){
-        for(size_t i=0;i<m;++i) U.at({i,j})=(i==j)?1:0;
+        for(size_t i=0;i<m;++i) Uu(i,j)=(i==j)?1:0;
         for(size_t l=0;l<j;++l){
             T dot=0;
-            for(size_t i=0;i<m;++i) dot+=U.at({i,l})*U.at({i,j});
-            for(size_t i=0;i<m;++i) U.at({i,j})-=dot*U.at({i,l});
+            for(size_t i=0;i<m;++i) dot+=Uu(i,l)*Uu(i,j);
+            for(size_t i=0;i<m;++i) Uu(i,j)-=dot*Uu(i,l);
         }
         T norm_val=0;
-        for(size_t i=0;i<m;++i) norm_val+=U.at({i,j})*U.at({i,j});
+        for(size_t i=0;i<m;++i) norm_val+=Uu(i,j)*Uu(i,j);
         norm_val=std::sqrt(norm_val);
-        if(norm_val>TOL) for(size_t i=0;i<m;++i) U.at({i,j})/=norm_val;
+        if(norm_val>TOL) for(size_t i=0;i<m;++i) Uu(i,j)/=norm_val;
     }
 
     Vt = transpose(V);
@@ -392,7 +417,8 @@ void svd_full(const ndarray<T>& A, ndarray<T>& U, ndarray<T>& S, ndarray<T>& Vt)
  */
 template<typename T> T trace(const ndarray<T>& arr){
     if(arr.ndim()!=2 || arr.shape()[0]!=arr.shape()[1]) throw std::runtime_error("trace requires square matrix");
-    T sum=0; for(size_t i=0;i<arr.shape()[0];++i) sum+=arr.at({i,i});
+    auto A = arr.template unchecked<2>();
+    T sum=0; for(size_t i=0;i<arr.shape()[0];++i) sum+=A(i,i);
     return sum;
 }
 
@@ -404,7 +430,8 @@ template<typename T> T trace(const ndarray<T>& arr){
  * @return T Norm value
  */
 template<typename T> T norm(const ndarray<T>& arr){
-    T sum=0; for(size_t i=0;i<arr.size();++i) sum+=arr[i]*arr[i];
+    const T* x = arr.data();
+    T sum=0; for(size_t i=0;i<arr.size();++i) sum+=x[i]*x[i];
     return std::sqrt(sum);
 }
 
@@ -420,7 +447,10 @@ template<typename T> T norm(const ndarray<T>& arr){
 template<typename T> ndarray<T> outer(const ndarray<T>& a,const ndarray<T>& b){
     if(a.ndim()!=1 || b.ndim()!=1) throw std::runtime_error("outer requires 1D vectors");
     ndarray<T> res(Shape{a.size(),b.size()});
-    for(size_t i=0;i<a.size();++i) for(size_t j=0;j<b.size();++j) res.at({i,j})=a[i]*b[j];
+    auto R = res.template unchecked<2>();
+    auto x = a.template unchecked<1>();
+    auto y = b.template unchecked<1>();
+    for(size_t i=0;i<a.size();++i) for(size_t j=0;j<b.size();++j) R(i,j)=x(i)*y(j);
     return res;
 }
 
@@ -437,4 +467,528 @@ template<typename T> ndarray<T> flatten(const ndarray<T>& arr){
     return res;
 }
 
+/**
+ * @brief Minimum vector length before solver kernels (axpy, vdot, dense matvec) run in parallel.
+ */
+constexpr size_t SOLVER_PARALLEL_MIN = size_t(1) << 15;
+
+/**
+ * @brief In-place `y += alpha * x` over all elements.
+ *
+ * @throws std::runtime_error If the sizes differ
+ */
+template<typename T>
+void axpy(T alpha, const ndarray<T>& x, ndarray<T>& y) {
+    if (x.size() != y.size()) throw std::runtime_error("axpy requires arrays of the same size");
+    const T* xp = x.data();
+    T* yp = y.data();
+    const index_t n = static_cast<index_t>(x.size());
+    const bool parallel = x.size() >= SOLVER_PARALLEL_MIN;
+    (void)parallel;
+#ifdef _OPENMP
+    #pragma omp parallel for simd if(parallel: parallel) schedule(static)
+#endif
+    for (index_t i = 0; i < n; ++i) yp[i] += alpha * xp[i];
+}
+
+/**
+ * @brief In-place `y = alpha * x + beta * y` over all elements.
+ *
+ * @throws std::runtime_error If the sizes differ
+ */
+template<typename T>
+void axpby(T alpha, const ndarray<T>& x, T beta, ndarray<T>& y) {
+    if (x.size() != y.size()) throw std::runtime_error("axpby requires arrays of the same size");
+    const T* xp = x.data();
+    T* yp = y.data();
+    const index_t n = static_cast<index_t>(x.size());
+    const bool parallel = x.size() >= SOLVER_PARALLEL_MIN;
+    (void)parallel;
+#ifdef _OPENMP
+    #pragma omp parallel for simd if(parallel: parallel) schedule(static)
+#endif
+    for (index_t i = 0; i < n; ++i) yp[i] = alpha * xp[i] + beta * yp[i];
+}
+
+/**
+ * @brief Inner product of two arrays viewed as flat vectors.
+ *
+ * Floating-point sums accumulate in double, so float solvers do not lose
+ * orthogonality to rounding in long reductions; float16 and bfloat16 sums
+ * accumulate in accumulator_t (float) and are rounded once at the end.
+ *
+ * @throws std::runtime_error If the sizes differ
+ */
+template<typename T>
+T vdot(const ndarray<T>& x, const ndarray<T>& y) {
+    if (x.size() != y.size()) throw std::runtime_error("vdot requires arrays of the same size");
+    using A = std::conditional_t<std::is_floating_point_v<T>, double, accumulator_t<T>>;
+    const T* xp = x.data();
+    const T* yp = y.data();
+    const index_t n = static_cast<index_t>(x.size());
+    const bool parallel = x.size() >= SOLVER_PARALLEL_MIN;
+    (void)parallel;
+    A sum = A(0);
+#ifdef _OPENMP
+    #pragma omp parallel for simd if(parallel: parallel) reduction(+:sum) schedule(static)
+#endif
+    for (index_t i = 0; i < n; ++i) sum += static_cast<A>(xp[i]) * static_cast<A>(yp[i]);
+    return static_cast<T>(sum);
+}
+
+/**
+ * @struct SolverOptions
+ * @brief Stopping criteria for the iterative solvers.
+ *
+ * A solve converges when `||b - A x|| <= max(rtol * ||b||, atol)`.
+ */
+struct SolverOptions {
+    double rtol = 1e-8;     ///< Tolerance relative to ||b||
+    double atol = 0.0;      ///< Absolute tolerance on the residual norm
+    size_t max_iter = 0;    ///< Iteration limit (0: 10 * n)
+    size_t restart = 30;    ///< Krylov subspace size between GMRES restarts
+};
+
+/**
+ * @struct SolveResult
+ * @brief Solution and convergence telemetry of an iterative solve.
+ */
+template<typename T>
+struct SolveResult {
+    ndarray<T> x;                         ///< Approximate solution
+    bool converged = false;               ///< Residual reached the tolerance
+    size_t iterations = 0;                ///< Iterations performed
+    size_t matvecs = 0;                   ///< Operator applications
+    double residual_norm = 0.0;           ///< Final ||b - A x|| (recurrence estimate)
+    std::vector<double> residual_history; ///< Residual norm before the first and after each iteration
+};
+
+/**
+ * @brief Preconditioner that applies the identity (no preconditioning).
+ */
+struct identity_preconditioner {
+    template<typename T>
+    void apply(const ndarray<T>& r, ndarray<T>& z) const { z = r; }
+};
+
+/**
+ * @class jacobi_preconditioner
+ * @brief Diagonal (Jacobi) preconditioner: `z = r / diag(A)`.
+ */
+template<typename T>
+class jacobi_preconditioner {
+public:
+    /**
+     * @brief Take the diagonal of a dense square matrix.
+     * @throws std::runtime_error If A is not square or has a zero on the diagonal
+     */
+    explicit jacobi_preconditioner(const ndarray<T>& A) {
+        if (A.ndim() != 2 || A.shape()[0] != A.shape()[1])
+            throw std::runtime_error("jacobi_preconditioner requires a square matrix");
+        auto M = A.template unchecked<2>();
+        inv_diag_.resize(A.shape()[0]);
+        for (size_t i = 0; i < inv_diag_.size(); ++i) set(i, M(i, i));
+    }
+
+    /**
+     * @brief Take the diagonal of a square sparse matrix.
+     * @throws std::runtime_error If A is not square or has a zero on the diagonal
+     */
+    template<SparseFormat Format>
+    explicit jacobi_preconditioner(const compressed_matrix<T, Format>& A) {
+        if (A.rows() != A.cols()) throw std::runtime_error("jacobi_preconditioner requires a square matrix");
+        inv_diag_.resize(A.rows());
+        for (size_t i = 0; i < inv_diag_.size(); ++i) set(i, A(i, i));
+    }
+
+    void apply(const ndarray<T>& r, ndarray<T>& z) const {
+        if (z.size() != r.size()) z = ndarray<T>(r.shape());
+        const T* rp = r.data();
+        T* zp = z.data();
+        const T* d = inv_diag_.data();
+        const index_t n = static_cast<index_t>(r.size());
+        const bool parallel = r.size() >= SOLVER_PARALLEL_MIN;
+        (void)parallel;
+#ifdef _OPENMP
+        #pragma omp parallel for simd if(parallel: parallel) schedule(static)
+#endif
+        for (index_t i = 0; i < n; ++i) zp[i] = rp[i] * d[i];
+    }
+
+private:
+    void set(size_t i, T diag) {
+        if (diag == T(0)) throw std::runtime_error("jacobi_preconditioner: zero on the diagonal");
+        inv_diag_[i] = T(1) / diag;
+    }
+
+    std::vector<T> inv_diag_;
+};
+
+/**
+ * @class ichol_preconditioner
+ * @brief Zero fill-in incomplete Cholesky preconditioner, `A ~ L L^T`.
+ *
+ * L keeps the sparsity pattern of the lower triangle of A (IC(0)); apply()
+ * runs a forward and a backward triangular solve. Meant for symmetric
+ * positive definite matrices used with cg().
+ */
+template<typename T>
+class ichol_preconditioner {
+public:
+    /**
+     * @brief Factor a symmetric sparse matrix (only its lower triangle is read).
+     * @throws std::runtime_error If A is not square or the factorization breaks down
+     *         (non-positive pivot)
+     */
+    explicit ichol_preconditioner(const csr_matrix<T>& A) {
+        if (A.rows() != A.cols()) throw std::runtime_error("ichol_preconditioner requires a square matrix");
+        const size_t n = A.rows();
+        std::vector<int64_t> indptr(n + 1, 0), indices;
+        std::vector<T> values;
+        for (size_t i = 0; i < n; ++i) {
+            for (int64_t p = A.indptr()[i]; p < A.indptr()[i + 1]; ++p) {
+                const int64_t j = A.indices()[static_cast<size_t>(p)];
+                if (static_cast<size_t>(j) > i) break;
+                indices.push_back(j);
+                values.push_back(A.data()[static_cast<size_t>(p)]);
+            }
+            if (indices.empty() || static_cast<size_t>(indices.back()) != i)
+                throw std::runtime_error("ichol_preconditioner: missing diagonal element");
+            indptr[i + 1] = static_cast<int64_t>(indices.size());
+        }
+
+        // Row-oriented IC(0): L(i,k) = (A(i,k) - sum_j<k L(i,j) L(k,j)) / L(k,k), over the pattern only
+        for (size_t i = 0; i < n; ++i) {
+            const int64_t row_begin = indptr[i], diag = indptr[i + 1] - 1;
+            for (int64_t p = row_begin; p <= diag; ++p) {
+                const size_t k = static_cast<size_t>(indices[static_cast<size_t>(p)]);
+                T sum = values[static_cast<size_t>(p)];
+                int64_t a = row_begin, b = indptr[k];
+                const int64_t b_end = indptr[k + 1] - 1;  // row k without its diagonal
+                while (a < p && b < b_end) {
+                    const int64_t ja = indices[static_cast<size_t>(a)], jb = indices[static_cast<size_t>(b)];
+                    if (ja == jb) sum -= values[static_cast<size_t>(a++)] * values[static_cast<size_t>(b++)];
+                    else if (ja < jb) ++a;
+                    else ++b;
+                }
+                if (p < diag) {
+                    values[static_cast<size_t>(p)] = sum / values[static_cast<size_t>(indptr[k + 1] - 1)];
+                } else {
+                    if (!(sum > T(0))) throw std::runtime_error("ichol_preconditioner: non-positive pivot");
+                    values[static_cast<size_t>(p)] = std::sqrt(sum);
+                }
+            }
+        }
+        L_ = csr_matrix<T>(n, n, std::move(indptr), std::move(indices), std::move(values));
+    }
+
+    /**
+     * @brief Factor a dense symmetric matrix using the pattern of its nonzeros.
+     */
+    explicit ichol_preconditioner(const ndarray<T>& A) : ichol_preconditioner(csr_matrix<T>::from_dense(A)) {}
+
+    /** @brief Solve `L L^T z = r`. */
+    void apply(const ndarray<T>& r, ndarray<T>& z) const {
+        const size_t n = L_.rows();
+        const auto& indptr = L_.indptr();
+        const auto& indices = L_.indices();
+        const auto& values = L_.data();
+        z = r;
+        T* y = z.data();
+        // Forward: L y = r (the diagonal is the last entry of each row)
+        for (size_t i = 0; i < n; ++i) {
+            T sum = y[i];
+            const int64_t diag = indptr[i + 1] - 1;
+            for (int64_t p = indptr[i]; p < diag; ++p)
+                sum -= values[static_cast<size_t>(p)] * y[indices[static_cast<size_t>(p)]];
+            y[i] = sum / values[static_cast<size_t>(diag)];
+        }
+        // Backward: L^T z = y, column-oriented over the rows of L
+        for (size_t i = n; i-- > 0;) {
+            const int64_t diag = indptr[i + 1] - 1;
+            y[i] /= values[static_cast<size_t>(diag)];
+            for (int64_t p = indptr[i]; p < diag; ++p)
+                y[indices[static_cast<size_t>(p)]] -= values[static_cast<size_t>(p)] * y[i];
+        }
+    }
+
+    /** @brief The incomplete factor L (lower triangular, CSR). */
+    const csr_matrix<T>& factor() const { return L_; }
+
+private:
+    csr_matrix<T> L_;
+};
+
+/**
+ * @brief Apply a linear operator: `y = A * x`.
+ *
+ * `A` is a dense square ndarray, a CSR/CSC matrix, or a callable
+ * `void(const ndarray<T>& x, ndarray<T>& y)` or `ndarray<T>(const ndarray<T>& x)`
+ * for matrix-free operators.
+ */
+template<typename T, typename Op>
+void apply_operator(const Op& A, const ndarray<T>& x, ndarray<T>& y) {
+    if constexpr (std::is_same_v<Op, ndarray<T>>) {
+        const size_t n = A.shape()[1];
+        if (y.size() != A.shape()[0]) y = ndarray<T>(Shape{A.shape()[0]});
+        const T* a = A.data();
+        const T* xp = x.data();
+        T* yp = y.data();
+        const index_t rows = static_cast<index_t>(A.shape()[0]);
+        const bool parallel = A.size() >= SOLVER_PARALLEL_MIN;
+        (void)parallel;
+#ifdef _OPENMP
+        #pragma omp parallel for if(parallel) schedule(static)
+#endif
+        for (index_t i = 0; i < rows; ++i) {
+            const T* row = a + static_cast<size_t>(i) * n;
+            T sum = T(0);
+            for (size_t j = 0; j < n; ++j) sum += row[j] * xp[j];
+            yp[i] = sum;
+        }
+    } else if constexpr (std::is_invocable_v<const Op&, const ndarray<T>&, ndarray<T>&>) {
+        A(x, y);
+    } else if constexpr (std::is_invocable_r_v<ndarray<T>, const Op&, const ndarray<T>&>) {
+        y = A(x);
+    } else {
+        spmv(A, x, y);
+    }
+}
+
+/**
+ * @brief Check that an operator is square and matches a right-hand side of length n.
+ */
+template<typename T, typename Op>
+void check_operator(const Op& A, const ndarray<T>& b) {
+    if (b.ndim() != 1) throw std::runtime_error("Iterative solvers require a 1D right-hand side");
+    if constexpr (std::is_same_v<Op, ndarray<T>>) {
+        if (A.ndim() != 2 || A.shape()[0] != A.shape()[1] || A.shape()[0] != b.size())
+            throw std::runtime_error("Matrix dimensions incompatible with right-hand side");
+    } else if constexpr (!std::is_invocable_v<const Op&, const ndarray<T>&, ndarray<T>&> &&
+                         !std::is_invocable_r_v<ndarray<T>, const Op&, const ndarray<T>&>) {
+        if (A.rows() != A.cols() || A.rows() != b.size())
+            throw std::runtime_error("Matrix dimensions incompatible with right-hand side");
+    }
+}
+
+/**
+ * @brief Shared setup of the iterative solvers: initial guess, residual and tolerance.
+ *
+ * @return Residual tolerance max(rtol * ||b||, atol)
+ */
+template<typename T, typename Op>
+double init_solve(const Op& A, const ndarray<T>& b, const ndarray<T>& x0, const SolverOptions& options,
+                  SolveResult<T>& result, ndarray<T>& r) {
+    static_assert(std::is_floating_point_v<T>, "Iterative solvers require float or double");
+    check_operator(A, b);
+    if (x0.size() == 0) {
+        result.x = ndarray<T>(Shape{b.size()});
+        r = b;
+    } else {
+        if (x0.ndim() != 1 || x0.size() != b.size()) throw std::runtime_error("Initial guess must match b");
+        result.x = x0;
+        apply_operator(A, result.x, r);
+        ++result.matvecs;
+        axpby(T(1), b, T(-1), r);
+    }
+    result.residual_norm = std::sqrt(static_cast<double>(vdot(r, r)));
+    result.residual_history.push_back(result.residual_norm);
+    const double tol = std::max(options.rtol * std::sqrt(static_cast<double>(vdot(b, b))), options.atol);
+    result.converged = result.residual_norm <= tol;
+    return tol;
+}
+
+/**
+ * @brief Record the residual of a finished iteration; returns true once converged.
+ */
+template<typename T>
+bool record_iteration(SolveResult<T>& result, double residual_norm, double tol) {
+    ++result.iterations;
+    result.residual_norm = residual_norm;
+    result.residual_history.push_back(residual_norm);
+    result.converged = residual_norm <= tol;
+    return result.converged;
+}
+
+/**
+ * @brief Preconditioned conjugate gradient for symmetric positive definite systems.
+ *
+ * @code
+ * auto A = csr_matrix<double>::from_dense(K);
+ * auto res = cg(A, b, SolverOptions{1e-10}, ichol_preconditioner<double>(A));
+ * if (res.converged) use(res.x);
+ * @endcode
+ *
+ * @param A Operator: dense or sparse matrix, or matvec callable (see apply_operator())
+ * @param b Right-hand side (1D)
+ * @param options Tolerances and iteration limit
+ * @param M Preconditioner with `apply(r, z)` approximating `z = A^-1 r` (SPD)
+ * @param x0 Initial guess (empty: zero)
+ * @return Solution and convergence telemetry; not converging is not an error
+ * @throws std::runtime_error If the shapes are incompatible
+ */
+template<typename T, typename Op, typename Precond = identity_preconditioner>
+SolveResult<T> cg(const Op& A, const ndarray<T>& b, const SolverOptions& options = SolverOptions(),
+                  const Precond& M = Precond(), const ndarray<T>& x0 = ndarray<T>()) {
+    SolveResult<T> result;
+    ndarray<T> r;
+    const double tol = init_solve(A, b, x0, options, result, r);
+    const size_t max_iter = options.max_iter ? options.max_iter : 10 * b.size();
+
+    ndarray<T> z, Ap;
+    M.apply(r, z);
+    ndarray<T> p = z;
+    T rz = vdot(r, z);
+    while (!result.converged && result.iterations < max_iter) {
+        apply_operator(A, p, Ap);
+        ++result.matvecs;
+        const T pAp = vdot(p, Ap);
+        if (pAp == T(0)) break;  // breakdown: p is A-orthogonal to itself
+        const T alpha = rz / pAp;
+        axpy(alpha, p, result.x);
+        axpy(-alpha, Ap, r);
+        if (record_iteration(result, std::sqrt(static_cast<double>(vdot(r, r))), tol)) break;
+        M.apply(r, z);
+        const T rz_next = vdot(r, z);
+        axpby(T(1), z, rz_next / rz, p);
+        rz = rz_next;
+    }
+    return result;
+}
+
+/**
+ * @brief Right-preconditioned BiCGSTAB for general (non-symmetric) systems.
+ *
+ * Same parameters as cg(); M may be any approximate inverse of A.
+ */
+template<typename T, typename Op, typename Precond = identity_preconditioner>
+SolveResult<T> bicgstab(const Op& A, const ndarray<T>& b, const SolverOptions& options = SolverOptions(),
+                        const Precond& M = Precond(), const ndarray<T>& x0 = ndarray<T>()) {
+    SolveResult<T> result;
+    ndarray<T> r;
+    const double tol = init_solve(A, b, x0, options, result, r);
+    const size_t max_iter = options.max_iter ? options.max_iter : 10 * b.size();
+
+    const ndarray<T> r_hat = r;
+    ndarray<T> p(Shape{b.size()}), v(Shape{b.size()}), p_hat, s_hat, t;
+    T rho = 1, alpha = 1, omega = 1;
+    while (!result.converged && result.iterations < max_iter) {
+        const T rho_next = vdot(r_hat, r);
+        if (rho_next == T(0) || omega == T(0)) break;  // breakdown
+        const T beta = (rho_next / rho) * (alpha / omega);
+        axpy(-omega, v, p);
+        axpby(T(1), r, beta, p);  // p = r + beta (p - omega v)
+        rho = rho_next;
+
+        M.apply(p, p_hat);
+        apply_operator(A, p_hat, v);
+        ++result.matvecs;
+        const T r_hat_v = vdot(r_hat, v);
+        if (r_hat_v == T(0)) break;
+        alpha = rho / r_hat_v;
+        axpy(-alpha, v, r);  // r now holds s = r - alpha v
+        axpy(alpha, p_hat, result.x);
+        const double s_norm = std::sqrt(static_cast<double>(vdot(r, r)));
+        if (s_norm <= tol) {
+            record_iteration(result, s_norm, tol);
+            break;
+        }
+
+        M.apply(r, s_hat);
+        apply_operator(A, s_hat, t);
+        ++result.matvecs;
+        const T tt = vdot(t, t);
+        omega = tt == T(0) ? T(0) : vdot(t, r) / tt;
+        axpy(omega, s_hat, result.x);
+        axpy(-omega, t, r);
+        record_iteration(result, std::sqrt(static_cast<double>(vdot(r, r))), tol);
+    }
+    return result;
+}
+
+/**
+ * @brief Restarted GMRES(m) with right preconditioning for general systems.
+ *
+ * Builds a Krylov basis of up to `options.restart` vectors with modified
+ * Gram-Schmidt and solves the small least-squares problem with Givens
+ * rotations, so the residual norm is known at every iteration without
+ * forming x. Same parameters as cg().
+ */
+template<typename T, typename Op, typename Precond = identity_preconditioner>
+SolveResult<T> gmres(const Op& A, const ndarray<T>& b, const SolverOptions& options = SolverOptions(),
+                     const Precond& M = Precond(), const ndarray<T>& x0 = ndarray<T>()) {
+    SolveResult<T> result;
+    ndarray<T> r;
+    const double tol = init_solve(A, b, x0, options, result, r);
+    const size_t max_iter = options.max_iter ? options.max_iter : 10 * b.size();
+    const size_t m = std::max<size_t>(1, std::min(options.restart, b.size()));
+
+    std::vector<ndarray<T>> V(m + 1);
+    std::vector<double> H((m + 1) * m), cs(m), sn(m), g(m + 1), y(m);
+    ndarray<T> z, w, update(Shape{b.size()});
+    bool first = true;
+    while (!result.converged && result.iterations < max_iter) {
+        if (!first) {
+            apply_operator(A, result.x, r);
+            ++result.matvecs;
+            axpby(T(1), b, T(-1), r);
+        }
+        first = false;
+        const double beta = std::sqrt(static_cast<double>(vdot(r, r)));
+        if (beta == 0.0) break;
+        V[0] = r;
+        for (auto& v : V[0]) v = static_cast<T>(v / beta);
+        std::fill(g.begin(), g.end(), 0.0);
+        g[0] = beta;
+
+        size_t k = 0;  // basis vectors used in this cycle
+        while (k < m && result.iterations < max_iter) {
+            M.apply(V[k], z);
+            apply_operator(A, z, w);
+            ++result.matvecs;
+            for (size_t i = 0; i <= k; ++i) {
+                const T h = vdot(w, V[i]);
+                H[i * m + k] = static_cast<double>(h);
+                axpy(-h, V[i], w);
+            }
+            const double h_next = std::sqrt(static_cast<double>(vdot(w, w)));
+            H[(k + 1) * m + k] = h_next;
+            if (h_next != 0.0) {
+                V[k + 1] = w;
+                for (auto& v : V[k + 1]) v = static_cast<T>(v / h_next);
+            }
+
+            // Apply the previous rotations to the new column, then eliminate H(k+1, k)
+            for (size_t i = 0; i < k; ++i) {
+                const double a = H[i * m + k], c = H[(i + 1) * m + k];
+                H[i * m + k] = cs[i] * a + sn[i] * c;
+                H[(i + 1) * m + k] = -sn[i] * a + cs[i] * c;
+            }
+            const double a = H[k * m + k], c = H[(k + 1) * m + k];
+            const double d = std::hypot(a, c);
+            cs[k] = d == 0.0 ? 1.0 : a / d;
+            sn[k] = d == 0.0 ? 0.0 : c / d;
+            H[k * m + k] = d;
+            H[(k + 1) * m + k] = 0.0;
+            g[k + 1] = -sn[k] * g[k];
+            g[k] = cs[k] * g[k];
+            ++k;
+            if (record_iteration(result, std::fabs(g[k]), tol) || h_next == 0.0) break;
+        }
+
+        // x += M^-1 (V y) with H y = g (upper triangular, k x k)
+        for (size_t i = k; i-- > 0;) {
+            double sum = g[i];
+            for (size_t j = i + 1; j < k; ++j) sum -= H[i * m + j] * y[j];
+            y[i] = H[i * m + i] == 0.0 ? 0.0 : sum / H[i * m + i];
+        }
+        update.fill(T(0));
+        for (size_t i = 0; i < k; ++i) axpy(static_cast<T>(y[i]), V[i], update);
+        M.apply(update, z);
+        axpy(T(1), z, result.x);
+        if (k > 0 && H[(k - 1) * m + (k - 1)] == 0.0) break;  // singular Hessenberg: no further progress
+    }
+    return result;
+}
+
 } // namespace numbits
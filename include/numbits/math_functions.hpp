@@ -8,6 +8,7 @@
  *   - Power and root functions (pow, sqrt, cbrt)
  *   - Rounding functions (ceil, floor, round)
  *   - Sign and absolute value functions
+ *   - Piecewise-linear interpolation (interp)
  *
  * @namespace numbits
  */
@@ -15,6 +16,7 @@
 #pragma once
 
 #include "ndarray.hpp"
+#include "sorting.hpp"
 #include <cmath>
 #include <algorithm>
 #include <numeric>
@@ -81,6 +83,11 @@ ndarray<T> mclip(const ndarray<T>& arr, T min_val, T max_val) {
  * @brief 1D linear interpolation.
  * For each x[i], computes corresponding interpolated value using xp and fp arrays.
  * xp must be sorted in ascending order.
+ *
+ * Intervals are located with searchsorted()'s binary search (galloping
+ * forward when `x` is sorted) and the query points are evaluated in
+ * parallel. Points left of xp[0] map to fp[0], points right of the last
+ * sample to its value, and NaN maps to NaN.
  */
 template<typename T>
 ndarray<T> interp(const ndarray<T>& x, const ndarray<T>& xp, const ndarray<T>& fp) {
@@ -90,28 +97,26 @@ ndarray<T> interp(const ndarray<T>& x, const ndarray<T>& xp, const ndarray<T>& f
         throw std::runtime_error("interp: xp and fp must contain at least 2 points");
 
     ndarray<T> result(x.shape());
-    for (size_t i = 0; i < x.size(); ++i) {
-        T xi = x[i];
-
-        // Handle out-of-bounds
-        if (xi <= xp[0]) {
-            result[i] = fp[0];
-            continue;
-        }
-        if (xi >= xp[xp.size() - 1]) {
-            result[i] = fp[fp.size() - 1];
-            continue;
+    const T* px = xp.data();
+    const T* pf = fp.data();
+    const T* in = x.data();
+    T* out = result.data();
+    const size_t n = xp.size();
+    search_each<true>(px, n, in, x.size(), [=](size_t i, size_t pos) {
+        // pos is the number of samples <= x[i]
+        const T xi = in[i];
+        if (is_nan_value(xi)) {
+            out[i] = xi;
+        } else if (pos == 0) {
+            out[i] = pf[0];
+        } else if (pos == n) {
+            out[i] = pf[n - 1];
+        } else {
+            T x0 = px[pos - 1], x1 = px[pos];
+            T y0 = pf[pos - 1], y1 = pf[pos];
+            out[i] = y0 + (y1 - y0) * (xi - x0) / (x1 - x0);
         }
-
-        // Find interval
-        size_t j = 0;
-        while (xi > xp[j + 1]) ++j;
-
-        // Linear interpolation
-        T x0 = xp[j], x1 = xp[j + 1];
-        T y0 = fp[j], y1 = fp[j + 1];
-        result[i] = y0 + (y1 - y0) * (xi - x0) / (x1 - x0);
-    }
+    });
     return result;
 }
 
@@ -11,8 +11,11 @@
  *   - Efficient memory management (copy, move, ownership control)
  *   - Row-major (C-style) memory layout with explicit strides
  *   - Element access via flat indexing or multi-index access
+ *   - Allocation-free variadic access `arr(i, j, ...)` and an unchecked
+ *     fixed-rank accessor for hot loops (`arr.unchecked<2>()`)
  *   - Array creation helpers (zeros, ones, full)
  *   - Shape manipulation (reshape, flatten)
+ *   - Element type conversion (astype)
  *   - STL-compatible iterators
  *   - Pretty printing with recursive formatting
  *
@@ -31,6 +34,7 @@
 
 #include "types.hpp"
 #include "utils.hpp"
+#include "cast.hpp"
 #include <memory>
 #include <vector>
 #include <initializer_list>
@@ -40,9 +44,92 @@
 #include <iostream>
 #include <string>
 #include <type_traits>
+#include <array>
+
+/**
+ * @brief Bounds checks for unchecked accessors.
+ *
+ * Define NUMBITS_DEBUG_BOUNDS before including NumBits (or pass
+ * -DNUMBITS_DEBUG_BOUNDS) to make unchecked_accessor validate every index and
+ * throw std::out_of_range. Without it the checks compile to nothing.
+ */
+#ifdef NUMBITS_DEBUG_BOUNDS
+#define NUMBITS_BOUNDS_CHECK(cond) \
+    ((cond) ? (void)0 : throw std::out_of_range("Index out of range"))
+#else
+#define NUMBITS_BOUNDS_CHECK(cond) ((void)0)
+#endif
 
 namespace numbits {
 
+/**
+ * @class unchecked_accessor
+ * @brief Fixed-rank element accessor without bounds checks.
+ *
+ * Obtained from ndarray::unchecked<N>(). The rank is part of the type and the
+ * strides are copied into the proxy, so `acc(i, j)` compiles to a couple of
+ * multiply-adds that stay in registers inside hot loops. Index checks are
+ * performed only when NUMBITS_DEBUG_BOUNDS is defined.
+ *
+ * The accessor does not own the data; it is invalidated when the array is
+ * destroyed or reassigned.
+ *
+ * @code
+ * auto A = a.unchecked<2>();
+ * for (size_t i = 0; i < A.shape(0); ++i)
+ *     for (size_t j = 0; j < A.shape(1); ++j) A(i, j) *= 2;
+ * @endcode
+ *
+ * @tparam T Element type (const-qualified for read-only access).
+ * @tparam N Number of dimensions.
+ */
+template<typename T, size_t N>
+class unchecked_accessor {
+public:
+    unchecked_accessor(T* data, const Shape& shape, const Strides& strides, size_t size)
+        : data_(data), size_(size) {
+        for (size_t i = 0; i < N; ++i) {
+            shape_[i] = shape[i];
+            strides_[i] = strides[i];
+        }
+    }
+
+    /** @return Number of dimensions. */
+    static constexpr size_t ndim() { return N; }
+
+    /** @return Extent of dimension `dim`. */
+    size_t shape(size_t dim) const { return shape_[dim]; }
+
+    /** @return Total number of elements. */
+    size_t size() const { return size_; }
+
+    /** @return Raw data pointer. */
+    T* data() const { return data_; }
+
+    /** @brief Flat element access. */
+    T& operator[](size_t index) const {
+        NUMBITS_BOUNDS_CHECK(index < size_);
+        return data_[index];
+    }
+
+    /** @brief Multi-index element access; takes exactly N indices. */
+    template<typename... Idx>
+    T& operator()(Idx... idx) const {
+        static_assert(sizeof...(Idx) == N, "Number of indices does not match dimensions");
+        size_t flat = 0;
+        size_t dim = 0;
+        ((NUMBITS_BOUNDS_CHECK(static_cast<size_t>(idx) < shape_[dim]),
+          flat += static_cast<size_t>(idx) * strides_[dim], ++dim), ...);
+        return data_[flat];
+    }
+
+private:
+    T* data_;
+    std::array<size_t, N> shape_;
+    std::array<size_t, N> strides_;
+    size_t size_;
+};
+
 /**
  * @class ndarray
  * @brief N-dimensional array container for numerical computations.
@@ -69,9 +156,14 @@ public:
      *
      * Equivalent to creating an array of shape `{data.size()}`.
      *
+     * Only participates in overload resolution when the list elements are
+     * exactly `T`, so `ndarray<float>({2, 3})` still selects the shape
+     * constructor instead of building a two-element vector.
+     *
      * @param data Values used to initialize the array.
      */
-    ndarray(std::initializer_list<T> data) : ndarray(Shape{data.size()}, data) {}
+    template<typename U, typename = std::enable_if_t<std::is_same_v<U, T>>>
+    ndarray(std::initializer_list<U> data) : ndarray(Shape{data.size()}, std::vector<T>(data)) {}
 
     /**
      * @brief Default constructor. Creates an empty array.
@@ -272,7 +364,7 @@ public:
      * @throws std::runtime_error For incorrect number of indices.
      * @throws std::out_of_range For bounds violations.
      */
-    T& at(const std::vector<size_t>& indices) {
+    T& at(const Indices& indices) {
         if (indices.size() != shape_.size())
             throw std::runtime_error("Number of indices does not match dimensions");
         for (size_t i = 0; i < indices.size(); ++i)
@@ -284,7 +376,7 @@ public:
     /**
      * @brief Const version of at().
      */
-    const T& at(const std::vector<size_t>& indices) const {
+    const T& at(const Indices& indices) const {
         if (indices.size() != shape_.size())
             throw std::runtime_error("Number of indices does not match dimensions");
         for (size_t i = 0; i < indices.size(); ++i)
@@ -293,6 +385,54 @@ public:
         return data_[flatten_index(indices, strides_)];
     }
 
+    /**
+     * @brief Variadic multi-index access, `arr(i, j, ...)`.
+     *
+     * Bounds-checked like at(), but the indices are passed directly so no
+     * index container is built.
+     *
+     * @throws std::runtime_error For incorrect number of indices.
+     * @throws std::out_of_range For bounds violations.
+     */
+    template<typename... Idx,
+             typename = std::enable_if_t<(std::is_integral_v<Idx> && ...)>>
+    T& operator()(Idx... idx) {
+        return data_[checked_offset(idx...)];
+    }
+
+    /**
+     * @brief Const version of operator()().
+     */
+    template<typename... Idx,
+             typename = std::enable_if_t<(std::is_integral_v<Idx> && ...)>>
+    const T& operator()(Idx... idx) const {
+        return data_[checked_offset(idx...)];
+    }
+
+    /**
+     * @brief Fixed-rank accessor without per-access bounds checks.
+     *
+     * Only the rank is validated, once, here. Inside templates call it as
+     * `arr.template unchecked<N>()`.
+     *
+     * @tparam N Expected number of dimensions.
+     * @throws std::runtime_error If ndim() != N.
+     */
+    template<size_t N>
+    unchecked_accessor<T, N> unchecked() {
+        if (ndim() != N) throw std::runtime_error("unchecked: rank does not match dimensions");
+        return unchecked_accessor<T, N>(data_, shape_, strides_, size_);
+    }
+
+    /**
+     * @brief Read-only fixed-rank accessor without per-access bounds checks.
+     */
+    template<size_t N>
+    unchecked_accessor<const T, N> unchecked() const {
+        if (ndim() != N) throw std::runtime_error("unchecked: rank does not match dimensions");
+        return unchecked_accessor<const T, N>(data_, shape_, strides_, size_);
+    }
+
     // Iterators
 
     /** @return Iterator to beginning. */
@@ -408,6 +548,40 @@ public:
         return reshape({size_});
     }
 
+    // Type Conversion
+
+    /**
+     * @brief Copy of the array with elements converted to U.
+     *
+     * @code
+     * auto pixels = image.astype<float>();
+     * auto bytes = values.astype<uint8_t>({true, true});  // saturate, round
+     * @endcode
+     *
+     * @param options Saturation and rounding; see CastOptions and cast.hpp.
+     */
+    template<typename U>
+    ndarray<U> astype(CastOptions options = CastOptions()) const {
+        ndarray<U> result(shape_);
+        convert_n(data_, result.data(), size_, options);
+        return result;
+    }
+
+    /**
+     * @brief Copy of the array converted to U as `x * scale + offset`, in one pass.
+     *
+     * @code
+     * auto normalized = image.astype<float>(1.0 / 255.0, 0.0);
+     * auto restored = normalized.astype<uint8_t>(255.0, 0.0, {true, true});
+     * @endcode
+     */
+    template<typename U>
+    ndarray<U> astype(double scale, double offset, CastOptions options = CastOptions()) const {
+        ndarray<U> result(shape_);
+        convert_scaled_n(data_, result.data(), size_, scale, offset, options);
+        return result;
+    }
+
     // Miscellaneous Ops
 
     /**
@@ -438,6 +612,23 @@ public:
 
 private:
 
+    /**
+     * @brief Flat offset of a multi-index, validating count and bounds.
+     */
+    template<typename... Idx>
+    size_t checked_offset(Idx... idx) const {
+        if (sizeof...(Idx) != shape_.size())
+            throw std::runtime_error("Number of indices does not match dimensions");
+        size_t flat = 0;
+        size_t dim = 0;
+        auto step = [&](size_t i) {
+            if (i >= shape_[dim]) throw std::out_of_range("Index out of range");
+            flat += i * strides_[dim++];
+        };
+        (step(static_cast<size_t>(idx)), ...);
+        return flat;
+    }
+
     /**
      * @brief Recursive pretty-printer helper.
      */
@@ -86,10 +86,10 @@ ndarray<T> concatenate(const std::vector<ndarray<T>>& ndarrays, size_t axis = 0)
         // Copy each element
         for (size_t i = 0; i < arr.size(); ++i) {
             // Calculate position in source ndarray
-            std::vector<size_t> src_indices = unravel_index(i, arr.shape(), arr.strides());
+            Indices src_indices = unravel_index(i, arr.shape(), arr.strides());
             
             // Calculate position in result ndarray (adjust axis)
-            std::vector<size_t> dst_indices = src_indices;
+            Indices dst_indices = src_indices;
             dst_indices[axis] += result_offset;
             
             // Copy element
@@ -158,10 +158,10 @@ ndarray<T> stack(const std::vector<ndarray<T>>& ndarrays, size_t axis = 0) {
         const auto& arr = ndarrays[arr_idx];
         for (size_t i = 0; i < elements_per_ndarray; ++i) {
             // Get indices in source ndarray
-            std::vector<size_t> src_indices = unravel_index(i, arr.shape(), arr.strides());
+            Indices src_indices = unravel_index(i, arr.shape(), arr.strides());
             
             // Insert new axis index
-            std::vector<size_t> dst_indices = src_indices;
+            Indices dst_indices = src_indices;
             dst_indices.insert(dst_indices.begin() + axis, arr_idx);
             
             // Calculate destination index
@@ -221,10 +221,10 @@ std::vector<ndarray<T>> split(const ndarray<T>& arr, size_t axis, const std::vec
         
         for (size_t j = 0; j < copy_size; ++j) {
             // Get indices in result ndarray
-            std::vector<size_t> dst_indices = unravel_index(j, result_shape, result_strides);
+            Indices dst_indices = unravel_index(j, result_shape, result_strides);
             
             // Calculate corresponding indices in source ndarray
-            std::vector<size_t> src_indices = dst_indices;
+            Indices src_indices = dst_indices;
             src_indices[axis] += start;
             
             // Copy element
@@ -273,10 +273,10 @@ ndarray<T> repeat(const ndarray<T>& arr, size_t repeats, size_t axis = 0) {
     for (size_t r = 0; r < repeats; ++r) {
         for (size_t i = 0; i < arr.size(); ++i) {
             // Get source indices
-            std::vector<size_t> src_indices = unravel_index(i, arr.shape(), arr.strides());
+            Indices src_indices = unravel_index(i, arr.shape(), arr.strides());
             
             // Calculate destination indices (offset along axis)
-            std::vector<size_t> dst_indices = src_indices;
+            Indices dst_indices = src_indices;
             dst_indices[axis] = src_indices[axis] + r * axis_size;
             
             // Copy element
@@ -322,8 +322,8 @@ ndarray<T> tile(const ndarray<T>& arr, const std::vector<size_t>& reps) {
     ndarray<T> result(result_shape);
     
     for (size_t i = 0; i < result.size(); ++i) {
-        std::vector<size_t> result_indices = unravel_index(i, result_shape, result.strides());
-        std::vector<size_t> arr_indices = result_indices;
+        Indices result_indices = unravel_index(i, result_shape, result.strides());
+        Indices arr_indices = result_indices;
         for (size_t j = 0; j < arr_indices.size(); ++j) {
             arr_indices[j] %= arr.shape()[j];
         }
@@ -3,16 +3,25 @@
  * @brief Main header file for NumBits library.
  *
  * This is the primary include file that brings in all NumBits functionality:
- *   - Core ndarray class and types
+ *   - Core ndarray class and types, including float16/bfloat16 storage
+ *   - Element type conversion (astype, runtime-dtype cast)
+ *   - Type-erased arrays with a runtime dtype (array, load_any)
  *   - Element-wise and reduction operations
  *   - Broadcasting utilities
  *   - Mathematical functions
  *   - Linear algebra operations
+ *   - Fixed-size arrays for tiny matrices (static_ndarray)
+ *   - Sparse matrices (CSR, CSC, COO) with SpMV and SpMM
  *   - Array manipulation (concatenate, stack, split, tile)
  *   - Array creation utilities (arange, linspace, eye)
  *   - Advanced indexing and slicing
+ *   - Sorting, partitioning and top-k selection
+ *   - Quantiles, histograms and bincount
+ *   - Fused softmax, activations and normalizations
+ *   - Int8 quantization and quantized matrix multiplication
  *   - Random number generation
  *   - File I/O (text and binary)
+ *   - Asynchronous prefetching loader
  *
  * @example
  * @code
@@ -44,16 +53,27 @@
 
 #include "numbits/ndarray.hpp"
 #include "numbits/types.hpp"
+#include "numbits/cast.hpp"
 #include "numbits/utils.hpp"
 #include "numbits/operations.hpp"
 #include "numbits/broadcasting.hpp"
+#include "numbits/bitmask.hpp"
 #include "numbits/math_functions.hpp"
 #include "numbits/linear_algebra.hpp"
+#include "numbits/static_ndarray.hpp"
+#include "numbits/sparse.hpp"
 #include "numbits/ndarray_manipulation.hpp"
 #include "numbits/creation.hpp"
+#include "numbits/strided_view.hpp"
 #include "numbits/indexing.hpp"
+#include "numbits/sorting.hpp"
+#include "numbits/statistics.hpp"
+#include "numbits/activations.hpp"
+#include "numbits/quantization.hpp"
 #include "numbits/random.hpp"
 #include "numbits/io.hpp"
+#include "numbits/async_io.hpp"
+#include "numbits/array.hpp"
 
 // Convenience namespace
 namespace nb = numbits;
@@ -6,7 +6,7 @@
  *  - Element-wise arithmetic (add, subtract, multiply, divide)
  *  - Scalar arithmetic (add_scalar, multiply_scalar, etc.)
  *  - Reduction operations (sum, mean, min, max, all, any)
- *  - Cumulative operations (cumsum, cumprod)
+ *  - Cumulative operations (cumsum, cumprod, cummax, cummin), flat or along an axis
  *  - Comparison operations (equal, not_equal, less, greater, etc.)
  *  - Logical operations (logical_and, logical_or, logical_xor, logical_not)
  *  - Advanced operations (clip, argmax, argmin)
@@ -24,6 +24,12 @@
 #include <algorithm>
 #include <numeric>
 #include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 namespace numbits {
 
@@ -416,10 +422,13 @@ ndarray<bool> greater_equal(const ndarray<T>& a, const ndarray<T>& b) {
 
 /**
  * @brief Computes sum of all elements in ndarray.
+ *
+ * float16 and bfloat16 elements are accumulated in float and rounded once.
  */
 template<typename T>
 T sum(const ndarray<T>& arr) {
-    return std::accumulate(arr.begin(), arr.end(), T{0});
+    using A = accumulator_t<T>;
+    return static_cast<T>(std::accumulate(arr.begin(), arr.end(), A{0}));
 }
 
 /**
@@ -428,7 +437,8 @@ T sum(const ndarray<T>& arr) {
 template<typename T>
 T mean(const ndarray<T>& arr) {
     if (arr.size() == 0) return T{0};
-    return sum(arr) / static_cast<T>(arr.size());
+    using A = accumulator_t<T>;
+    return static_cast<T>(std::accumulate(arr.begin(), arr.end(), A{0}) / static_cast<A>(arr.size()));
 }
 
 /**
@@ -469,29 +479,262 @@ bool any(const ndarray<T>& arr) {
                        [](const T& value) { return static_cast<bool>(value); });
 }
 
+// Cumulative scans: cumsum, cumprod, cummax, cummin
+// Each runs over the flattened array or along an axis; sums and products
+// optionally accumulate in a wider type (e.g. cumsum<double>(float_array)).
+
 /**
- * @brief Computes cumulative sum of ndarray elements.
+ * @brief Minimum 1D length for the two-pass multithreaded scan.
  */
-template<typename T>
-ndarray<T> cumsum(const ndarray<T>& arr) {
-    ndarray<T> result(arr.shape());
-    if (arr.size() == 0) return result;
-    std::partial_sum(arr.begin(), arr.end(), result.begin());
+constexpr size_t PARALLEL_SCAN_MIN = size_t(1) << 16;
+
+/**
+ * @brief Minimum number of output bytes before scans are split across threads.
+ */
+constexpr size_t PARALLEL_SCAN_BYTES = size_t(1) << 16;
+
+/**
+ * @brief Columns per work item when scanning along a non-innermost axis.
+ */
+constexpr size_t SCAN_COLUMNS = 1024;
+
+/**
+ * @brief Result type of a scan: `Acc` if given, otherwise the element type.
+ */
+template<typename Acc, typename T>
+using scan_result_t = std::conditional_t<std::is_void_v<Acc>, T, Acc>;
+
+/// Scan operator of cumsum.
+struct ScanSum {
+    template<typename A> A operator()(A a, A b) const { return a + b; }
+};
+
+/// Scan operator of cumprod.
+struct ScanProd {
+    template<typename A> A operator()(A a, A b) const { return a * b; }
+};
+
+/// Scan operator of cummax; NaN propagates as in NumPy.
+struct ScanMax {
+    template<typename A> A operator()(A a, A b) const { return (a > b || a != a) ? a : b; }
+};
+
+/// Scan operator of cummin; NaN propagates as in NumPy.
+struct ScanMin {
+    template<typename A> A operator()(A a, A b) const { return (a < b || a != a) ? a : b; }
+};
+
+/**
+ * @brief Reduce `n > 0` contiguous elements with `op`.
+ */
+template<typename A, typename T, typename Op>
+A reduce_run(const T* in, size_t n, Op op) {
+    A acc = static_cast<A>(in[0]);
+    for (size_t i = 1; i < n; ++i) acc = op(acc, static_cast<A>(in[i]));
+    return acc;
+}
+
+/**
+ * @brief Inclusive scan of `n` contiguous elements, continuing from `carry` if `has_carry`.
+ */
+template<typename A, typename T, typename Op>
+void scan_run(const T* in, A* out, size_t n, Op op, bool has_carry, A carry) {
+    size_t i = 0;
+    if (!has_carry) {
+        if (n == 0) return;
+        carry = static_cast<A>(in[0]);
+        out[0] = carry;
+        i = 1;
+    }
+    for (; i < n; ++i) {
+        carry = op(carry, static_cast<A>(in[i]));
+        out[i] = carry;
+    }
+}
+
+/**
+ * @brief Inclusive scan along the middle extent of an `{outer, len, inner}` view.
+ *
+ * - One long lane: two passes over one chunk per thread. The first
+ *   reduces every chunk, the chunk totals are scanned serially, and the
+ *   second scans every chunk starting from its predecessor's total.
+ * - Contiguous lanes (`inner == 1`): lanes are scanned in parallel with scan_run().
+ * - Strided lanes: whole rows of `inner` elements are combined with the
+ *   previous row, a loop that vectorizes across columns.
+ */
+template<typename A, typename T, typename Op>
+ndarray<A> scan_axis(const ndarray<T>& arr, size_t outer, size_t len, size_t inner, Op op) {
+    ndarray<A> result(arr.shape());
+    if (result.size() == 0) return result;
+    const T* in = arr.data();
+    A* out = result.data();
+    const bool parallel = arr.size() * sizeof(A) >= PARALLEL_SCAN_BYTES;
+    (void)parallel;
+
+    if (inner == 1 && outer == 1) {
+        size_t chunks = 1;
+#ifdef _OPENMP
+        chunks = static_cast<size_t>(omp_get_max_threads());
+#endif
+        if (chunks <= 1 || len < PARALLEL_SCAN_MIN) {
+            scan_run(in, out, len, op, false, A{});
+            return result;
+        }
+        std::vector<A> totals(chunks);
+        const index_t nc = static_cast<index_t>(chunks);
+#ifdef _OPENMP
+        #pragma omp parallel for schedule(static)
+#endif
+        for (index_t c = 0; c < nc; ++c) {
+            size_t lo = len * static_cast<size_t>(c) / chunks, hi = len * (static_cast<size_t>(c) + 1) / chunks;
+            totals[static_cast<size_t>(c)] = reduce_run<A>(in + lo, hi - lo, op);
+        }
+        for (size_t c = 1; c < chunks; ++c) totals[c] = op(totals[c - 1], totals[c]);
+#ifdef _OPENMP
+        #pragma omp parallel for schedule(static)
+#endif
+        for (index_t c = 0; c < nc; ++c) {
+            size_t lo = len * static_cast<size_t>(c) / chunks, hi = len * (static_cast<size_t>(c) + 1) / chunks;
+            scan_run(in + lo, out + lo, hi - lo, op, c > 0, c > 0 ? totals[static_cast<size_t>(c) - 1] : A{});
+        }
+        return result;
+    }
+
+    if (inner == 1) {
+        const index_t lanes = static_cast<index_t>(outer);
+#ifdef _OPENMP
+        #pragma omp parallel for if(parallel) schedule(static)
+#endif
+        for (index_t o = 0; o < lanes; ++o) {
+            size_t base = static_cast<size_t>(o) * len;
+            scan_run(in + base, out + base, len, op, false, A{});
+        }
+        return result;
+    }
+
+    const size_t col_chunks = (inner + SCAN_COLUMNS - 1) / SCAN_COLUMNS;
+    const index_t tasks = static_cast<index_t>(outer * col_chunks);
+#ifdef _OPENMP
+    #pragma omp parallel for if(parallel) schedule(static)
+#endif
+    for (index_t t = 0; t < tasks; ++t) {
+        size_t o = static_cast<size_t>(t) / col_chunks;
+        size_t c0 = (static_cast<size_t>(t) % col_chunks) * SCAN_COLUMNS;
+        size_t width = std::min(SCAN_COLUMNS, inner - c0);
+        const T* x = in + o * len * inner + c0;
+        A* y = out + o * len * inner + c0;
+        for (size_t i = 0; i < width; ++i) y[i] = static_cast<A>(x[i]);
+        for (size_t j = 1; j < len; ++j) {
+            const A* prev = y + (j - 1) * inner;
+            A* cur = y + j * inner;
+            const T* src = x + j * inner;
+            for (size_t i = 0; i < width; ++i) cur[i] = op(prev[i], static_cast<A>(src[i]));
+        }
+    }
     return result;
 }
 
+/**
+ * @brief Scan over the flattened array (result keeps the input shape).
+ */
+template<typename A, typename T, typename Op>
+ndarray<A> scan_flat(const ndarray<T>& arr, Op op) {
+    return scan_axis<A>(arr, 1, arr.size(), 1, op);
+}
+
+/**
+ * @brief Scan along `axis` (negative values count from the end).
+ *
+ * @throws std::runtime_error If axis is out of range
+ */
+template<typename A, typename T, typename Op>
+ndarray<A> scan_along(const ndarray<T>& arr, int axis, Op op) {
+    const size_t ax = normalize_axis(axis, arr.ndim());
+    size_t outer = 1, inner = 1;
+    for (size_t i = 0; i < ax; ++i) outer *= arr.shape()[i];
+    for (size_t i = ax + 1; i < arr.ndim(); ++i) inner *= arr.shape()[i];
+    return scan_axis<A>(arr, outer, arr.shape()[ax], inner, op);
+}
+
+/**
+ * @brief Computes cumulative sum of ndarray elements.
+ *
+ * Runs over the elements in row-major order; the result keeps the input
+ * shape. `Acc` selects a wider accumulator/result type, e.g.
+ * `cumsum<int64_t>(int32_array)` or `cumsum<double>(float_array)`.
+ */
+template<typename Acc = void, typename T>
+ndarray<scan_result_t<Acc, T>> cumsum(const ndarray<T>& arr) {
+    return scan_flat<scan_result_t<Acc, T>>(arr, ScanSum());
+}
+
+/**
+ * @brief Computes cumulative sum along an axis.
+ *
+ * @code
+ * auto running = cumsum(series, 1);              // per-row totals of {N, T}
+ * auto exact = cumsum<double>(series, -1);       // accumulate in double
+ * @endcode
+ *
+ * @throws std::runtime_error if axis is out of range
+ */
+template<typename Acc = void, typename T>
+ndarray<scan_result_t<Acc, T>> cumsum(const ndarray<T>& arr, int axis) {
+    return scan_along<scan_result_t<Acc, T>>(arr, axis, ScanSum());
+}
+
 /**
  * @brief Computes cumulative product of ndarray elements.
+ *
+ * Runs over the elements in row-major order; `Acc` selects a wider
+ * accumulator/result type.
+ */
+template<typename Acc = void, typename T>
+ndarray<scan_result_t<Acc, T>> cumprod(const ndarray<T>& arr) {
+    return scan_flat<scan_result_t<Acc, T>>(arr, ScanProd());
+}
+
+/**
+ * @brief Computes cumulative product along an axis.
+ * @throws std::runtime_error if axis is out of range
+ */
+template<typename Acc = void, typename T>
+ndarray<scan_result_t<Acc, T>> cumprod(const ndarray<T>& arr, int axis) {
+    return scan_along<scan_result_t<Acc, T>>(arr, axis, ScanProd());
+}
+
+/**
+ * @brief Running maximum of ndarray elements in row-major order.
  */
 template<typename T>
-ndarray<T> cumprod(const ndarray<T>& arr) {
-    ndarray<T> result(arr.shape());
-    T running = T{1};
-    for (size_t i = 0; i < arr.size(); ++i) {
-        running *= arr[i];
-        result[i] = running;
-    }
-    return result;
+ndarray<T> cummax(const ndarray<T>& arr) {
+    return scan_flat<T>(arr, ScanMax());
+}
+
+/**
+ * @brief Running maximum along an axis.
+ * @throws std::runtime_error if axis is out of range
+ */
+template<typename T>
+ndarray<T> cummax(const ndarray<T>& arr, int axis) {
+    return scan_along<T>(arr, axis, ScanMax());
+}
+
+/**
+ * @brief Running minimum of ndarray elements in row-major order.
+ */
+template<typename T>
+ndarray<T> cummin(const ndarray<T>& arr) {
+    return scan_flat<T>(arr, ScanMin());
+}
+
+/**
+ * @brief Running minimum along an axis.
+ * @throws std::runtime_error if axis is out of range
+ */
+template<typename T>
+ndarray<T> cummin(const ndarray<T>& arr, int axis) {
+    return scan_along<T>(arr, axis, ScanMin());
 }
 
 /**
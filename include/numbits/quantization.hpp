@@ -0,0 +1,497 @@
+/**
+ * @file quantization.hpp
+ * @brief Int8 quantized arrays and int8 matrix multiplication.
+ *
+ * Provides:
+ *   - QuantizedArray: an ndarray<int8_t> with per-tensor or per-channel
+ *     scales and zero points, `x ~= (q - zero_point) * scale`
+ *   - quantize(), dequantize(): conversion from and to floating point
+ *   - matmul_int8(): int8 x int8 -> int32 matrix product
+ *   - qmatmul(): float result of a product of quantized matrices
+ *
+ * Quantization rounds to nearest (ties to even) and saturates to
+ * [-128, 127]. Symmetric parameters use a zero point of 0 and map the
+ * largest magnitude to 127; asymmetric parameters spread [min, max] over
+ * all 256 codes. Both ranges always include 0, so zero is exact.
+ *
+ * matmul_int8() packs both operands into 32-bit words holding consecutive
+ * k values and multiplies QGEMM_MR x QGEMM_NR tiles with int32 accumulators:
+ *   - AVX-512 VNNI: four u8 x s8 products per lane (vpdpbusd). The left
+ *     operand is offset by 128 to make it unsigned and the offset is
+ *     subtracted through the column sums of the right operand, so results
+ *     are exact over the full int8 range.
+ *   - AVX2: two int16 products per lane (vpmaddwd). The saturating
+ *     u8 x s8 vpmaddubsw is not used because it overflows for full-range
+ *     int8 inputs.
+ *   - Otherwise a portable loop over the same packed layout.
+ * The SIMD paths are used when the compiler targets them (e.g. -mavx2 or
+ * -march=native).
+ *
+ * @namespace numbits
+ */
+
+#pragma once
+
+#include "ndarray.hpp"
+#include "indexing.hpp"
+#include "utils.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#if (defined(__AVX512VNNI__) && defined(__AVX512F__)) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace numbits {
+
+/**
+ * @brief Minimum number of elements before quantize()/dequantize() run in parallel.
+ */
+constexpr size_t QUANT_PARALLEL_MIN = size_t(1) << 16;
+
+/**
+ * @brief Minimum number of multiply-adds (m * n * k) before matmul_int8() runs in parallel.
+ */
+constexpr size_t QGEMM_PARALLEL_OPS = size_t(1) << 20;
+
+/**
+ * @brief Rows of the left operand per matmul_int8() tile.
+ */
+constexpr size_t QGEMM_MR = 4;
+
+#if defined(__AVX512VNNI__) && defined(__AVX512F__)
+constexpr size_t QGEMM_NR = 16; ///< Columns per packed panel of the right operand
+constexpr size_t QGEMM_KG = 4;  ///< Consecutive k values per packed 32-bit word
+#else
+constexpr size_t QGEMM_NR = 8;  ///< Columns per packed panel of the right operand
+constexpr size_t QGEMM_KG = 2;  ///< Consecutive k values per packed 32-bit word
+#endif
+
+/**
+ * @struct QuantizedArray
+ * @brief Int8 values with the scales and zero points that map them back to real numbers.
+ *
+ * With per-channel parameters, `scales[c]` and `zero_points[c]` apply to
+ * index `c` along `axis`; otherwise both vectors hold a single entry.
+ */
+struct QuantizedArray {
+    ndarray<int8_t> values;
+    std::vector<float> scales;
+    std::vector<int32_t> zero_points;
+    int axis = -1; ///< Channel axis (non-negative), or -1 for per-tensor parameters
+
+    const Shape& shape() const { return values.shape(); }
+    bool per_channel() const { return axis >= 0; }
+};
+
+/**
+ * @brief Scale and zero point covering [lo, hi] (extended to include 0).
+ *
+ * @throws std::runtime_error If the range is not finite.
+ */
+inline void choose_qparams(float lo, float hi, bool symmetric, float& scale, int32_t& zero_point) {
+    if (!std::isfinite(lo) || !std::isfinite(hi))
+        throw std::runtime_error("quantize: values must be finite");
+    lo = std::min(lo, 0.0f);
+    hi = std::max(hi, 0.0f);
+    if (symmetric) {
+        const float m = std::max(-lo, hi);
+        scale = m > 0.0f ? m / 127.0f : 1.0f;
+        zero_point = 0;
+    } else {
+        scale = hi > lo ? (hi - lo) / 255.0f : 1.0f;
+        const float z = std::nearbyint(-128.0f - lo / scale);
+        zero_point = static_cast<int32_t>(std::min(127.0f, std::max(-128.0f, z)));
+    }
+}
+
+/**
+ * @brief Smallest and largest value of `n` elements (NaN is ignored), widened into lo/hi.
+ */
+template<typename T>
+inline void value_range(const T* x, size_t n, float& lo, float& hi) {
+    for (size_t i = 0; i < n; ++i) {
+        const float v = static_cast<float>(x[i]);
+        lo = v < lo ? v : lo;
+        hi = v > hi ? v : hi;
+    }
+}
+
+/**
+ * @brief `q[i] = clamp(round(x[i] / scale) + zero_point, -128, 127)`; NaN maps to the zero point.
+ */
+template<typename T>
+inline void quantize_run(const T* x, int8_t* q, size_t n, float scale, int32_t zero_point) {
+    const float inv = 1.0f / scale, z = static_cast<float>(zero_point);
+    for (size_t i = 0; i < n; ++i) {
+        float v = std::nearbyint(static_cast<float>(x[i]) * inv) + z;
+        v = v < -128.0f ? -128.0f : v;
+        v = v > 127.0f ? 127.0f : v;
+        q[i] = static_cast<int8_t>(v == v ? v : z);
+    }
+}
+
+/**
+ * @brief `x[i] = (q[i] - zero_point) * scale`.
+ */
+template<typename T>
+inline void dequantize_run(const int8_t* q, T* x, size_t n, float scale, int32_t zero_point) {
+    for (size_t i = 0; i < n; ++i)
+        x[i] = static_cast<T>(static_cast<float>(static_cast<int32_t>(q[i]) - zero_point) * scale);
+}
+
+/**
+ * @brief Call `fn(c, offset, count)` for every contiguous block of channel `c` along a split axis.
+ *
+ * Channels are distributed over threads; each channel is visited by one thread.
+ */
+template<typename Fn>
+void for_each_channel_block(const AxisSplit& split, bool parallel, Fn fn) {
+    const index_t channels = static_cast<index_t>(split.len);
+    (void)parallel;
+#ifdef _OPENMP
+    #pragma omp parallel for if(parallel) schedule(static)
+#endif
+    for (index_t c = 0; c < channels; ++c)
+        for (size_t o = 0; o < split.outer; ++o)
+            fn(static_cast<size_t>(c), (o * split.len + static_cast<size_t>(c)) * split.inner, split.inner);
+}
+
+/**
+ * @brief Quantize an array to int8 with one scale and zero point for all elements.
+ *
+ * @code
+ * QuantizedArray w = quantize(weights);          // symmetric, zero point 0
+ * QuantizedArray x = quantize(inputs, false);    // asymmetric, covers [min, max]
+ * @endcode
+ *
+ * @param symmetric Use a zero point of 0 and the largest magnitude for the scale
+ * @throws std::runtime_error If the array contains infinities
+ */
+template<typename T>
+QuantizedArray quantize(const ndarray<T>& arr, bool symmetric = true) {
+    static_assert(std::is_floating_point_v<T> || is_half_v<T>, "quantize requires a floating-point type");
+    const T* x = arr.data();
+    const index_t n = static_cast<index_t>(arr.size());
+    const bool parallel = arr.size() >= QUANT_PARALLEL_MIN;
+    (void)parallel;
+
+    float lo = 0.0f, hi = 0.0f;
+#ifdef _OPENMP
+    #pragma omp parallel for if(parallel) schedule(static) reduction(min:lo) reduction(max:hi)
+#endif
+    for (index_t i = 0; i < n; ++i) {
+        const float v = static_cast<float>(x[i]);
+        lo = v < lo ? v : lo;
+        hi = v > hi ? v : hi;
+    }
+
+    QuantizedArray out;
+    out.scales.resize(1);
+    out.zero_points.resize(1);
+    choose_qparams(lo, hi, symmetric, out.scales[0], out.zero_points[0]);
+    out.values = ndarray<int8_t>(arr.shape());
+
+    const size_t chunk = QUANT_PARALLEL_MIN / 4;
+    const index_t chunks = static_cast<index_t>((arr.size() + chunk - 1) / chunk);
+    int8_t* q = out.values.data();
+#ifdef _OPENMP
+    #pragma omp parallel for if(parallel) schedule(static)
+#endif
+    for (index_t c = 0; c < chunks; ++c) {
+        const size_t begin = static_cast<size_t>(c) * chunk;
+        quantize_run(x + begin, q + begin, std::min(chunk, arr.size() - begin), out.scales[0], out.zero_points[0]);
+    }
+    return out;
+}
+
+/**
+ * @brief Quantize an array to int8 with a scale and zero point per index along `axis`.
+ *
+ * @code
+ * QuantizedArray w = quantize(weights, 1);  // one scale per output column of a {K, N} matrix
+ * @endcode
+ *
+ * @throws std::runtime_error If the axis is out of range or the array contains infinities
+ */
+template<typename T>
+QuantizedArray quantize(const ndarray<T>& arr, int axis, bool symmetric = true) {
+    static_assert(std::is_floating_point_v<T> || is_half_v<T>, "quantize requires a floating-point type");
+    const size_t ax = normalize_axis(axis, arr.ndim());
+    const AxisSplit split = split_axis(arr.shape(), ax);
+    const bool parallel = arr.size() >= QUANT_PARALLEL_MIN;
+    const T* x = arr.data();
+
+    std::vector<float> lo(split.len, 0.0f), hi(split.len, 0.0f);
+    for_each_channel_block(split, parallel, [&](size_t c, size_t offset, size_t count) {
+        value_range(x + offset, count, lo[c], hi[c]);
+    });
+
+    QuantizedArray out;
+    out.axis = static_cast<int>(ax);
+    out.scales.resize(split.len);
+    out.zero_points.resize(split.len);
+    for (size_t c = 0; c < split.len; ++c) choose_qparams(lo[c], hi[c], symmetric, out.scales[c], out.zero_points[c]);
+    out.values = ndarray<int8_t>(arr.shape());
+
+    int8_t* q = out.values.data();
+    for_each_channel_block(split, parallel, [&](size_t c, size_t offset, size_t count) {
+        quantize_run(x + offset, q + offset, count, out.scales[c], out.zero_points[c]);
+    });
+    return out;
+}
+
+/**
+ * @brief Reconstruct real values `(q - zero_point) * scale` from a quantized array.
+ *
+ * @tparam T Floating-point result type (float by default)
+ * @throws std::runtime_error If the parameters do not match the array
+ */
+template<typename T = float>
+ndarray<T> dequantize(const QuantizedArray& qa) {
+    const size_t params = qa.per_channel() ? split_axis(qa.shape(), static_cast<size_t>(qa.axis)).len : 1;
+    if (qa.scales.size() != params || qa.zero_points.size() != params)
+        throw std::runtime_error("dequantize: scales and zero points do not match the array");
+
+    ndarray<T> out(qa.shape());
+    const int8_t* q = qa.values.data();
+    T* x = out.data();
+    const bool parallel = out.size() >= QUANT_PARALLEL_MIN;
+    if (!qa.per_channel()) {
+        const size_t chunk = QUANT_PARALLEL_MIN / 4;
+        const index_t chunks = static_cast<index_t>((out.size() + chunk - 1) / chunk);
+        (void)parallel;
+#ifdef _OPENMP
+        #pragma omp parallel for if(parallel) schedule(static)
+#endif
+        for (index_t c = 0; c < chunks; ++c) {
+            const size_t begin = static_cast<size_t>(c) * chunk;
+            dequantize_run(q + begin, x + begin, std::min(chunk, out.size() - begin), qa.scales[0], qa.zero_points[0]);
+        }
+        return out;
+    }
+    const AxisSplit split = split_axis(qa.shape(), static_cast<size_t>(qa.axis));
+    for_each_channel_block(split, parallel, [&](size_t c, size_t offset, size_t count) {
+        dequantize_run(q + offset, x + offset, count, qa.scales[c], qa.zero_points[c]);
+    });
+    return out;
+}
+
+/**
+ * @brief Pack the rows of an m x k int8 matrix into QGEMM_KG values per 32-bit word.
+ *
+ * Rows are padded to whole words. With VNNI the values are offset by 128
+ * (stored unsigned); otherwise each word holds two sign-extended int16.
+ */
+inline std::vector<uint32_t> pack_qgemm_a(const int8_t* a, size_t m, size_t k) {
+    const size_t kw = (k + QGEMM_KG - 1) / QGEMM_KG;
+    std::vector<uint32_t> packed(m * kw, 0u);
+    for (size_t i = 0; i < m; ++i)
+        for (size_t kk = 0; kk < k; ++kk) {
+            const int8_t v = a[i * k + kk];
+            const uint32_t code = QGEMM_KG == 4 ? static_cast<uint32_t>(static_cast<uint8_t>(v) ^ 0x80u)
+                                                : static_cast<uint32_t>(static_cast<uint16_t>(static_cast<int16_t>(v)));
+            packed[i * kw + kk / QGEMM_KG] |= code << (32 / QGEMM_KG * (kk % QGEMM_KG));
+        }
+    return packed;
+}
+
+/**
+ * @brief Pack a k x n int8 matrix into panels of QGEMM_NR columns.
+ *
+ * Panel `p` holds, for every word index `g`, QGEMM_NR consecutive words:
+ * word `j` packs rows `g * QGEMM_KG ...` of column `p * QGEMM_NR + j`.
+ * Missing rows and columns are zero.
+ */
+inline std::vector<uint32_t> pack_qgemm_b(const int8_t* b, size_t k, size_t n) {
+    const size_t kw = (k + QGEMM_KG - 1) / QGEMM_KG;
+    const size_t panels = (n + QGEMM_NR - 1) / QGEMM_NR;
+    std::vector<uint32_t> packed(panels * kw * QGEMM_NR, 0u);
+    for (size_t kk = 0; kk < k; ++kk)
+        for (size_t j = 0; j < n; ++j) {
+            const int8_t v = b[kk * n + j];
+            const uint32_t code = QGEMM_KG == 4 ? static_cast<uint32_t>(static_cast<uint8_t>(v))
+                                                : static_cast<uint32_t>(static_cast<uint16_t>(static_cast<int16_t>(v)));
+            const size_t p = j / QGEMM_NR;
+            packed[(p * kw + kk / QGEMM_KG) * QGEMM_NR + j % QGEMM_NR] |= code << (32 / QGEMM_KG * (kk % QGEMM_KG));
+        }
+    return packed;
+}
+
+/**
+ * @brief Multiply MR packed rows of A by one packed panel of B into `acc`.
+ */
+template<size_t MR>
+inline void qgemm_tile(const uint32_t* a, size_t kw, const uint32_t* panel, int32_t (*acc)[QGEMM_NR]) {
+#if defined(__AVX512VNNI__) && defined(__AVX512F__)
+    __m512i sum[MR];
+    for (size_t r = 0; r < MR; ++r) sum[r] = _mm512_setzero_si512();
+    for (size_t g = 0; g < kw; ++g) {
+        const __m512i bv = _mm512_loadu_si512(panel + g * QGEMM_NR);
+        for (size_t r = 0; r < MR; ++r)
+            sum[r] = _mm512_dpbusd_epi32(sum[r], _mm512_set1_epi32(static_cast<int>(a[r * kw + g])), bv);
+    }
+    for (size_t r = 0; r < MR; ++r) _mm512_storeu_si512(acc[r], sum[r]);
+#elif defined(__AVX2__)
+    __m256i sum[MR];
+    for (size_t r = 0; r < MR; ++r) sum[r] = _mm256_setzero_si256();
+    for (size_t g = 0; g < kw; ++g) {
+        const __m256i bv = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(panel + g * QGEMM_NR));
+        for (size_t r = 0; r < MR; ++r)
+            sum[r] = _mm256_add_epi32(sum[r], _mm256_madd_epi16(_mm256_set1_epi32(static_cast<int>(a[r * kw + g])), bv));
+    }
+    for (size_t r = 0; r < MR; ++r) _mm256_storeu_si256(reinterpret_cast<__m256i*>(acc[r]), sum[r]);
+#else
+    int32_t sum[MR][QGEMM_NR] = {};
+    for (size_t g = 0; g < kw; ++g) {
+        const uint32_t* bw = panel + g * QGEMM_NR;
+        for (size_t r = 0; r < MR; ++r) {
+            const int32_t a0 = static_cast<int16_t>(a[r * kw + g] & 0xFFFFu);
+            const int32_t a1 = static_cast<int16_t>(a[r * kw + g] >> 16);
+            for (size_t j = 0; j < QGEMM_NR; ++j)
+                sum[r][j] += a0 * static_cast<int16_t>(bw[j] & 0xFFFFu) + a1 * static_cast<int16_t>(bw[j] >> 16);
+        }
+    }
+    for (size_t r = 0; r < MR; ++r) std::copy(sum[r], sum[r] + QGEMM_NR, acc[r]);
+#endif
+}
+
+/**
+ * @brief `c = a * b` for row-major int8 matrices a (m x k) and b (k x n), int32 result c (m x n).
+ */
+inline void qgemm(const int8_t* a, const int8_t* b, int32_t* c, size_t m, size_t n, size_t k) {
+    const size_t kw = (k + QGEMM_KG - 1) / QGEMM_KG;
+    const std::vector<uint32_t> pa = pack_qgemm_a(a, m, k);
+    const std::vector<uint32_t> pb = pack_qgemm_b(b, k, n);
+
+    // With VNNI the left operand was offset by 128: subtract 128 * column sums of b
+    std::vector<int32_t> correction(n, 0);
+    if (QGEMM_KG == 4)
+        for (size_t kk = 0; kk < k; ++kk)
+            for (size_t j = 0; j < n; ++j) correction[j] += 128 * b[kk * n + j];
+
+    const size_t panels = (n + QGEMM_NR - 1) / QGEMM_NR;
+    const size_t row_blocks = (m + QGEMM_MR - 1) / QGEMM_MR;
+    const index_t tasks = static_cast<index_t>(panels * row_blocks);
+    const bool parallel = m * n * k >= QGEMM_PARALLEL_OPS;
+    (void)parallel;
+#ifdef _OPENMP
+    #pragma omp parallel for if(parallel) schedule(static)
+#endif
+    for (index_t t = 0; t < tasks; ++t) {
+        const size_t i0 = static_cast<size_t>(t) / panels * QGEMM_MR;
+        const size_t j0 = static_cast<size_t>(t) % panels * QGEMM_NR;
+        const size_t rows = std::min(QGEMM_MR, m - i0), cols = std::min(QGEMM_NR, n - j0);
+        const uint32_t* arows = pa.data() + i0 * kw;
+        const uint32_t* panel = pb.data() + j0 / QGEMM_NR * kw * QGEMM_NR;
+        alignas(64) int32_t acc[QGEMM_MR][QGEMM_NR];
+        switch (rows) {
+            case 4: qgemm_tile<4>(arows, kw, panel, acc); break;
+            case 3: qgemm_tile<3>(arows, kw, panel, acc); break;
+            case 2: qgemm_tile<2>(arows, kw, panel, acc); break;
+            default: qgemm_tile<1>(arows, kw, panel, acc); break;
+        }
+        for (size_t r = 0; r < rows; ++r)
+            for (size_t j = 0; j < cols; ++j) c[(i0 + r) * n + j0 + j] = acc[r][j] - correction[j0 + j];
+    }
+}
+
+/**
+ * @brief Exact int8 x int8 matrix product with int32 accumulation.
+ *
+ * @param a Left matrix of shape (m, k)
+ * @param b Right matrix of shape (k, n)
+ * @return ndarray<int32_t> of shape (m, n)
+ * @throws std::runtime_error If the inputs are not 2D or the shapes are incompatible
+ */
+inline ndarray<int32_t> matmul_int8(const ndarray<int8_t>& a, const ndarray<int8_t>& b) {
+    if (a.ndim() != 2 || b.ndim() != 2)
+        throw std::runtime_error("matmul_int8 requires 2D ndarrays");
+    if (a.shape()[1] != b.shape()[0])
+        throw std::runtime_error("Matrix dimensions incompatible for multiplication");
+    ndarray<int32_t> result(Shape{a.shape()[0], b.shape()[1]});
+    qgemm(a.data(), b.data(), result.data(), a.shape()[0], b.shape()[1], a.shape()[1]);
+    return result;
+}
+
+/**
+ * @brief Product of two quantized matrices, returned in float.
+ *
+ * Computes the int32 product of the raw values with matmul_int8() and
+ * applies scales and zero points once per output element:
+ * `C[i][j] = sa_i * sb_j * sum_k (qa[i][k] - za_i) * (qb[k][j] - zb_j)`.
+ *
+ * @param a Left matrix (m, k), quantized per tensor or per row (axis 0)
+ * @param b Right matrix (k, n), quantized per tensor or per column (axis 1)
+ * @throws std::runtime_error On incompatible shapes or channel axes
+ */
+inline ndarray<float> qmatmul(const QuantizedArray& a, const QuantizedArray& b) {
+    if (a.values.ndim() != 2 || b.values.ndim() != 2)
+        throw std::runtime_error("qmatmul requires 2D arrays");
+    if ((a.per_channel() && a.axis != 0) || (b.per_channel() && b.axis != 1))
+        throw std::runtime_error("qmatmul requires per-row parameters for a and per-column parameters for b");
+    const size_t m = a.shape()[0], k = a.shape()[1], n = b.shape()[1];
+    if (a.scales.size() != (a.per_channel() ? m : 1) || b.scales.size() != (b.per_channel() ? n : 1) ||
+        a.zero_points.size() != a.scales.size() || b.zero_points.size() != b.scales.size())
+        throw std::runtime_error("qmatmul: scales and zero points do not match the arrays");
+
+    ndarray<int32_t> acc = matmul_int8(a.values, b.values);
+
+    std::vector<int64_t> row_sums(m, 0), col_sums(n, 0);
+    const int8_t* qa = a.values.data();
+    const int8_t* qb = b.values.data();
+    for (size_t i = 0; i < m; ++i)
+        for (size_t kk = 0; kk < k; ++kk) row_sums[i] += qa[i * k + kk];
+    for (size_t kk = 0; kk < k; ++kk)
+        for (size_t j = 0; j < n; ++j) col_sums[j] += qb[kk * n + j];
+
+    ndarray<float> out(Shape{m, n});
+    const int32_t* s = acc.data();
+    float* o = out.data();
+    const index_t rows = static_cast<index_t>(m);
+    const bool parallel = m * n >= QUANT_PARALLEL_MIN;
+    (void)parallel;
+#ifdef _OPENMP
+    #pragma omp parallel for if(parallel) schedule(static)
+#endif
+    for (index_t ii = 0; ii < rows; ++ii) {
+        const size_t i = static_cast<size_t>(ii);
+        const int64_t za = a.zero_points[a.per_channel() ? i : 0];
+        const float sa = a.scales[a.per_channel() ? i : 0];
+        for (size_t j = 0; j < n; ++j) {
+            const int64_t zb = b.zero_points[b.per_channel() ? j : 0];
+            const int64_t exact = s[i * n + j] - zb * row_sums[i] - za * col_sums[j] +
+                                  static_cast<int64_t>(k) * za * zb;
+            o[i * n + j] = sa * b.scales[b.per_channel() ? j : 0] * static_cast<float>(exact);
+        }
+    }
+    return out;
+}
+
+/**
+ * @brief Product of a floating-point matrix and a quantized matrix.
+ *
+ * The left operand is quantized per row with asymmetric parameters
+ * (dynamic quantization of activations), then multiplied with qmatmul().
+ *
+ * @code
+ * QuantizedArray w = quantize(weights, 1);  // {K, N}, once
+ * ndarray<float> y = qmatmul(x, w);         // x is {M, K}
+ * @endcode
+ */
+template<typename T>
+ndarray<float> qmatmul(const ndarray<T>& a, const QuantizedArray& b) {
+    if (a.ndim() != 2) throw std::runtime_error("qmatmul requires 2D arrays");
+    return qmatmul(quantize(a, 0, false), b);
+}
+
+} // namespace numbits
@@ -3,9 +3,13 @@
  * @brief Random number generation functions for arrays.
  *
  * Provides functions to generate arrays with random values:
- *   - rand: Uniform random values [0, 1)
- *   - randn: Standard normal distribution N(0, 1)
- *   - randint: Random integers in range
+ *   - uniform: Uniform random values [min, max)
+ *   - normal: Normal distribution N(mean, stddev)
+ *   - randint: Random integers in an inclusive range
+ *   - Philox4x32: Counter-based engine whose output for element i depends
+ *     only on (seed, i), so parallel fills are bit-reproducible
+ *   - Bulk kernels that generate whole blocks of raw words and map them
+ *     with vectorizable loops (Box-Muller pairs, Lemire bounded integers)
  *   - Default engines for reproducibility
  *   - Optional OpenMP parallel support
  *
@@ -18,19 +22,163 @@
 #include <random>
 #include <limits>
 #include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
 
 #ifdef _OPENMP
 #include <omp.h>
 #endif
 
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
 namespace numbits{
 
+/**
+ * @class Philox4x32
+ * @brief Philox4x32-10 counter-based random engine (Salmon et al., SC'11).
+ *
+ * A Philox engine is a keyed bijection of a 128-bit counter: block(i)
+ * depends only on the key (derived from the seed) and `i`. Bulk fills use
+ * this directly — element `i` of a fill draws from counter `offset + i` —
+ * so every thread can generate its share of an array independently and the
+ * result does not depend on the number of threads.
+ *
+ * The engine also satisfies the UniformRandomBitGenerator requirements and
+ * can drive the `std::` distributions sequentially.
+ */
+class Philox4x32 {
+public:
+    using result_type = uint32_t;
+    using counter_type = std::array<uint32_t, 4>;
+    using key_type = std::array<uint32_t, 2>;
+
+    static constexpr uint32_t M0 = 0xD2511F53u; ///< Round multiplier for word 0
+    static constexpr uint32_t M1 = 0xCD9E8D57u; ///< Round multiplier for word 2
+    static constexpr uint32_t W0 = 0x9E3779B9u; ///< Key schedule increment (golden ratio)
+    static constexpr uint32_t W1 = 0xBB67AE85u; ///< Key schedule increment (sqrt(3) - 1)
+
+    /**
+     * @brief Construct an engine from a 64-bit seed.
+     */
+    explicit Philox4x32(uint64_t seed_value = 20111115u) { seed(seed_value); }
+
+    /**
+     * @brief Re-key the engine and rewind it to counter 0.
+     */
+    void seed(uint64_t seed_value) {
+        key_ = {static_cast<uint32_t>(seed_value), static_cast<uint32_t>(seed_value >> 32)};
+        position_ = 0;
+        word_ = 4;
+    }
+
+    /** @return Smallest value returned by operator(). */
+    static constexpr result_type min() { return 0; }
+
+    /** @return Largest value returned by operator(). */
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    /**
+     * @brief Apply the 10-round Philox bijection to a counter.
+     *
+     * @param ctr 128-bit counter.
+     * @param key 64-bit key.
+     * @return Four pseudo-random 32-bit words.
+     */
+    static counter_type generate(counter_type ctr, key_type key) {
+        for (int round = 0; round < 10; ++round) {
+            uint64_t p0 = uint64_t(M0) * ctr[0];
+            uint64_t p1 = uint64_t(M1) * ctr[2];
+            ctr = {static_cast<uint32_t>(p1 >> 32) ^ ctr[1] ^ key[0], static_cast<uint32_t>(p1),
+                   static_cast<uint32_t>(p0 >> 32) ^ ctr[3] ^ key[1], static_cast<uint32_t>(p0)};
+            key[0] += W0;
+            key[1] += W1;
+        }
+        return ctr;
+    }
+
+    /**
+     * @brief Random block for a given 64-bit position and sub-stream word.
+     *
+     * @param index Position in the stream (low 64 bits of the counter).
+     * @param stream Extra counter word, used e.g. for rejection retries.
+     */
+    counter_type block(uint64_t index, uint32_t stream = 0) const {
+        return generate({static_cast<uint32_t>(index), static_cast<uint32_t>(index >> 32),
+                         stream, 0u}, key_);
+    }
+
+    /**
+     * @brief Next 32-bit word of the sequential stream.
+     */
+    result_type operator()() {
+        if (word_ == 4) {
+            buffer_ = block(position_++);
+            word_ = 0;
+        }
+        return buffer_[word_++];
+    }
+
+    /**
+     * @brief Skip `z` words of the sequential stream.
+     */
+    void discard(unsigned long long z) {
+        for (; z > 0 && word_ < 4; --z) ++word_;
+        position_ += z / 4;
+        if (z % 4) {
+            buffer_ = block(position_++);
+            word_ = static_cast<unsigned>(z % 4);
+        }
+    }
+
+    /**
+     * @brief Claim `n` consecutive counters for a bulk fill.
+     *
+     * Returns the first claimed counter and advances the engine past the
+     * block, so consecutive fills never reuse random numbers.
+     */
+    uint64_t reserve(uint64_t n) {
+        word_ = 4;
+        uint64_t first = position_;
+        position_ += n;
+        return first;
+    }
+
+    /** @return Current counter position of the engine. */
+    uint64_t position() const { return position_; }
+
+    /** @return The key derived from the seed. */
+    const key_type& key() const { return key_; }
+
+private:
+    key_type key_{};
+    uint64_t position_ = 0;
+    counter_type buffer_{};
+    unsigned word_ = 4;
+};
+
+/**
+ * @brief Trait marking engines that support counter-based bulk generation.
+ */
+template<typename Engine>
+struct is_counter_based : std::false_type {};
+
+template<>
+struct is_counter_based<Philox4x32> : std::true_type {};
+
+template<typename Engine>
+constexpr bool is_counter_based_v = is_counter_based<Engine>::value;
+
 /**
  * @brief Returns the default 32-bit random engine.
- * 
+ *
  * This engine is shared across all random functions in this namespace.
  * It is initialized with a non-deterministic seed from std::random_device.
- * 
+ *
  * @return std::mt19937& Reference to the default engine.
  */
 inline std::mt19937& default_engine() {
@@ -40,10 +188,10 @@ inline std::mt19937& default_engine() {
 
 /**
  * @brief Returns the default 64-bit random engine.
- * 
+ *
  * This engine can be used when higher-quality 64-bit random numbers are needed.
  * Initialized with a non-deterministic seed from std::random_device.
- * 
+ *
  * @return std::mt19937_64& Reference to the 64-bit default engine.
  */
 inline std::mt19937_64& default_engine64() {
@@ -51,110 +199,510 @@ inline std::mt19937_64& default_engine64() {
     return eng;
 }
 
+/**
+ * @brief Returns the default counter-based engine used by uniform, normal and randint.
+ *
+ * Initialized with a non-deterministic seed from std::random_device.
+ *
+ * @return Philox4x32& Reference to the counter-based default engine.
+ */
+inline Philox4x32& default_counter_engine() {
+    static Philox4x32 eng((uint64_t(std::random_device{}()) << 32) | std::random_device{}());
+    return eng;
+}
+
 /**
  * @brief Seeds all default engines for reproducible random numbers.
- * 
- * @param seed Unsigned long seed value to initialize both default engines.
+ *
+ * @param seed Unsigned long seed value to initialize all default engines.
  */
 inline void seed_engine(unsigned long seed) {
     default_engine().seed(seed);
     default_engine64().seed(seed);
+    default_counter_engine().seed(seed);
+}
+
+/**
+ * @brief Map a 32-bit word to a float in [0, 1) using its top 24 bits.
+ */
+inline float unit_float(uint32_t x) {
+    return static_cast<float>(x >> 8) * (1.0f / 16777216.0f);
+}
+
+/**
+ * @brief Map two 32-bit words to a double in [0, 1) using 53 bits.
+ */
+inline double unit_double(uint32_t hi, uint32_t lo) {
+    uint64_t bits = ((uint64_t(hi) << 32) | lo) >> 11;
+    return static_cast<double>(bits) * (1.0 / 9007199254740992.0);
+}
+
+/**
+ * @brief High 64 bits of a 64x64-bit product.
+ */
+inline uint64_t mulhi64(uint64_t a, uint64_t b, uint64_t& lo) {
+#if defined(__SIZEOF_INT128__)
+    unsigned __int128 p = static_cast<unsigned __int128>(a) * b;
+    lo = static_cast<uint64_t>(p);
+    return static_cast<uint64_t>(p >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    uint64_t hi;
+    lo = _umul128(a, b, &hi);
+    return hi;
+#else
+    uint64_t a_lo = a & 0xFFFFFFFFu, a_hi = a >> 32;
+    uint64_t b_lo = b & 0xFFFFFFFFu, b_hi = b >> 32;
+    uint64_t p0 = a_lo * b_lo, p1 = a_lo * b_hi, p2 = a_hi * b_lo, p3 = a_hi * b_hi;
+    uint64_t mid = (p0 >> 32) + (p1 & 0xFFFFFFFFu) + (p2 & 0xFFFFFFFFu);
+    lo = (mid << 32) | (p0 & 0xFFFFFFFFu);
+    return p3 + (p1 >> 32) + (p2 >> 32) + (mid >> 32);
+#endif
+}
+
+/**
+ * @brief Number of elements produced per call of a bulk kernel.
+ *
+ * Fills are split into blocks of this many elements; blocks are the unit of
+ * OpenMP parallelism and bound the size of the on-stack word buffer.
+ */
+constexpr size_t RANDOM_BLOCK = 1024;
+
+/**
+ * @brief Generate the Philox output words of `n` consecutive counters.
+ *
+ * Counters are processed in structure-of-arrays form so that the ten rounds
+ * vectorize across counters (one 32x32->64-bit multiply per lane). Word
+ * `4 * j + k` of the output is word `k` of counter `first + j`, i.e. the
+ * same values as block(first + j, stream).
+ *
+ * @param key Engine key.
+ * @param first First counter.
+ * @param n Number of counters.
+ * @param stream Sub-stream word of the counter.
+ * @param words Output buffer of `4 * n` words.
+ */
+inline void philox_words(const Philox4x32::key_type& key, uint64_t first, size_t n,
+                         uint32_t stream, uint32_t* words) {
+    constexpr size_t LANES = 64;
+    uint32_t c0[LANES], c1[LANES], c2[LANES], c3[LANES];
+    for (size_t base = 0; base < n; base += LANES) {
+        const size_t m = std::min(LANES, n - base);
+        for (size_t j = 0; j < m; ++j) {
+            uint64_t ctr = first + base + j;
+            c0[j] = static_cast<uint32_t>(ctr);
+            c1[j] = static_cast<uint32_t>(ctr >> 32);
+            c2[j] = stream;
+            c3[j] = 0;
+        }
+        uint32_t k0 = key[0], k1 = key[1];
+        for (int round = 0; round < 10; ++round) {
+            for (size_t j = 0; j < m; ++j) {
+                uint64_t p0 = uint64_t(Philox4x32::M0) * c0[j];
+                uint64_t p1 = uint64_t(Philox4x32::M1) * c2[j];
+                uint32_t n0 = static_cast<uint32_t>(p1 >> 32) ^ c1[j] ^ k0;
+                uint32_t n2 = static_cast<uint32_t>(p0 >> 32) ^ c3[j] ^ k1;
+                c1[j] = static_cast<uint32_t>(p1);
+                c3[j] = static_cast<uint32_t>(p0);
+                c0[j] = n0;
+                c2[j] = n2;
+            }
+            k0 += Philox4x32::W0;
+            k1 += Philox4x32::W1;
+        }
+        uint32_t* out = words + 4 * base;
+        for (size_t j = 0; j < m; ++j) {
+            out[4 * j + 0] = c0[j];
+            out[4 * j + 1] = c1[j];
+            out[4 * j + 2] = c2[j];
+            out[4 * j + 3] = c3[j];
+        }
+    }
+}
+
+/**
+ * @brief Generate the raw words backing elements [begin, end) of a fill and map them.
+ *
+ * Element `i` of a fill owns words `[W * i, W * (i + 1))` of the stream that
+ * starts at counter `offset`, so its value depends only on the seed, the
+ * fill offset and `i`.
+ *
+ * @tparam W Words consumed per element (1 or 2).
+ * @param eng Counter-based engine providing the key.
+ * @param offset First counter claimed by the fill.
+ * @param begin First element of the range.
+ * @param end One past the last element (end - begin <= RANDOM_BLOCK).
+ * @param map Callable `(const uint32_t* words, size_t count)`; `words[0]` is
+ *        the first word of element `begin`.
+ */
+template<size_t W, typename Map>
+void philox_bulk(const Philox4x32& eng, uint64_t offset, size_t begin, size_t end, Map map) {
+    uint32_t words[RANDOM_BLOCK * W + 8];
+    const size_t w_begin = begin * W;
+    const size_t w_end = end * W;
+    const uint64_t c_first = w_begin / 4;
+    const size_t n_counters = (w_end + 3) / 4 - c_first;
+    philox_words(eng.key(), offset + c_first, n_counters, 0, words);
+    map(words + w_begin % 4, end - begin);
+}
+
+/**
+ * @brief Branch-free natural logarithm for positive normal floats (Cephes logf).
+ *
+ * Written without data-dependent branches so loops calling it vectorize.
+ * Relative error is within a few ulp.
+ */
+inline float fast_logf(float x) {
+    uint32_t bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    float e = static_cast<float>(static_cast<int32_t>((bits >> 23) & 0xFF) - 126);
+    bits = (bits & 0x007FFFFFu) | 0x3F000000u;
+    float m;
+    std::memcpy(&m, &bits, sizeof(m));           // m in [0.5, 1)
+
+    const bool small = m < 0.707106781186547524f;
+    e -= small ? 1.0f : 0.0f;
+    m = m - 1.0f + (small ? m : 0.0f);           // m in [sqrt(0.5) - 1, sqrt(2) - 1)
+
+    float z = m * m;
+    float y = 7.0376836292e-2f;
+    y = y * m - 1.1514610310e-1f;
+    y = y * m + 1.1676998740e-1f;
+    y = y * m - 1.2420140846e-1f;
+    y = y * m + 1.4249322787e-1f;
+    y = y * m - 1.6668057665e-1f;
+    y = y * m + 2.0000714765e-1f;
+    y = y * m - 2.4999993993e-1f;
+    y = y * m + 3.3333331174e-1f;
+    y *= m * z;
+    y += -2.12194440e-4f * e;
+    y += -0.5f * z;
+    return m + y + 0.693359375f * e;
+}
+
+/**
+ * @brief Branch-free square root for non-negative floats.
+ *
+ * std::sqrt may set errno for negative inputs, which keeps GCC from
+ * vectorizing loops that call it unless -fno-math-errno is given. This uses
+ * the bit-level reciprocal square root estimate refined by three Newton
+ * steps, accurate to about one ulp.
+ */
+inline float fast_sqrtf(float x) {
+    uint32_t bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    bits = 0x5F375A86u - (bits >> 1);
+    float y;
+    std::memcpy(&y, &bits, sizeof(y));
+    const float half = 0.5f * x;
+    y = y * (1.5f - half * y * y);
+    y = y * (1.5f - half * y * y);
+    y = y * (1.5f - half * y * y);
+    return x * y;
+}
+
+/**
+ * @brief Branch-free sine and cosine for arguments in [0, 8192) (Cephes sinf/cosf).
+ */
+inline void fast_sincosf(float x, float& s, float& c) {
+    int32_t j = static_cast<int32_t>(x * 1.27323954473516f);  // 4 / pi
+    j = (j + 1) & ~1;
+    float y = static_cast<float>(j);
+    x = ((x - y * 0.78515625f) - y * 2.4187564849853515625e-4f) - y * 3.77489497744594108e-8f;
+
+    float z = x * x;
+    float sp = ((-1.9515295891e-4f * z + 8.3321608736e-3f) * z - 1.6666654611e-1f) * z * x + x;
+    float cp = ((2.443315711809948e-5f * z - 1.388731625493765e-3f) * z
+                + 4.166664568298827e-2f) * z * z - 0.5f * z + 1.0f;
+
+    // theta = q * pi/2 + x
+    int32_t q = (j >> 1) & 3;
+    float sin_abs = (q & 1) ? cp : sp;
+    float cos_abs = (q & 1) ? sp : cp;
+    s = (q & 2) ? -sin_abs : sin_abs;
+    c = ((q + 1) & 2) ? -cos_abs : cos_abs;
+}
+
+/**
+ * @brief Fill an array from a counter-based engine with a bulk kernel.
+ *
+ * Claims `ceil(W * size / 4)` counters from the engine, then calls
+ * `kernel(offset, begin, end)` for consecutive blocks of RANDOM_BLOCK
+ * elements. Blocks are independent, so the output is identical for any
+ * thread count.
+ *
+ * @tparam W Words consumed per element.
+ * @param arr Array to fill.
+ * @param eng Counter-based engine (advanced past the claimed counters).
+ * @param kernel Callable `(uint64_t offset, size_t begin, size_t end)`.
+ * @param parallel Whether to fill in parallel using OpenMP.
+ */
+template<size_t W, typename T, typename Kernel>
+void fill_counter_based(ndarray<T>& arr, Philox4x32& eng, Kernel kernel, bool parallel = false) {
+    const size_t n = arr.size();
+    const uint64_t offset = eng.reserve((n * W + 3) / 4);
+    const index_t blocks = static_cast<index_t>((n + RANDOM_BLOCK - 1) / RANDOM_BLOCK);
+#ifdef _OPENMP
+    #pragma omp parallel for if(parallel && blocks > 1)
+#else
+    (void)parallel;
+#endif
+    for (index_t b = 0; b < blocks; ++b) {
+        size_t begin = static_cast<size_t>(b) * RANDOM_BLOCK;
+        kernel(offset, begin, std::min(n, begin + RANDOM_BLOCK));
+    }
+}
+
+/**
+ * @brief Bulk uniform kernel: `[min_val, max_val)` from 24-bit (float) or 53-bit words.
+ */
+template<typename T>
+void philox_uniform_fill(ndarray<T>& arr, Philox4x32& eng, T min_val, T max_val, bool parallel) {
+    T* out = arr.data();
+    const T span = max_val - min_val;
+    if constexpr (std::is_same_v<T, float>) {
+        fill_counter_based<1>(arr, eng, [&](uint64_t offset, size_t begin, size_t end) {
+            philox_bulk<1>(eng, offset, begin, end, [&](const uint32_t* w, size_t count) {
+                T* dst = out + begin;
+                for (size_t j = 0; j < count; ++j) dst[j] = min_val + span * unit_float(w[j]);
+            });
+        }, parallel);
+    } else {
+        fill_counter_based<2>(arr, eng, [&](uint64_t offset, size_t begin, size_t end) {
+            philox_bulk<2>(eng, offset, begin, end, [&](const uint32_t* w, size_t count) {
+                T* dst = out + begin;
+                for (size_t j = 0; j < count; ++j)
+                    dst[j] = static_cast<T>(min_val + span * unit_double(w[2 * j], w[2 * j + 1]));
+            });
+        }, parallel);
+    }
+}
+
+/**
+ * @brief Bulk normal kernel: Box-Muller over pairs of elements.
+ *
+ * Each pair of elements shares one (u1, u2) draw and receives the cosine and
+ * sine branch respectively, so no sample is wasted and no rejection loop is
+ * needed. The float path uses the branch-free fast_logf/fast_sincosf so the
+ * transform vectorizes; other types use <cmath>.
+ *
+ * The float radius takes u1 from a full 32-bit word, so |z| reaches
+ * sqrt(64 ln 2) ~ 6.66 sigma; the double path draws 53-bit uniforms.
+ */
+template<typename T>
+void philox_normal_fill(ndarray<T>& arr, Philox4x32& eng, T mean, T stddev, bool parallel) {
+    constexpr size_t W = std::is_same_v<T, float> ? 1 : 2;
+    T* out = arr.data();
+    fill_counter_based<W>(arr, eng, [&](uint64_t offset, size_t begin, size_t end) {
+        // Generate words for whole pairs; an odd tail still has its partner word
+        // inside the claimed counters because the claim is rounded up to 4 words.
+        size_t pair_end = begin + ((end - begin + 1) & ~size_t(1));
+        philox_bulk<W>(eng, offset, begin, pair_end, [&](const uint32_t* w, size_t count) {
+            T* dst = out + begin;
+            const size_t pairs = count / 2;
+            const size_t valid = end - begin;
+            if constexpr (std::is_same_v<T, float>) {
+                constexpr float two_pi = 6.28318530717958647692f;
+                constexpr float scale = 1.0f / 16777216.0f;
+                constexpr float scale32 = 1.0f / 4294967296.0f;
+                auto pair = [&](size_t p, float& a, float& b) {
+                    float u1 = (static_cast<float>(w[2 * p]) + 1.0f) * scale32;  // (0, 1], tail from 32 bits
+                    float u2 = static_cast<float>(w[2 * p + 1] >> 8) * scale;     // [0, 1)
+                    float r = fast_sqrtf(-2.0f * fast_logf(u1));
+                    float sn, cs;
+                    fast_sincosf(two_pi * u2, sn, cs);
+                    a = mean + stddev * r * cs;
+                    b = mean + stddev * r * sn;
+                };
+                for (size_t p = 0; p < valid / 2; ++p) pair(p, dst[2 * p], dst[2 * p + 1]);
+                if (valid < count) {
+                    float unused;
+                    pair(pairs - 1, dst[valid - 1], unused);
+                }
+            } else {
+                constexpr double two_pi = 6.283185307179586476925286766559;
+                for (size_t p = 0; p < pairs; ++p) {
+                    const uint32_t* q = w + 4 * p;  // libm transcendentals: not vectorized
+                    double u1 = 1.0 - unit_double(q[0], q[1]);
+                    double u2 = unit_double(q[2], q[3]);
+                    double r = std::sqrt(-2.0 * std::log(u1));
+                    double theta = two_pi * u2;
+                    dst[2 * p] = static_cast<T>(mean + stddev * r * std::cos(theta));
+                    if (2 * p + 1 < valid)
+                        dst[2 * p + 1] = static_cast<T>(mean + stddev * r * std::sin(theta));
+                }
+            }
+        });
+    }, parallel);
+}
+
+/**
+ * @brief Bulk integer kernel using Lemire's nearly divisionless bounded mapping.
+ *
+ * `x * range` is split into a high part (the result) and a low part; only
+ * when the low part falls below `(2^k - range) % range` is the draw biased
+ * and retried. That threshold is computed once per fill, so the hot loop has
+ * no division at all. Retries read further sub-streams of the element's own
+ * counter, keeping results independent of thread count.
+ */
+template<typename T>
+void philox_randint_fill(ndarray<T>& arr, Philox4x32& eng, T min_val, T max_val, bool parallel) {
+    using U = std::make_unsigned_t<T>;
+    T* out = arr.data();
+    const U base = U(min_val);
+    // range == 0 encodes the full 2^64 span
+    const uint64_t range = uint64_t(U(U(max_val) - U(min_val))) + 1;
+
+    if (range != 0 && range <= (uint64_t(1) << 32)) {
+        const uint32_t threshold = static_cast<uint32_t>(((uint64_t(1) << 32) - range) % range);
+        fill_counter_based<1>(arr, eng, [&](uint64_t offset, size_t begin, size_t end) {
+            philox_bulk<1>(eng, offset, begin, end, [&](const uint32_t* w, size_t count) {
+                T* dst = out + begin;
+                size_t rejects = 0;
+                for (size_t j = 0; j < count; ++j) {
+                    uint64_t m = uint64_t(w[j]) * range;
+                    dst[j] = static_cast<T>(U(base + U(m >> 32)));
+                    rejects += static_cast<uint32_t>(m) < threshold;
+                }
+                for (size_t j = 0; rejects > 0 && j < count; ++j) {
+                    if (static_cast<uint32_t>(uint64_t(w[j]) * range) >= threshold) continue;
+                    uint64_t g = begin + j;
+                    for (uint32_t stream = 1;; ++stream) {
+                        uint64_t m = uint64_t(eng.block(offset + g / 4, stream)[g % 4]) * range;
+                        if (static_cast<uint32_t>(m) >= threshold) {
+                            dst[j] = static_cast<T>(U(base + U(m >> 32)));
+                            break;
+                        }
+                    }
+                    --rejects;
+                }
+            });
+        }, parallel);
+    } else {
+        const uint64_t threshold = range ? (0 - range) % range : 0;
+        fill_counter_based<2>(arr, eng, [&](uint64_t offset, size_t begin, size_t end) {
+            philox_bulk<2>(eng, offset, begin, end, [&](const uint32_t* w, size_t count) {
+                T* dst = out + begin;
+                for (size_t j = 0; j < count; ++j) {
+                    uint64_t x = (uint64_t(w[2 * j]) << 32) | w[2 * j + 1];
+                    if (range == 0) {
+                        dst[j] = static_cast<T>(U(x));
+                        continue;
+                    }
+                    uint64_t lo;
+                    uint64_t hi = mulhi64(x, range, lo);
+                    uint64_t g = 2 * (begin + j);
+                    for (uint32_t stream = 1; lo < threshold; ++stream) {
+                        Philox4x32::counter_type r = eng.block(offset + g / 4, stream);
+                        x = (uint64_t(r[g % 4]) << 32) | r[g % 4 + 1];
+                        hi = mulhi64(x, range, lo);
+                    }
+                    dst[j] = static_cast<T>(U(base + U(hi)));
+                }
+            });
+        }, parallel);
+    }
 }
 
 /**
  * @brief Fills an ndarray with random numbers from a given distribution.
- * 
- * This function can optionally fill the array in parallel using OpenMP
- * if `parallel` is true and the array is large.
- * 
+ *
+ * Stateful engines such as std::mt19937 produce a single sequential stream,
+ * so the array is always filled serially in index order; the `parallel`
+ * flag is accepted for API compatibility only. Use a counter-based engine
+ * (Philox4x32) for parallel generation.
+ *
  * @tparam T Type of the elements in the ndarray.
  * @tparam Dist Type of the random distribution (e.g., std::uniform_real_distribution).
  * @tparam Engine Type of the random engine.
  * @param arr Reference to the ndarray to fill.
  * @param dist Random distribution to generate numbers from.
  * @param eng Random engine to use for generating numbers.
- * @param parallel Whether to use parallel execution (default: false).
+ * @param parallel Ignored; see above.
  */
 template<typename T, typename Dist, typename Engine>
 void fill_ndarray(ndarray<T>& arr, Dist& dist, Engine& eng, bool parallel = false) {
-    if(parallel && arr.size() > 1000) { // arbitrary threshold
-#ifdef _OPENMP
-        #pragma omp parallel for
-        for(size_t i = 0; i < arr.size(); ++i) {
-            // Each thread uses the same engine (not ideal for perfect reproducibility)
-            arr[i] = dist(eng);
-        }
-#else
-        for(size_t i = 0; i < arr.size(); ++i)
-            arr[i] = dist(eng);
-#endif
-    } else {
-        for(size_t i = 0; i < arr.size(); ++i)
-            arr[i] = dist(eng);
-    }
+    (void)parallel;
+    T* out = arr.data();
+    for(size_t i = 0; i < arr.size(); ++i)
+        out[i] = dist(eng);
 }
 
 /**
  * @brief Generates an ndarray filled with random numbers from a uniform distribution.
- * 
+ *
+ * With the default counter-based engine each element depends only on the
+ * seed and its position, so parallel and serial fills give identical arrays.
+ *
  * @tparam T Floating-point type (default: float)
- * @tparam Engine Random engine type (default: std::mt19937)
+ * @tparam Engine Random engine type (default: Philox4x32)
  * @param shape Shape of the ndarray to generate.
  * @param min_val Minimum value of the distribution (inclusive, default: 0).
- * @param max_val Maximum value of the distribution (inclusive, default: 1).
- * @param eng Random engine to use (default: default_engine()).
+ * @param max_val Maximum value of the distribution (exclusive, default: 1).
+ * @param eng Random engine to use (default: default_counter_engine()).
  * @param parallel Whether to fill the array in parallel using OpenMP (default: false).
  * @return ndarray<T> Filled ndarray with random numbers.
  */
-template<typename T=float, typename Engine = std::mt19937>
-ndarray<T> uniform(const Shape& shape, T min_val = T{0}, T max_val = T{1}, 
-                   Engine& eng = default_engine(), bool parallel = false) {
+template<typename T=float, typename Engine = Philox4x32>
+ndarray<T> uniform(const Shape& shape, T min_val = T{0}, T max_val = T{1},
+                   Engine& eng = default_counter_engine(), bool parallel = false) {
     ndarray<T> arr(shape);
-    std::uniform_real_distribution<T> dist(min_val, max_val);
-    fill_ndarray(arr, dist, eng, parallel);
+    if constexpr (is_counter_based_v<Engine>) {
+        philox_uniform_fill(arr, eng, min_val, max_val, parallel);
+    } else {
+        std::uniform_real_distribution<T> dist(min_val, max_val);
+        fill_ndarray(arr, dist, eng, parallel);
+    }
     return arr;
 }
 
 /**
  * @brief Generates an ndarray filled with random numbers from a normal distribution.
- * 
+ *
  * @tparam T Floating-point type (default: float)
- * @tparam Engine Random engine type (default: std::mt19937)
+ * @tparam Engine Random engine type (default: Philox4x32)
  * @param shape Shape of the ndarray to generate.
  * @param mean Mean of the normal distribution (default: 0).
  * @param stddev Standard deviation of the normal distribution (default: 1).
- * @param eng Random engine to use (default: default_engine()).
+ * @param eng Random engine to use (default: default_counter_engine()).
  * @param parallel Whether to fill the array in parallel using OpenMP (default: false).
  * @return ndarray<T> Filled ndarray with random numbers.
  */
-template<typename T=float, typename Engine = std::mt19937>
-ndarray<T> normal(const Shape& shape, T mean = T{0}, T stddev = T{1}, 
-                  Engine& eng = default_engine(), bool parallel = false) {
+template<typename T=float, typename Engine = Philox4x32>
+ndarray<T> normal(const Shape& shape, T mean = T{0}, T stddev = T{1},
+                  Engine& eng = default_counter_engine(), bool parallel = false) {
     ndarray<T> arr(shape);
-    std::normal_distribution<T> dist(mean, stddev);
-    fill_ndarray(arr, dist, eng, parallel);
+    if constexpr (is_counter_based_v<Engine>) {
+        philox_normal_fill(arr, eng, mean, stddev, parallel);
+    } else {
+        std::normal_distribution<T> dist(mean, stddev);
+        fill_ndarray(arr, dist, eng, parallel);
+    }
     return arr;
 }
 
 /**
  * @brief Generates an ndarray filled with random integers from a uniform integer distribution.
- * 
+ *
  * @tparam T Integer type (default: int)
- * @tparam Engine Random engine type (default: std::mt19937)
+ * @tparam Engine Random engine type (default: Philox4x32)
  * @param shape Shape of the ndarray to generate.
  * @param min_val Minimum integer value (inclusive, default: std::numeric_limits<T>::min()).
  * @param max_val Maximum integer value (inclusive, default: std::numeric_limits<T>::max()).
- * @param eng Random engine to use (default: default_engine()).
+ * @param eng Random engine to use (default: default_counter_engine()).
  * @param parallel Whether to fill the array in parallel using OpenMP (default: false).
  * @return ndarray<T> Filled ndarray with random integers.
  */
-template<typename T=int, typename Engine = std::mt19937>
+template<typename T=int, typename Engine = Philox4x32>
 ndarray<T> randint(const Shape& shape, T min_val = std::numeric_limits<T>::min(),
-                   T max_val = std::numeric_limits<T>::max(), 
-                   Engine& eng = default_engine(), bool parallel = false) {
+                   T max_val = std::numeric_limits<T>::max(),
+                   Engine& eng = default_counter_engine(), bool parallel = false) {
     ndarray<T> arr(shape);
-    std::uniform_int_distribution<T> dist(min_val, max_val);
-    fill_ndarray(arr, dist, eng, parallel);
+    if constexpr (is_counter_based_v<Engine>) {
+        philox_randint_fill(arr, eng, min_val, max_val, parallel);
+    } else {
+        std::uniform_int_distribution<T> dist(min_val, max_val);
+        fill_ndarray(arr, dist, eng, parallel);
+    }
     return arr;
 }
 
@@ -0,0 +1,353 @@
+/**
+ * @file small_vector.hpp
+ * @brief Vector with inline storage for a small number of elements.
+ *
+ * Provides SmallVector, the container behind Shape, Strides and Indices:
+ *   - Up to N elements live inside the object itself, so creating or
+ *     copying the metadata of an array with few dimensions never touches
+ *     the heap
+ *   - Larger sizes spill to a heap buffer transparently
+ *   - The interface is the subset of std::vector used for shapes, and
+ *     converts implicitly to and from std::vector for compatibility
+ *
+ * @namespace numbits
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace numbits {
+
+/**
+ * @class SmallVector
+ * @brief Contiguous sequence that stores up to `N` elements inline.
+ *
+ * Behaves like std::vector for the operations used on shapes and indices
+ * (size/index access, iteration, push_back, insert, erase, resize,
+ * comparison). Iterators are raw pointers and are invalidated by any
+ * operation that changes the size.
+ *
+ * @code
+ * SmallVector<size_t, 8> shape = {3, 4};   // no allocation
+ * shape.push_back(5);                      // still inline
+ * std::vector<size_t> v = shape;           // converts when needed
+ * @endcode
+ *
+ * @tparam T Trivially copyable element type.
+ * @tparam N Inline capacity.
+ */
+template<typename T, std::size_t N>
+class SmallVector {
+    static_assert(std::is_trivially_copyable_v<T>, "SmallVector requires a trivially copyable type");
+    static_assert(N > 0, "SmallVector requires a positive inline capacity");
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using iterator = T*;
+    using const_iterator = const T*;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    /** @brief Construct an empty vector. */
+    SmallVector() noexcept : data_(inline_), size_(0), capacity_(N) {}
+
+    /** @brief Construct `count` value-initialized elements. */
+    explicit SmallVector(size_type count) : SmallVector() { resize(count); }
+
+    /** @brief Construct `count` copies of `value`. */
+    SmallVector(size_type count, const T& value) : SmallVector() { resize(count, value); }
+
+    /** @brief Construct from an initializer list. */
+    SmallVector(std::initializer_list<T> init) : SmallVector() {
+        assign(init.begin(), init.end());
+    }
+
+    /** @brief Construct from an iterator range. */
+    template<typename InputIt,
+             typename = std::enable_if_t<!std::is_integral_v<InputIt>>>
+    SmallVector(InputIt first, InputIt last) : SmallVector() {
+        assign(first, last);
+    }
+
+    /** @brief Implicit conversion from std::vector, for API compatibility. */
+    SmallVector(const std::vector<T>& other) : SmallVector() {
+        assign(other.begin(), other.end());
+    }
+
+    SmallVector(const SmallVector& other) : SmallVector() {
+        assign(other.begin(), other.end());
+    }
+
+    SmallVector(SmallVector&& other) noexcept : SmallVector() {
+        steal(other);
+    }
+
+    SmallVector& operator=(const SmallVector& other) {
+        if (this != &other) assign(other.begin(), other.end());
+        return *this;
+    }
+
+    SmallVector& operator=(SmallVector&& other) noexcept {
+        if (this != &other) {
+            release();
+            steal(other);
+        }
+        return *this;
+    }
+
+    SmallVector& operator=(std::initializer_list<T> init) {
+        assign(init.begin(), init.end());
+        return *this;
+    }
+
+    ~SmallVector() { release(); }
+
+    /** @brief Implicit conversion to std::vector, for API compatibility. */
+    operator std::vector<T>() const { return std::vector<T>(begin(), end()); }
+
+    /** @return A std::vector holding the same elements. */
+    std::vector<T> to_vector() const { return std::vector<T>(begin(), end()); }
+
+    // ------------------------------------------------------------------
+    // Capacity
+    // ------------------------------------------------------------------
+
+    size_type size() const noexcept { return size_; }
+    size_type capacity() const noexcept { return capacity_; }
+    bool empty() const noexcept { return size_ == 0; }
+
+    /** @return true while the elements live in the inline buffer. */
+    bool is_inline() const noexcept { return data_ == inline_; }
+
+    /** @return The inline capacity `N`. */
+    static constexpr size_type inline_capacity() noexcept { return N; }
+
+    /** @brief Ensure room for at least `new_cap` elements. */
+    void reserve(size_type new_cap) {
+        if (new_cap <= capacity_) return;
+        T* buffer = new T[new_cap];
+        std::copy(data_, data_ + size_, buffer);
+        if (data_ != inline_) delete[] data_;
+        data_ = buffer;
+        capacity_ = new_cap;
+    }
+
+    // ------------------------------------------------------------------
+    // Element access
+    // ------------------------------------------------------------------
+
+    T& operator[](size_type i) noexcept { return data_[i]; }
+    const T& operator[](size_type i) const noexcept { return data_[i]; }
+
+    /** @throws std::out_of_range if `i >= size()`. */
+    T& at(size_type i) {
+        if (i >= size_) throw std::out_of_range("SmallVector index out of range");
+        return data_[i];
+    }
+
+    /** @throws std::out_of_range if `i >= size()`. */
+    const T& at(size_type i) const {
+        if (i >= size_) throw std::out_of_range("SmallVector index out of range");
+        return data_[i];
+    }
+
+    T& front() noexcept { return data_[0]; }
+    const T& front() const noexcept { return data_[0]; }
+    T& back() noexcept { return data_[size_ - 1]; }
+    const T& back() const noexcept { return data_[size_ - 1]; }
+    T* data() noexcept { return data_; }
+    const T* data() const noexcept { return data_; }
+
+    // ------------------------------------------------------------------
+    // Iterators
+    // ------------------------------------------------------------------
+
+    iterator begin() noexcept { return data_; }
+    const_iterator begin() const noexcept { return data_; }
+    const_iterator cbegin() const noexcept { return data_; }
+    iterator end() noexcept { return data_ + size_; }
+    const_iterator end() const noexcept { return data_ + size_; }
+    const_iterator cend() const noexcept { return data_ + size_; }
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+    // ------------------------------------------------------------------
+    // Modifiers
+    // ------------------------------------------------------------------
+
+    void clear() noexcept { size_ = 0; }
+
+    /** @brief Replace the contents with the range [first, last). */
+    template<typename InputIt>
+    void assign(InputIt first, InputIt last) {
+        clear();
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag,
+                          typename std::iterator_traits<InputIt>::iterator_category>) {
+            reserve(static_cast<size_type>(std::distance(first, last)));
+        }
+        for (; first != last; ++first) push_back(*first);
+    }
+
+    /** @brief Replace the contents with `count` copies of `value`. */
+    void assign(size_type count, const T& value) {
+        clear();
+        resize(count, value);
+    }
+
+    void push_back(const T& value) {
+        if (size_ == capacity_) {
+            T copy = value;  // value may alias an element
+            grow(size_ + 1);
+            data_[size_++] = copy;
+        } else {
+            data_[size_++] = value;
+        }
+    }
+
+    template<typename... Args>
+    T& emplace_back(Args&&... args) {
+        push_back(T(std::forward<Args>(args)...));
+        return back();
+    }
+
+    void pop_back() noexcept { --size_; }
+
+    /** @brief Resize, value-initializing new elements. */
+    void resize(size_type count) { resize(count, T{}); }
+
+    /** @brief Resize, filling new elements with `value`. */
+    void resize(size_type count, const T& value) {
+        if (count > capacity_) {
+            T copy = value;
+            grow(count);
+            std::fill(data_ + size_, data_ + count, copy);
+        } else if (count > size_) {
+            std::fill(data_ + size_, data_ + count, value);
+        }
+        size_ = count;
+    }
+
+    /** @brief Insert `value` before `pos`. */
+    iterator insert(const_iterator pos, const T& value) {
+        return insert(pos, size_type(1), value);
+    }
+
+    /** @brief Insert `count` copies of `value` before `pos`. */
+    iterator insert(const_iterator pos, size_type count, const T& value) {
+        size_type idx = static_cast<size_type>(pos - data_);
+        T copy = value;
+        make_gap(idx, count);
+        std::fill(data_ + idx, data_ + idx + count, copy);
+        return data_ + idx;
+    }
+
+    /** @brief Insert the range [first, last) before `pos`. */
+    template<typename InputIt,
+             typename = std::enable_if_t<!std::is_integral_v<InputIt>>>
+    iterator insert(const_iterator pos, InputIt first, InputIt last) {
+        size_type idx = static_cast<size_type>(pos - data_);
+        SmallVector tmp(first, last);  // the range may alias *this
+        make_gap(idx, tmp.size());
+        std::copy(tmp.begin(), tmp.end(), data_ + idx);
+        return data_ + idx;
+    }
+
+    /** @brief Insert an initializer list before `pos`. */
+    iterator insert(const_iterator pos, std::initializer_list<T> init) {
+        return insert(pos, init.begin(), init.end());
+    }
+
+    /** @brief Remove the element at `pos`. */
+    iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+
+    /** @brief Remove the elements in [first, last). */
+    iterator erase(const_iterator first, const_iterator last) {
+        size_type idx = static_cast<size_type>(first - data_);
+        size_type count = static_cast<size_type>(last - first);
+        std::copy(data_ + idx + count, data_ + size_, data_ + idx);
+        size_ -= count;
+        return data_ + idx;
+    }
+
+    void swap(SmallVector& other) noexcept {
+        SmallVector tmp(std::move(other));
+        other = std::move(*this);
+        *this = std::move(tmp);
+    }
+
+    // ------------------------------------------------------------------
+    // Comparison
+    // ------------------------------------------------------------------
+
+    friend bool operator==(const SmallVector& a, const SmallVector& b) {
+        return a.size_ == b.size_ && std::equal(a.begin(), a.end(), b.begin());
+    }
+
+    friend bool operator!=(const SmallVector& a, const SmallVector& b) { return !(a == b); }
+
+    friend bool operator<(const SmallVector& a, const SmallVector& b) {
+        return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end());
+    }
+
+    friend bool operator>(const SmallVector& a, const SmallVector& b) { return b < a; }
+    friend bool operator<=(const SmallVector& a, const SmallVector& b) { return !(b < a); }
+    friend bool operator>=(const SmallVector& a, const SmallVector& b) { return !(a < b); }
+
+private:
+    /** @brief Grow capacity geometrically to hold at least `min_cap` elements. */
+    void grow(size_type min_cap) {
+        reserve(std::max(min_cap, capacity_ * 2));
+    }
+
+    /** @brief Open `count` uninitialized slots at `idx`. */
+    void make_gap(size_type idx, size_type count) {
+        if (size_ + count > capacity_) grow(size_ + count);
+        std::copy_backward(data_ + idx, data_ + size_, data_ + size_ + count);
+        size_ += count;
+    }
+
+    /** @brief Free the heap buffer, if any, and return to inline storage. */
+    void release() noexcept {
+        if (data_ != inline_) delete[] data_;
+        data_ = inline_;
+        capacity_ = N;
+        size_ = 0;
+    }
+
+    /** @brief Take over the contents of `other`, leaving it empty. Requires *this to be empty and inline. */
+    void steal(SmallVector& other) noexcept {
+        if (other.data_ == other.inline_) {
+            std::copy(other.inline_, other.inline_ + other.size_, inline_);
+        } else {
+            data_ = other.data_;
+            capacity_ = other.capacity_;
+            other.data_ = other.inline_;
+            other.capacity_ = N;
+        }
+        size_ = other.size_;
+        other.size_ = 0;
+    }
+
+    T inline_[N];
+    T* data_;
+    size_type size_;
+    size_type capacity_;
+};
+
+} // namespace numbits
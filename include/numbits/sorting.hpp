@@ -0,0 +1,739 @@
+/**
+ * @file sorting.hpp
+ * @brief Sorting, partitioning and top-k selection along an axis.
+ *
+ * Provides:
+ *   - sort(), argsort(): full sorts along an axis (argsort is stable)
+ *   - partition(), argpartition(): introselect around the k-th element
+ *   - topk(): k largest or smallest elements per lane, with indices
+ *   - searchsorted(): insertion points of values into a sorted 1D array
+ *
+ * Integer and floating-point lanes of at least RADIX_SORT_MIN elements use
+ * an LSD radix sort on order-preserving integer keys, skipping byte
+ * passes in which all keys agree. Large 1D inputs are split into one
+ * chunk per thread, sorted concurrently and merged pairwise in parallel.
+ * Independent lanes of N-D arrays are processed in parallel.
+ *
+ * NaN sorts after every other value, as in NumPy, and therefore counts as
+ * the largest value for topk().
+ *
+ * @namespace numbits
+ */
+
+#pragma once
+
+#include "ndarray.hpp"
+#include "indexing.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <type_traits>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace numbits {
+
+/**
+ * @brief Minimum lane length for which the radix sort is used.
+ */
+constexpr size_t RADIX_SORT_MIN = 256;
+
+/**
+ * @brief Minimum 1D length for which the parallel merge sort is used.
+ */
+constexpr size_t PARALLEL_SORT_MIN = size_t(1) << 16;
+
+/**
+ * @brief Minimum number of bytes processed before lanes are sorted in parallel.
+ */
+constexpr size_t SORT_PARALLEL_BYTES = size_t(1) << 16;
+
+/**
+ * @brief Minimum number of query values searched in parallel.
+ */
+constexpr size_t SEARCH_PARALLEL_MIN = size_t(1) << 14;
+
+/**
+ * @brief True if `v` is a floating-point NaN; always false for other types.
+ */
+template<typename T>
+inline bool is_nan_value(const T& v) {
+    if constexpr (std::is_floating_point_v<T>) {
+        return std::isnan(v);
+    } else {
+        (void)v;
+        return false;
+    }
+}
+
+/**
+ * @brief Strict weak ordering that places NaN after all other values.
+ */
+template<typename T>
+inline bool sort_less(const T& a, const T& b) {
+    return !is_nan_value(a) && (is_nan_value(b) || a < b);
+}
+
+/**
+ * @brief True for element types handled by the radix sort.
+ */
+template<typename T>
+constexpr bool radix_sortable_v = std::is_arithmetic_v<T> && !std::is_same_v<T, bool> &&
+                                  (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
+
+/**
+ * @brief Unsigned key type of the radix sort for `T`.
+ */
+template<typename T>
+using radix_key_t = std::conditional_t<(sizeof(T) <= 4), uint32_t, uint64_t>;
+
+/**
+ * @brief Map a value to an unsigned key with the same order.
+ *
+ * Signed integers flip the sign bit. Floats flip all bits when negative
+ * and the sign bit otherwise; NaN maps to the largest key.
+ */
+template<typename T>
+inline radix_key_t<T> radix_key(T v) {
+    using K = radix_key_t<T>;
+    constexpr K sign = K(1) << (8 * sizeof(T) - 1);
+    if constexpr (std::is_floating_point_v<T>) {
+        if (std::isnan(v)) return ~K(0);
+        K bits;
+        std::memcpy(&bits, &v, sizeof(T));
+        return (bits & sign) ? ~bits : (bits | sign);
+    } else if constexpr (std::is_signed_v<T>) {
+        return K(static_cast<std::make_unsigned_t<T>>(v)) ^ sign;
+    } else {
+        return K(v);
+    }
+}
+
+/**
+ * @brief Inverse of radix_key().
+ */
+template<typename T>
+inline T radix_value(radix_key_t<T> k) {
+    using K = radix_key_t<T>;
+    constexpr K sign = K(1) << (8 * sizeof(T) - 1);
+    if constexpr (std::is_floating_point_v<T>) {
+        K bits = (k & sign) ? (k ^ sign) : ~k;
+        T v;
+        std::memcpy(&v, &bits, sizeof(T));
+        return v;
+    } else if constexpr (std::is_signed_v<T>) {
+        return static_cast<T>(static_cast<std::make_unsigned_t<T>>(k ^ sign));
+    } else {
+        return static_cast<T>(k);
+    }
+}
+
+/**
+ * @brief Per-thread buffers reused across the lanes a thread sorts.
+ */
+template<typename T>
+struct SortScratch {
+    std::vector<T> values;
+    std::vector<int64_t> indices;
+    std::vector<int64_t> indices_tmp;
+    std::vector<radix_key_t<T>> keys;
+    std::vector<radix_key_t<T>> keys_tmp;
+};
+
+/**
+ * @brief Stable LSD radix sort of `n` values with 8-bit digits.
+ *
+ * With `idx == nullptr` the values are sorted in place. Otherwise `v` is
+ * left untouched and `idx` (holding the original positions) is permuted
+ * into sorted order. In that mode -0.0 and +0.0 share a key, since they
+ * compare equal and must keep their original order; sorting values keeps
+ * their distinct keys so both zeros are reconstructed exactly.
+ */
+template<typename T>
+void radix_sort(T* v, size_t n, int64_t* idx, SortScratch<T>& scratch) {
+    using K = radix_key_t<T>;
+    constexpr size_t passes = sizeof(T);
+    scratch.keys.resize(n);
+    scratch.keys_tmp.resize(n);
+    if (idx) scratch.indices_tmp.resize(n);
+
+    size_t counts[passes][256] = {};
+    K* src = scratch.keys.data();
+    for (size_t i = 0; i < n; ++i) {
+        T x = v[i];
+        if constexpr (std::is_floating_point_v<T>) {
+            if (idx && x == T(0)) x = T(0);  // fold -0.0 onto +0.0
+        }
+        K k = radix_key(x);
+        src[i] = k;
+        for (size_t p = 0; p < passes; ++p) ++counts[p][(k >> (8 * p)) & 0xFF];
+    }
+
+    K* dst = scratch.keys_tmp.data();
+    int64_t* isrc = idx;
+    int64_t* idst = idx ? scratch.indices_tmp.data() : nullptr;
+    for (size_t p = 0; p < passes; ++p) {
+        const size_t shift = 8 * p;
+        if (counts[p][(src[0] >> shift) & 0xFF] == n) continue;  // all keys share this digit
+
+        size_t offsets[256];
+        size_t sum = 0;
+        for (size_t d = 0; d < 256; ++d) {
+            offsets[d] = sum;
+            sum += counts[p][d];
+        }
+        if (idx) {
+            for (size_t i = 0; i < n; ++i) {
+                size_t pos = offsets[(src[i] >> shift) & 0xFF]++;
+                dst[pos] = src[i];
+                idst[pos] = isrc[i];
+            }
+            std::swap(isrc, idst);
+        } else {
+            for (size_t i = 0; i < n; ++i) dst[offsets[(src[i] >> shift) & 0xFF]++] = src[i];
+        }
+        std::swap(src, dst);
+    }
+
+    if (idx) {
+        if (isrc != idx) std::copy(isrc, isrc + n, idx);
+    } else {
+        for (size_t i = 0; i < n; ++i) v[i] = radix_value<T>(src[i]);
+    }
+}
+
+/**
+ * @brief Sort a contiguous lane in place.
+ */
+template<typename T>
+void sort_lane(T* v, size_t n, SortScratch<T>& scratch) {
+    if constexpr (radix_sortable_v<T>) {
+        if (n >= RADIX_SORT_MIN) {
+            radix_sort(v, n, static_cast<int64_t*>(nullptr), scratch);
+            return;
+        }
+    }
+    (void)scratch;
+    std::sort(v, v + n, sort_less<T>);
+}
+
+/**
+ * @brief Write the stable sorting permutation of a contiguous lane to `idx`.
+ */
+template<typename T>
+void argsort_lane(const T* v, size_t n, int64_t* idx, SortScratch<T>& scratch) {
+    std::iota(idx, idx + n, int64_t(0));
+    if constexpr (radix_sortable_v<T>) {
+        if (n >= RADIX_SORT_MIN) {
+            radix_sort(const_cast<T*>(v), n, idx, scratch);
+            return;
+        }
+    }
+    (void)scratch;
+    std::stable_sort(idx, idx + n, [v](int64_t a, int64_t b) { return sort_less(v[a], v[b]); });
+}
+
+/**
+ * @brief Sort `n` elements by sorting one chunk per thread, then merging pairwise.
+ *
+ * `chunk_sort(lo, hi)` sorts `data[lo, hi)`; `less` orders the elements.
+ * Merges take from the left run on ties, so the result is stable whenever
+ * the chunk sorts are. Falls back to a single chunk_sort call with one
+ * thread or small inputs.
+ */
+template<typename E, typename Less, typename ChunkSort>
+void parallel_merge_sort(E* data, size_t n, Less less, ChunkSort chunk_sort) {
+    size_t chunks = 1;
+#ifdef _OPENMP
+    chunks = static_cast<size_t>(omp_get_max_threads());
+#endif
+    if (chunks <= 1 || n < PARALLEL_SORT_MIN) {
+        chunk_sort(size_t(0), n);
+        return;
+    }
+
+    std::vector<size_t> bounds(chunks + 1);
+    for (size_t c = 0; c <= chunks; ++c) bounds[c] = n * c / chunks;
+
+    const index_t nc = static_cast<index_t>(chunks);
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(static)
+#endif
+    for (index_t c = 0; c < nc; ++c) chunk_sort(bounds[c], bounds[c + 1]);
+
+    std::vector<E> tmp(n);
+    E* src = data;
+    E* dst = tmp.data();
+    for (size_t width = 1; width < chunks; width *= 2) {
+        const index_t pairs = static_cast<index_t>((chunks + 2 * width - 1) / (2 * width));
+#ifdef _OPENMP
+        #pragma omp parallel for schedule(static)
+#endif
+        for (index_t p = 0; p < pairs; ++p) {
+            size_t first = 2 * width * static_cast<size_t>(p);
+            size_t a = bounds[first];
+            size_t m = bounds[std::min(chunks, first + width)];
+            size_t b = bounds[std::min(chunks, first + 2 * width)];
+            std::merge(src + a, src + m, src + m, src + b, dst + a, less);
+        }
+        std::swap(src, dst);
+    }
+    if (src != data) std::copy(src, src + n, data);
+}
+
+/**
+ * @brief Run `fn(scratch, base)` for every lane along an axis.
+ *
+ * Lane elements are `data[base + j * split.inner]` for `j < split.len`.
+ * Lanes are distributed over threads when the array is large; each thread
+ * owns one Scratch object reused across its lanes.
+ */
+template<typename Scratch, typename Fn>
+void for_each_lane(const AxisSplit& split, bool parallel, Fn fn) {
+    const index_t lanes = static_cast<index_t>(split.outer * split.inner);
+    (void)parallel;
+#ifdef _OPENMP
+    #pragma omp parallel if(parallel && lanes > 1)
+#endif
+    {
+        Scratch scratch;
+#ifdef _OPENMP
+        #pragma omp for schedule(static)
+#endif
+        for (index_t lane = 0; lane < lanes; ++lane) {
+            size_t o = static_cast<size_t>(lane) / split.inner;
+            size_t i = static_cast<size_t>(lane) % split.inner;
+            fn(scratch, o * split.len * split.inner + i);
+        }
+    }
+}
+
+/**
+ * @brief Copy a strided lane into a contiguous buffer.
+ */
+template<typename T>
+inline void load_lane(const T* src, size_t len, size_t stride, T* dst) {
+    for (size_t j = 0; j < len; ++j) dst[j] = src[j * stride];
+}
+
+/**
+ * @brief Copy a contiguous buffer into a strided lane.
+ */
+template<typename T>
+inline void store_lane(const T* src, size_t len, size_t stride, T* dst) {
+    for (size_t j = 0; j < len; ++j) dst[j * stride] = src[j];
+}
+
+/**
+ * @brief Return a sorted copy of an array along an axis.
+ *
+ * Matches NumPy `sort`. NaN values are placed at the end.
+ *
+ * @code
+ * auto ranked = sort(scores);        // each row sorted ascending
+ * auto by_col = sort(scores, 0);     // each column sorted ascending
+ * @endcode
+ *
+ * @param arr Input array
+ * @param axis Axis to sort along; negative values count from the end (default: last)
+ * @return ndarray<T> Sorted array of the same shape
+ *
+ * @throws std::runtime_error If axis is out of range
+ */
+template<typename T>
+ndarray<T> sort(const ndarray<T>& arr, int axis = -1) {
+    const size_t ax = normalize_axis(axis, arr.ndim());
+    AxisSplit split = split_axis(arr.shape(), ax);
+    ndarray<T> result = arr;
+    if (result.size() == 0) return result;
+    T* out = result.data();
+    const size_t len = split.len, inner = split.inner;
+
+    if (split.outer * inner == 1) {
+        parallel_merge_sort(out, len, sort_less<T>, [out](size_t lo, size_t hi) {
+            SortScratch<T> scratch;
+            sort_lane(out + lo, hi - lo, scratch);
+        });
+        return result;
+    }
+
+    const bool parallel = arr.size() * sizeof(T) >= SORT_PARALLEL_BYTES;
+    for_each_lane<SortScratch<T>>(split, parallel, [&](SortScratch<T>& s, size_t base) {
+        if (inner == 1) {
+            sort_lane(out + base, len, s);
+        } else {
+            s.values.resize(len);
+            load_lane(out + base, len, inner, s.values.data());
+            sort_lane(s.values.data(), len, s);
+            store_lane(s.values.data(), len, inner, out + base);
+        }
+    });
+    return result;
+}
+
+/**
+ * @brief Indices that sort an array along an axis.
+ *
+ * Matches NumPy `argsort(kind="stable")`: equal elements keep their
+ * original order.
+ *
+ * @param arr Input array
+ * @param axis Axis to sort along; negative values count from the end (default: last)
+ * @return ndarray<int64_t> Positions along `axis`, same shape as `arr`
+ *
+ * @throws std::runtime_error If axis is out of range
+ */
+template<typename T>
+ndarray<int64_t> argsort(const ndarray<T>& arr, int axis = -1) {
+    const size_t ax = normalize_axis(axis, arr.ndim());
+    AxisSplit split = split_axis(arr.shape(), ax);
+    ndarray<int64_t> result(arr.shape());
+    if (result.size() == 0) return result;
+    const T* src = arr.data();
+    int64_t* out = result.data();
+    const size_t len = split.len, inner = split.inner;
+
+    if (split.outer * inner == 1) {
+        auto less = [src](int64_t a, int64_t b) { return sort_less(src[a], src[b]); };
+        parallel_merge_sort(out, len, less, [src, out](size_t lo, size_t hi) {
+            SortScratch<T> scratch;
+            argsort_lane(src + lo, hi - lo, out + lo, scratch);
+            for (size_t j = lo; j < hi; ++j) out[j] += static_cast<int64_t>(lo);
+        });
+        return result;
+    }
+
+    const bool parallel = arr.size() * sizeof(T) >= SORT_PARALLEL_BYTES;
+    for_each_lane<SortScratch<T>>(split, parallel, [&](SortScratch<T>& s, size_t base) {
+        if (inner == 1) {
+            argsort_lane(src + base, len, out + base, s);
+        } else {
+            s.values.resize(len);
+            s.indices.resize(len);
+            load_lane(src + base, len, inner, s.values.data());
+            argsort_lane(s.values.data(), len, s.indices.data(), s);
+            store_lane(s.indices.data(), len, inner, out + base);
+        }
+    });
+    return result;
+}
+
+/**
+ * @brief Partially sort an array so that position `kth` holds its sorted value.
+ *
+ * Matches NumPy `partition`: along `axis`, every element before `kth` is
+ * not greater and every element after it is not smaller; the order within
+ * each side is unspecified. Runs in linear expected time (introselect).
+ *
+ * @throws std::runtime_error If axis is out of range
+ * @throws std::out_of_range If kth is not less than the axis length
+ */
+template<typename T>
+ndarray<T> partition(const ndarray<T>& arr, size_t kth, int axis = -1) {
+    const size_t ax = normalize_axis(axis, arr.ndim());
+    AxisSplit split = split_axis(arr.shape(), ax);
+    if (kth >= split.len) throw std::out_of_range("partition: kth out of range");
+    ndarray<T> result = arr;
+    T* out = result.data();
+    const size_t len = split.len, inner = split.inner;
+    const bool parallel = arr.size() * sizeof(T) >= SORT_PARALLEL_BYTES;
+
+    for_each_lane<SortScratch<T>>(split, parallel, [&](SortScratch<T>& s, size_t base) {
+        T* lane = out + base;
+        if (inner != 1) {
+            s.values.resize(len);
+            load_lane(out + base, len, inner, s.values.data());
+            lane = s.values.data();
+        }
+        std::nth_element(lane, lane + kth, lane + len, sort_less<T>);
+        if (inner != 1) store_lane(lane, len, inner, out + base);
+    });
+    return result;
+}
+
+/**
+ * @brief Indices that partition an array around position `kth`.
+ *
+ * Matches NumPy `argpartition`.
+ *
+ * @throws std::runtime_error If axis is out of range
+ * @throws std::out_of_range If kth is not less than the axis length
+ */
+template<typename T>
+ndarray<int64_t> argpartition(const ndarray<T>& arr, size_t kth, int axis = -1) {
+    const size_t ax = normalize_axis(axis, arr.ndim());
+    AxisSplit split = split_axis(arr.shape(), ax);
+    if (kth >= split.len) throw std::out_of_range("argpartition: kth out of range");
+    ndarray<int64_t> result(arr.shape());
+    const T* src = arr.data();
+    int64_t* out = result.data();
+    const size_t len = split.len, inner = split.inner;
+    const bool parallel = arr.size() * sizeof(T) >= SORT_PARALLEL_BYTES;
+
+    for_each_lane<SortScratch<T>>(split, parallel, [&](SortScratch<T>& s, size_t base) {
+        s.indices.resize(len);
+        int64_t* idx = s.indices.data();
+        std::iota(idx, idx + len, int64_t(0));
+        const T* lane = src + base;
+        std::nth_element(idx, idx + kth, idx + len, [lane, inner](int64_t a, int64_t b) {
+            return sort_less(lane[a * static_cast<int64_t>(inner)], lane[b * static_cast<int64_t>(inner)]);
+        });
+        store_lane(idx, len, inner, out + base);
+    });
+    return result;
+}
+
+/**
+ * @struct TopK
+ * @brief Values and positions returned by topk().
+ */
+template<typename T>
+struct TopK {
+    ndarray<T> values;        ///< Selected values
+    ndarray<int64_t> indices; ///< Their positions along the axis
+};
+
+/**
+ * @brief The `k` largest (or smallest) elements along an axis.
+ *
+ * Matches `torch.topk`. For each lane, when `k` is small relative to the
+ * lane length a bounded heap of the best `k` candidates is kept, so most
+ * elements cost one comparison against the heap root; otherwise the lane
+ * is introselected. Ties are broken in favour of the lower index.
+ *
+ * @code
+ * auto best = topk(scores, 10);      // scores: {B, 100000}
+ * // best.values, best.indices: {B, 10}, best first
+ * @endcode
+ *
+ * @param arr Input array
+ * @param k Number of elements to select (at most the axis length)
+ * @param axis Axis to select along; negative values count from the end (default: last)
+ * @param largest Select the largest elements if true, the smallest otherwise
+ * @param sorted Return the selection ordered best first if true
+ * @return TopK<T> Values and int64 indices, with `axis` of length `k`
+ *
+ * @throws std::runtime_error If axis is out of range
+ * @throws std::out_of_range If k exceeds the axis length
+ */
+template<typename T>
+TopK<T> topk(const ndarray<T>& arr, size_t k, int axis = -1, bool largest = true, bool sorted = true) {
+    const size_t ax = normalize_axis(axis, arr.ndim());
+    AxisSplit split = split_axis(arr.shape(), ax);
+    if (k > split.len) throw std::out_of_range("topk: k larger than axis length");
+
+    Shape out_shape = arr.shape();
+    out_shape[ax] = k;
+    TopK<T> result{ndarray<T>(out_shape), ndarray<int64_t>(out_shape)};
+    if (k == 0 || result.values.size() == 0) return result;
+
+    const T* src = arr.data();
+    T* out_values = result.values.data();
+    int64_t* out_indices = result.indices.data();
+    const size_t len = split.len, inner = split.inner;
+    const bool use_heap = k * 16 <= len;
+    const bool parallel = arr.size() * sizeof(T) >= SORT_PARALLEL_BYTES;
+
+    // Lane j comes before lane m in the result when better(j, m)
+    auto better = [largest](const T& a, int64_t ia, const T& b, int64_t ib) {
+        if (sort_less(a, b)) return !largest;
+        if (sort_less(b, a)) return largest;
+        return ia < ib;
+    };
+
+    for_each_lane<SortScratch<T>>(split, parallel, [&](SortScratch<T>& s, size_t base) {
+        const T* lane = src + base;
+        auto value = [lane, inner](int64_t j) { return lane[j * static_cast<int64_t>(inner)]; };
+        auto cmp = [&](int64_t a, int64_t b) { return better(value(a), a, value(b), b); };
+
+        s.indices.resize(use_heap ? k : len);
+        int64_t* idx = s.indices.data();
+        if (use_heap) {
+            // Max-heap under `cmp` keeps the worst retained candidate at the root
+            std::iota(idx, idx + k, int64_t(0));
+            std::make_heap(idx, idx + k, cmp);
+            // Later candidates lose ties, so only values strictly better than
+            // the root enter. Between root changes, a tight loop skips the
+            // rejected values with a single comparison each (`v <= worst`
+            // is false for NaN, which counts as largest).
+            const T* p = lane;
+            const size_t stride = inner, n = len, kk = k;
+            T worst = value(idx[0]);
+            size_t j = kk;
+            while (j < n) {
+                if (largest) {
+                    if (is_nan_value(worst)) break;
+                    while (j < n && p[j * stride] <= worst) ++j;
+                } else if (is_nan_value(worst)) {
+                    while (j < n && is_nan_value(p[j * stride])) ++j;
+                } else {
+                    while (j < n && !(p[j * stride] < worst)) ++j;
+                }
+                if (j == n) break;
+                std::pop_heap(idx, idx + kk, cmp);
+                idx[kk - 1] = static_cast<int64_t>(j);
+                std::push_heap(idx, idx + kk, cmp);
+                worst = value(idx[0]);
+                ++j;
+            }
+            if (sorted) std::sort_heap(idx, idx + k, cmp);
+        } else {
+            std::iota(idx, idx + len, int64_t(0));
+            if (k < len) std::nth_element(idx, idx + (k - 1), idx + len, cmp);
+            if (sorted) std::sort(idx, idx + k, cmp);
+        }
+
+        const size_t out_base = (base / (len * inner)) * k * inner + base % inner;
+        for (size_t j = 0; j < k; ++j) {
+            out_indices[out_base + j * inner] = idx[j];
+            out_values[out_base + j * inner] = value(idx[j]);
+        }
+    });
+    return result;
+}
+
+/**
+ * @brief Which insertion point searchsorted() reports for values equal to an element.
+ */
+enum class SearchSide {
+    Left,   ///< First index `i` with `v <= a[i]`
+    Right   ///< First index `i` with `v < a[i]`
+};
+
+/**
+ * @brief True while `x` belongs before the insertion point of a non-NaN `v`.
+ *
+ * NaN `x` compares false either way, which matches NaN sorting last.
+ */
+template<bool Right, typename T>
+inline bool before_insertion(const T& x, const T& v) {
+    return Right ? x <= v : x < v;
+}
+
+/**
+ * @brief Insertion point of `v` in the sorted range `a[0, n)`.
+ *
+ * Halves the range without a data-dependent branch, so the compiler
+ * emits a conditional move and the loop runs a fixed ceil(log2(n)) steps.
+ */
+template<bool Right, typename T>
+size_t branchless_search(const T* a, size_t n, const T& v) {
+    if (n == 0) return 0;
+    if (is_nan_value(v)) {
+        // Right of everything, or left of the first NaN
+        if (Right) return n;
+        return static_cast<size_t>(std::partition_point(a, a + n, [](const T& x) { return !is_nan_value(x); }) - a);
+    }
+    const T* base = a;
+    while (n > 1) {
+        const size_t half = n / 2;
+        base = before_insertion<Right>(base[half], v) ? base + half : base;
+        n -= half;
+    }
+    return static_cast<size_t>(base - a) + (before_insertion<Right>(*base, v) ? 1 : 0);
+}
+
+/**
+ * @brief Insertion point of `v` in `a[0, n)`, known to be at least `from`.
+ *
+ * Gallops forward from `from` in steps of 1, 2, 4, ... and finishes with a
+ * binary search of the last step, so nearby answers cost O(log distance).
+ */
+template<bool Right, typename T>
+size_t gallop_search(const T* a, size_t n, size_t from, const T& v) {
+    if (is_nan_value(v)) return branchless_search<Right>(a, n, v);
+    size_t lo = from, step = 1;
+    while (lo < n && before_insertion<Right>(a[lo], v)) {
+        const size_t next = lo + step;
+        if (next >= n || !before_insertion<Right>(a[next], v)) {
+            const size_t hi = std::min(next, n);
+            return lo + 1 + branchless_search<Right>(a + lo + 1, hi - lo - 1, v);
+        }
+        lo = next;
+        step *= 2;
+    }
+    return lo;
+}
+
+/**
+ * @brief Call `fn(i, pos)` with the insertion point `pos` of every `v[i]` in `a`.
+ *
+ * Queries are split into contiguous chunks processed in parallel. When the
+ * queries are themselves sorted, each chunk binary-searches its first value
+ * and gallops forward from the previous answer for the rest, which makes
+ * the walk O(M log(N / M)) instead of O(M log N).
+ */
+template<bool Right, typename T, typename Fn>
+void search_each(const T* a, size_t n, const T* v, size_t m, Fn fn) {
+    if (m == 0) return;
+    const bool sorted_queries = std::is_sorted(v, v + m, sort_less<T>);
+    const bool parallel = m >= SEARCH_PARALLEL_MIN;
+    (void)parallel;
+    size_t chunks = 1;
+#ifdef _OPENMP
+    if (parallel) chunks = std::min(static_cast<size_t>(omp_get_max_threads()) * 4, m);
+#endif
+    const index_t nc = static_cast<index_t>(chunks);
+#ifdef _OPENMP
+    #pragma omp parallel for if(parallel) schedule(static)
+#endif
+    for (index_t c = 0; c < nc; ++c) {
+        const size_t lo = m * static_cast<size_t>(c) / chunks, hi = m * (static_cast<size_t>(c) + 1) / chunks;
+        if (sorted_queries) {
+            size_t pos = branchless_search<Right>(a, n, v[lo]);
+            fn(lo, pos);
+            for (size_t i = lo + 1; i < hi; ++i) {
+                pos = gallop_search<Right>(a, n, pos, v[i]);
+                fn(i, pos);
+            }
+        } else {
+            for (size_t i = lo; i < hi; ++i) fn(i, branchless_search<Right>(a, n, v[i]));
+        }
+    }
+}
+
+/**
+ * @brief Indices at which `v` would be inserted into sorted `a` to keep it sorted.
+ *
+ * `a` must be 1D and ascending (NaN last); `v` may have any shape and the
+ * result has the same shape. Equivalent to numpy.searchsorted().
+ *
+ * @code
+ * auto bins = searchsorted(edges, samples, SearchSide::Right);
+ * @endcode
+ *
+ * @throws std::runtime_error If `a` is not 1D
+ */
+template<typename T>
+ndarray<int64_t> searchsorted(const ndarray<T>& a, const ndarray<T>& v,
+                              SearchSide side = SearchSide::Left) {
+    if (a.ndim() != 1)
+        throw std::runtime_error("searchsorted: sorted array must be 1D");
+    ndarray<int64_t> result(v.shape());
+    int64_t* out = result.data();
+    auto store = [out](size_t i, size_t pos) { out[i] = static_cast<int64_t>(pos); };
+    if (side == SearchSide::Right)
+        search_each<true>(a.data(), a.size(), v.data(), v.size(), store);
+    else
+        search_each<false>(a.data(), a.size(), v.data(), v.size(), store);
+    return result;
+}
+
+/**
+ * @brief Insertion point of a single value into sorted 1D `a`.
+ * @throws std::runtime_error If `a` is not 1D
+ */
+template<typename T>
+size_t searchsorted(const ndarray<T>& a, T v, SearchSide side = SearchSide::Left) {
+    if (a.ndim() != 1)
+        throw std::runtime_error("searchsorted: sorted array must be 1D");
+    return side == SearchSide::Right ? branchless_search<true>(a.data(), a.size(), v)
+                                     : branchless_search<false>(a.data(), a.size(), v);
+}
+
+} // namespace numbits
@@ -0,0 +1,869 @@
+/**
+ * @file sparse.hpp
+ * @brief Sparse matrices in CSR, CSC and COO formats.
+ *
+ * Provides:
+ *   - csr_matrix / csc_matrix: compressed sparse rows / columns
+ *     (compressed_matrix with SparseFormat::CSR or SparseFormat::CSC)
+ *   - coo_matrix: coordinate triplets, convenient for assembly
+ *   - Conversions between all formats and from/to dense ndarray
+ *   - matmul(), dot(), spmv(): sparse x dense vector (SpMV), sparse x dense
+ *     matrix (SpMM) and dense x sparse products
+ *   - transpose(), add(), subtract(), multiply(), multiply_scalar()
+ *   - dump() / load_sparse(): archiving in `.cb` files
+ *
+ * Compressed formats keep their indices sorted and unique within each
+ * row (CSR) or column (CSC); the constructors validate this and all
+ * operations preserve it. Indices are stored as int64_t, so matrices
+ * with more than 2^31 nonzeros or dimensions are supported.
+ *
+ * CSR products run in parallel over blocks of rows holding equal numbers
+ * of nonzeros, so a few dense rows do not serialize the work. Products
+ * with a CSC left operand scatter into the output and run serially;
+ * convert with tocsr() first when the matrix is reused. transpose()
+ * swaps CSR and CSC without moving any data.
+ *
+ * A sparse `.cb` file stores a tag (CB_SPARSE_FLAG | format), the matrix
+ * shape, and the three component arrays as regular `.cb` records.
+ *
+ * @namespace numbits
+ */
+
+#pragma once
+
+#include "ndarray.hpp"
+#include "io.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace numbits {
+
+/**
+ * @brief Minimum number of nonzeros before sparse kernels run in parallel.
+ */
+constexpr size_t SPARSE_PARALLEL_NNZ = size_t(1) << 15;
+
+/**
+ * @brief Tag bit marking a `.cb` file as a sparse matrix (the low byte holds the format).
+ */
+constexpr uint32_t CB_SPARSE_FLAG = 0x200;
+
+/**
+ * @enum SparseFormat
+ * @brief Storage layout of a sparse matrix.
+ */
+enum class SparseFormat : uint32_t {
+    CSR = 0, ///< Compressed sparse rows
+    CSC = 1, ///< Compressed sparse columns
+    COO = 2  ///< Coordinate triplets
+};
+
+template<typename T, SparseFormat Format> class compressed_matrix;
+template<typename T> class coo_matrix;
+
+template<typename T> using csr_matrix = compressed_matrix<T, SparseFormat::CSR>;
+template<typename T> using csc_matrix = compressed_matrix<T, SparseFormat::CSC>;
+
+/**
+ * @brief Call `fn(begin, end)` for ranges of major indices holding about equal numbers of nonzeros.
+ *
+ * With `parallel` set, the ranges (several per thread) are distributed
+ * over threads; otherwise `fn` is called once for the whole range.
+ */
+template<typename Fn>
+void for_each_nnz_block(const std::vector<int64_t>& indptr, bool parallel, Fn fn) {
+    const size_t major = indptr.size() - 1;
+    size_t blocks = major > 0 ? 1 : 0;
+#ifdef _OPENMP
+    if (parallel) blocks = std::min(static_cast<size_t>(omp_get_max_threads()) * 4, major);
+#endif
+    (void)parallel;
+    const int64_t nnz = indptr.back();
+    auto boundary = [&](size_t b) -> size_t {
+        if (b == 0) return 0;
+        if (b == blocks) return major;
+        const int64_t target = static_cast<int64_t>(static_cast<double>(nnz) * static_cast<double>(b) / static_cast<double>(blocks));
+        return static_cast<size_t>(std::lower_bound(indptr.begin(), indptr.end() - 1, target) - indptr.begin());
+    };
+    const index_t count = static_cast<index_t>(blocks);
+#ifdef _OPENMP
+    #pragma omp parallel for if(parallel) schedule(static)
+#endif
+    for (index_t b = 0; b < count; ++b) {
+        const size_t begin = boundary(static_cast<size_t>(b)), end = boundary(static_cast<size_t>(b) + 1);
+        if (begin < end) fn(begin, end);
+    }
+}
+
+/**
+ * @brief Regroup a compressed layout by its minor index (CSR <-> CSC of the same matrix).
+ *
+ * A counting sort over the minor indices; traversing the major slices in
+ * order leaves every new slice sorted.
+ */
+template<typename T>
+void recompress(size_t n_minor, const std::vector<int64_t>& indptr, const std::vector<int64_t>& indices,
+                const std::vector<T>& data, std::vector<int64_t>& out_indptr,
+                std::vector<int64_t>& out_indices, std::vector<T>& out_data) {
+    const size_t n_major = indptr.size() - 1;
+    out_indptr.assign(n_minor + 1, 0);
+    for (int64_t j : indices) ++out_indptr[static_cast<size_t>(j) + 1];
+    for (size_t j = 0; j < n_minor; ++j) out_indptr[j + 1] += out_indptr[j];
+    out_indices.resize(indices.size());
+    out_data.resize(data.size());
+    std::vector<int64_t> next(out_indptr.begin(), out_indptr.end() - 1);
+    for (size_t i = 0; i < n_major; ++i)
+        for (int64_t p = indptr[i]; p < indptr[i + 1]; ++p) {
+            const int64_t dst = next[static_cast<size_t>(indices[static_cast<size_t>(p)])]++;
+            out_indices[static_cast<size_t>(dst)] = static_cast<int64_t>(i);
+            out_data[static_cast<size_t>(dst)] = data[static_cast<size_t>(p)];
+        }
+}
+
+/**
+ * @class compressed_matrix
+ * @brief Sparse matrix compressed along rows (CSR) or columns (CSC).
+ *
+ * The nonzeros of major slice `s` (row for CSR, column for CSC) are
+ * `data[indptr[s] .. indptr[s + 1])`, at minor positions `indices[...]`.
+ *
+ * @code
+ * csr_matrix<double> A = csr_matrix<double>::from_dense(dense);
+ * ndarray<double> y = matmul(A, x);   // SpMV
+ * @endcode
+ *
+ * @tparam T Element type (arithmetic or 16-bit float, not bool)
+ * @tparam Format SparseFormat::CSR or SparseFormat::CSC
+ */
+template<typename T, SparseFormat Format>
+class compressed_matrix {
+    static_assert(Format == SparseFormat::CSR || Format == SparseFormat::CSC, "compressed_matrix is CSR or CSC");
+    static_assert(!std::is_same_v<T, bool>, "sparse matrices of bool are not supported");
+
+public:
+    using value_type = T;
+    static constexpr SparseFormat format = Format;
+    static constexpr SparseFormat transposed_format = Format == SparseFormat::CSR ? SparseFormat::CSC : SparseFormat::CSR;
+
+    /** @brief Empty 0 x 0 matrix. */
+    compressed_matrix() : rows_(0), cols_(0), indptr_(1, 0) {}
+
+    /** @brief All-zero matrix of the given shape. */
+    compressed_matrix(size_t rows, size_t cols)
+        : rows_(rows), cols_(cols), indptr_((Format == SparseFormat::CSR ? rows : cols) + 1, 0) {}
+
+    /**
+     * @brief Matrix from its raw compressed arrays.
+     *
+     * @throws std::runtime_error If the arrays are inconsistent, an index is
+     *         out of range, or indices are not sorted and unique per slice
+     */
+    compressed_matrix(size_t rows, size_t cols, std::vector<int64_t> indptr,
+                      std::vector<int64_t> indices, std::vector<T> data)
+        : rows_(rows), cols_(cols), indptr_(std::move(indptr)), indices_(std::move(indices)), data_(std::move(data)) {
+        const size_t major = major_size(), minor = minor_size();
+        if (indptr_.size() != major + 1 || indptr_[0] != 0 || indices_.size() != data_.size() ||
+            static_cast<size_t>(indptr_.back()) != indices_.size())
+            throw std::runtime_error("Sparse matrix: inconsistent indptr, indices and data");
+        // indptr bounds every slice scan below, so it is checked in full first
+        for (size_t s = 0; s < major; ++s)
+            if (indptr_[s + 1] < indptr_[s]) throw std::runtime_error("Sparse matrix: indptr must be non-decreasing");
+        for (size_t s = 0; s < major; ++s) {
+            for (int64_t p = indptr_[s]; p < indptr_[s + 1]; ++p) {
+                const int64_t j = indices_[static_cast<size_t>(p)];
+                if (j < 0 || static_cast<size_t>(j) >= minor) throw std::runtime_error("Sparse matrix: index out of range");
+                if (p > indptr_[s] && j <= indices_[static_cast<size_t>(p) - 1])
+                    throw std::runtime_error("Sparse matrix: indices must be sorted and unique within each slice");
+            }
+        }
+    }
+
+    /**
+     * @brief Compress the nonzero elements of a dense 2D array.
+     *
+     * @throws std::runtime_error If the array is not 2D
+     */
+    static compressed_matrix from_dense(const ndarray<T>& dense) {
+        if (dense.ndim() != 2) throw std::runtime_error("Sparse matrix requires a 2D ndarray");
+        compressed_matrix m(dense.shape()[0], dense.shape()[1]);
+        const size_t major = m.major_size(), minor = m.minor_size();
+        const size_t major_step = Format == SparseFormat::CSR ? m.cols_ : 1;
+        const size_t minor_step = Format == SparseFormat::CSR ? 1 : m.cols_;
+        const T* x = dense.data();
+        const index_t slices = static_cast<index_t>(major);
+        const bool parallel = dense.size() >= SPARSE_PARALLEL_NNZ;
+        (void)parallel;
+
+        // Count per slice, then fill each slice at its offset
+#ifdef _OPENMP
+        #pragma omp parallel for if(parallel) schedule(static)
+#endif
+        for (index_t s = 0; s < slices; ++s) {
+            int64_t count = 0;
+            for (size_t j = 0; j < minor; ++j) count += x[static_cast<size_t>(s) * major_step + j * minor_step] != T(0);
+            m.indptr_[static_cast<size_t>(s) + 1] = count;
+        }
+        for (size_t s = 0; s < major; ++s) m.indptr_[s + 1] += m.indptr_[s];
+        m.indices_.resize(static_cast<size_t>(m.indptr_.back()));
+        m.data_.resize(m.indices_.size());
+#ifdef _OPENMP
+        #pragma omp parallel for if(parallel) schedule(static)
+#endif
+        for (index_t s = 0; s < slices; ++s) {
+            size_t p = static_cast<size_t>(m.indptr_[static_cast<size_t>(s)]);
+            for (size_t j = 0; j < minor; ++j) {
+                const T v = x[static_cast<size_t>(s) * major_step + j * minor_step];
+                if (v != T(0)) {
+                    m.indices_[p] = static_cast<int64_t>(j);
+                    m.data_[p++] = v;
+                }
+            }
+        }
+        return m;
+    }
+
+    /**
+     * @brief Expand to a dense 2D array.
+     */
+    ndarray<T> to_dense() const {
+        ndarray<T> dense(Shape{rows_, cols_});
+        T* out = dense.data();
+        const size_t major_step = Format == SparseFormat::CSR ? cols_ : 1;
+        const size_t minor_step = Format == SparseFormat::CSR ? 1 : cols_;
+        for_each_nnz_block(indptr_, nnz() >= SPARSE_PARALLEL_NNZ, [&](size_t begin, size_t end) {
+            for (size_t s = begin; s < end; ++s)
+                for (int64_t p = indptr_[s]; p < indptr_[s + 1]; ++p)
+                    out[s * major_step + static_cast<size_t>(indices_[static_cast<size_t>(p)]) * minor_step] = data_[static_cast<size_t>(p)];
+        });
+        return dense;
+    }
+
+    size_t rows() const { return rows_; }
+    size_t cols() const { return cols_; }
+    Shape shape() const { return Shape{rows_, cols_}; }
+    size_t nnz() const { return data_.size(); }
+
+    const std::vector<int64_t>& indptr() const { return indptr_; }
+    const std::vector<int64_t>& indices() const { return indices_; }
+    const std::vector<T>& data() const { return data_; }
+    /** @brief Stored values; the sparsity pattern itself is not modifiable. */
+    std::vector<T>& data() { return data_; }
+
+    /**
+     * @brief Element (i, j), zero if not stored (binary search in the slice).
+     * @throws std::out_of_range If the index is outside the matrix
+     */
+    T operator()(size_t i, size_t j) const {
+        if (i >= rows_ || j >= cols_) throw std::out_of_range("Sparse matrix index out of range");
+        const size_t s = Format == SparseFormat::CSR ? i : j;
+        const int64_t key = static_cast<int64_t>(Format == SparseFormat::CSR ? j : i);
+        auto first = indices_.begin() + indptr_[s], last = indices_.begin() + indptr_[s + 1];
+        auto it = std::lower_bound(first, last, key);
+        return it != last && *it == key ? data_[static_cast<size_t>(it - indices_.begin())] : T(0);
+    }
+
+    /**
+     * @brief Transposed matrix in the opposite compressed format; the arrays are reused as they are.
+     */
+    compressed_matrix<T, transposed_format> transpose() const {
+        using M = compressed_matrix<T, transposed_format>;
+        return M(cols_, rows_, indptr_, indices_, data_, typename M::trusted());
+    }
+
+    compressed_matrix<T, SparseFormat::CSR> tocsr() const;
+    compressed_matrix<T, SparseFormat::CSC> tocsc() const;
+    coo_matrix<T> tocoo() const;
+
+    /// @cond INTERNAL
+    struct trusted {};
+    /** @brief Adopt arrays that are already known to be valid. */
+    compressed_matrix(size_t rows, size_t cols, std::vector<int64_t> indptr, std::vector<int64_t> indices,
+                      std::vector<T> data, trusted)
+        : rows_(rows), cols_(cols), indptr_(std::move(indptr)), indices_(std::move(indices)), data_(std::move(data)) {}
+    /// @endcond
+
+    size_t major_size() const { return Format == SparseFormat::CSR ? rows_ : cols_; }
+    size_t minor_size() const { return Format == SparseFormat::CSR ? cols_ : rows_; }
+
+private:
+    size_t rows_, cols_;
+    std::vector<int64_t> indptr_;
+    std::vector<int64_t> indices_;
+    std::vector<T> data_;
+};
+
+/**
+ * @class coo_matrix
+ * @brief Sparse matrix as (row, col, value) triplets in any order.
+ *
+ * Duplicate coordinates are allowed and are summed on conversion.
+ *
+ * @code
+ * coo_matrix<float> B(1000000, 100000);
+ * B.push_back(3, 17, 1.0f);
+ * csr_matrix<float> A = B.tocsr();
+ * @endcode
+ */
+template<typename T>
+class coo_matrix {
+    static_assert(!std::is_same_v<T, bool>, "sparse matrices of bool are not supported");
+
+public:
+    using value_type = T;
+    static constexpr SparseFormat format = SparseFormat::COO;
+
+    coo_matrix() : rows_(0), cols_(0) {}
+    coo_matrix(size_t rows, size_t cols) : rows_(rows), cols_(cols) {}
+
+    /**
+     * @brief Matrix from coordinate arrays.
+     * @throws std::runtime_error If the lengths differ or a coordinate is out of range
+     */
+    coo_matrix(size_t rows, size_t cols, std::vector<int64_t> row, std::vector<int64_t> col, std::vector<T> data)
+        : rows_(rows), cols_(cols), row_(std::move(row)), col_(std::move(col)), data_(std::move(data)) {
+        if (row_.size() != data_.size() || col_.size() != data_.size())
+            throw std::runtime_error("Sparse matrix: row, col and data must have the same length");
+        for (size_t p = 0; p < data_.size(); ++p)
+            if (row_[p] < 0 || static_cast<size_t>(row_[p]) >= rows_ || col_[p] < 0 || static_cast<size_t>(col_[p]) >= cols_)
+                throw std::runtime_error("Sparse matrix: index out of range");
+    }
+
+    /**
+     * @brief Coordinates of the nonzero elements of a dense 2D array, in row-major order.
+     * @throws std::runtime_error If the array is not 2D
+     */
+    static coo_matrix from_dense(const ndarray<T>& dense) { return csr_matrix<T>::from_dense(dense).tocoo(); }
+
+    /**
+     * @brief Expand to a dense 2D array, summing duplicates.
+     */
+    ndarray<T> to_dense() const {
+        ndarray<T> dense(Shape{rows_, cols_});
+        T* out = dense.data();
+        for (size_t p = 0; p < data_.size(); ++p) {
+            T& cell = out[static_cast<size_t>(row_[p]) * cols_ + static_cast<size_t>(col_[p])];
+            cell = cell + data_[p];
+        }
+        return dense;
+    }
+
+    /**
+     * @brief Append one entry.
+     * @throws std::out_of_range If the coordinate is outside the matrix
+     */
+    void push_back(size_t i, size_t j, T value) {
+        if (i >= rows_ || j >= cols_) throw std::out_of_range("Sparse matrix index out of range");
+        row_.push_back(static_cast<int64_t>(i));
+        col_.push_back(static_cast<int64_t>(j));
+        data_.push_back(value);
+    }
+
+    size_t rows() const { return rows_; }
+    size_t cols() const { return cols_; }
+    Shape shape() const { return Shape{rows_, cols_}; }
+    size_t nnz() const { return data_.size(); }
+
+    const std::vector<int64_t>& row() const { return row_; }
+    const std::vector<int64_t>& col() const { return col_; }
+    const std::vector<T>& data() const { return data_; }
+    std::vector<T>& data() { return data_; }
+
+    /** @brief Transposed matrix (rows and columns swapped). */
+    coo_matrix transpose() const { return coo_matrix(cols_, rows_, col_, row_, data_); }
+
+    /**
+     * @brief Compressed rows with sorted indices and summed duplicates.
+     */
+    csr_matrix<T> tocsr() const { return compress<SparseFormat::CSR>(row_, col_, rows_, cols_); }
+
+    /**
+     * @brief Compressed columns with sorted indices and summed duplicates.
+     */
+    csc_matrix<T> tocsc() const { return compress<SparseFormat::CSC>(col_, row_, cols_, rows_); }
+
+    coo_matrix tocoo() const { return *this; }
+
+private:
+    /**
+     * @brief Two stable counting sorts (minor, then major) followed by a merge of duplicates.
+     */
+    template<SparseFormat F>
+    compressed_matrix<T, F> compress(const std::vector<int64_t>& major, const std::vector<int64_t>& minor,
+                                     size_t n_major, size_t n_minor) const {
+        const size_t n = data_.size();
+        std::vector<int64_t> by_minor(n), order(n);
+        {
+            std::vector<int64_t> start(n_minor + 1, 0);
+            for (int64_t j : minor) ++start[static_cast<size_t>(j) + 1];
+            for (size_t j = 0; j < n_minor; ++j) start[j + 1] += start[j];
+            for (size_t p = 0; p < n; ++p) by_minor[static_cast<size_t>(start[static_cast<size_t>(minor[p])]++)] = static_cast<int64_t>(p);
+        }
+        std::vector<int64_t> indptr(n_major + 1, 0);
+        for (int64_t i : major) ++indptr[static_cast<size_t>(i) + 1];
+        for (size_t i = 0; i < n_major; ++i) indptr[i + 1] += indptr[i];
+        {
+            std::vector<int64_t> next(indptr.begin(), indptr.end() - 1);
+            for (int64_t p : by_minor) order[static_cast<size_t>(next[static_cast<size_t>(major[static_cast<size_t>(p)])]++)] = p;
+        }
+
+        std::vector<int64_t> indices;
+        std::vector<T> data;
+        indices.reserve(n);
+        data.reserve(n);
+        std::vector<int64_t> merged(n_major + 1, 0);
+        for (size_t s = 0; s < n_major; ++s) {
+            for (int64_t q = indptr[s]; q < indptr[s + 1]; ++q) {
+                const size_t p = static_cast<size_t>(order[static_cast<size_t>(q)]);
+                if (q > indptr[s] && indices.back() == minor[p]) {
+                    data.back() = data.back() + data_[p];
+                } else {
+                    indices.push_back(minor[p]);
+                    data.push_back(data_[p]);
+                }
+            }
+            merged[s + 1] = static_cast<int64_t>(indices.size());
+        }
+        using M = compressed_matrix<T, F>;
+        return M(F == SparseFormat::CSR ? n_major : n_minor, F == SparseFormat::CSR ? n_minor : n_major,
+                 std::move(merged), std::move(indices), std::move(data), typename M::trusted());
+    }
+
+    size_t rows_, cols_;
+    std::vector<int64_t> row_;
+    std::vector<int64_t> col_;
+    std::vector<T> data_;
+};
+
+template<typename T, SparseFormat Format>
+compressed_matrix<T, SparseFormat::CSR> compressed_matrix<T, Format>::tocsr() const {
+    if constexpr (Format == SparseFormat::CSR) {
+        return *this;
+    } else {
+        std::vector<int64_t> indptr, indices;
+        std::vector<T> data;
+        recompress(rows_, indptr_, indices_, data_, indptr, indices, data);
+        return csr_matrix<T>(rows_, cols_, std::move(indptr), std::move(indices), std::move(data),
+                             typename csr_matrix<T>::trusted());
+    }
+}
+
+template<typename T, SparseFormat Format>
+compressed_matrix<T, SparseFormat::CSC> compressed_matrix<T, Format>::tocsc() const {
+    if constexpr (Format == SparseFormat::CSC) {
+        return *this;
+    } else {
+        std::vector<int64_t> indptr, indices;
+        std::vector<T> data;
+        recompress(cols_, indptr_, indices_, data_, indptr, indices, data);
+        return csc_matrix<T>(rows_, cols_, std::move(indptr), std::move(indices), std::move(data),
+                             typename csc_matrix<T>::trusted());
+    }
+}
+
+template<typename T, SparseFormat Format>
+coo_matrix<T> compressed_matrix<T, Format>::tocoo() const {
+    std::vector<int64_t> major(nnz());
+    for (size_t s = 0; s < major_size(); ++s)
+        std::fill(major.begin() + indptr_[s], major.begin() + indptr_[s + 1], static_cast<int64_t>(s));
+    if constexpr (Format == SparseFormat::CSR) return coo_matrix<T>(rows_, cols_, std::move(major), indices_, data_);
+    else return coo_matrix<T>(rows_, cols_, indices_, std::move(major), data_);
+}
+
+/**
+ * @brief Multiply a sparse (m, k) matrix by `n` dense columns stored row-major: `y = A * x`.
+ *
+ * CSR rows are processed in parallel in blocks of equal nonzero count;
+ * CSC columns are scattered into the output serially. 16-bit floats
+ * accumulate in float. `y` (m * n elements) is fully overwritten.
+ */
+template<typename T, SparseFormat Format>
+void sparse_product(const compressed_matrix<T, Format>& a, const T* x, T* y, size_t n) {
+    using A = accumulator_t<T>;
+    const int64_t* indptr = a.indptr().data();
+    const int64_t* indices = a.indices().data();
+    const T* values = a.data().data();
+
+    if constexpr (Format == SparseFormat::CSR) {
+        for_each_nnz_block(a.indptr(), a.nnz() * n >= SPARSE_PARALLEL_NNZ, [&](size_t begin, size_t end) {
+            if (n == 1) {
+                for (size_t i = begin; i < end; ++i) {
+                    A sum = A(0);
+                    for (int64_t p = indptr[i]; p < indptr[i + 1]; ++p)
+                        sum += static_cast<A>(values[p]) * static_cast<A>(x[indices[p]]);
+                    y[i] = static_cast<T>(sum);
+                }
+                return;
+            }
+            std::vector<A> row(n);
+            for (size_t i = begin; i < end; ++i) {
+                std::fill(row.begin(), row.end(), A(0));
+                for (int64_t p = indptr[i]; p < indptr[i + 1]; ++p) {
+                    const A v = static_cast<A>(values[p]);
+                    const T* xr = x + static_cast<size_t>(indices[p]) * n;
+                    for (size_t j = 0; j < n; ++j) row[j] += v * static_cast<A>(xr[j]);
+                }
+                for (size_t j = 0; j < n; ++j) y[i * n + j] = static_cast<T>(row[j]);
+            }
+        });
+    } else {
+        std::vector<A> acc(a.rows() * n, A(0));
+        for (size_t k = 0; k < a.cols(); ++k)
+            for (int64_t p = indptr[k]; p < indptr[k + 1]; ++p) {
+                const A v = static_cast<A>(values[p]);
+                A* yr = acc.data() + static_cast<size_t>(indices[p]) * n;
+                for (size_t j = 0; j < n; ++j) yr[j] += v * static_cast<A>(x[k * n + j]);
+            }
+        for (size_t i = 0; i < acc.size(); ++i) y[i] = static_cast<T>(acc[i]);
+    }
+}
+
+/**
+ * @brief Sparse matrix-vector product into an existing vector: `y = A * x`.
+ *
+ * Reuses the storage of `y` when it already has the right size, which
+ * keeps iterative solvers free of per-iteration allocations.
+ *
+ * @param a Sparse matrix of shape (m, k)
+ * @param x Dense vector (k)
+ * @param y Output vector, resized to (m) if needed
+ * @throws std::runtime_error If the shapes are incompatible
+ */
+template<typename T, SparseFormat Format>
+void spmv(const compressed_matrix<T, Format>& a, const ndarray<T>& x, ndarray<T>& y) {
+    if (x.ndim() != 1 || x.size() != a.cols())
+        throw std::runtime_error("Matrix dimensions incompatible for multiplication");
+    if (y.ndim() != 1 || y.size() != a.rows()) y = ndarray<T>(Shape{a.rows()});
+    sparse_product(a, x.data(), y.data(), 1);
+}
+
+/**
+ * @brief Sparse x dense product: `A * b` for a vector (SpMV) or a matrix (SpMM).
+ *
+ * @param a Sparse matrix of shape (m, k)
+ * @param b Dense vector (k) or matrix (k, n)
+ * @return Dense vector (m) or matrix (m, n)
+ * @throws std::runtime_error If the shapes are incompatible
+ */
+template<typename T, SparseFormat Format>
+ndarray<T> matmul(const compressed_matrix<T, Format>& a, const ndarray<T>& b) {
+    if ((b.ndim() != 1 && b.ndim() != 2) || b.shape()[0] != a.cols())
+        throw std::runtime_error("Matrix dimensions incompatible for multiplication");
+    const size_t n = b.ndim() == 2 ? b.shape()[1] : 1;
+    ndarray<T> out(b.ndim() == 2 ? Shape{a.rows(), n} : Shape{a.rows()});
+    sparse_product(a, b.data(), out.data(), n);
+    return out;
+}
+
+/**
+ * @brief Dense x sparse product `a * B`, parallel over the rows of `a`.
+ *
+ * @param a Dense matrix of shape (m, k)
+ * @param b Sparse matrix of shape (k, n)
+ * @return Dense matrix (m, n)
+ * @throws std::runtime_error If the shapes are incompatible
+ */
+template<typename T, SparseFormat Format>
+ndarray<T> matmul(const ndarray<T>& a, const compressed_matrix<T, Format>& b) {
+    if (a.ndim() != 2 || a.shape()[1] != b.rows())
+        throw std::runtime_error("Matrix dimensions incompatible for multiplication");
+    using A = accumulator_t<T>;
+    const size_t m = a.shape()[0], k = b.rows(), n = b.cols();
+    ndarray<T> out(Shape{m, n});
+    const int64_t* indptr = b.indptr().data();
+    const int64_t* indices = b.indices().data();
+    const T* values = b.data().data();
+    const T* x = a.data();
+    T* y = out.data();
+    const index_t rows = static_cast<index_t>(m);
+    const bool parallel = m * b.nnz() >= SPARSE_PARALLEL_NNZ;
+    (void)parallel;
+#ifdef _OPENMP
+    #pragma omp parallel for if(parallel) schedule(static)
+#endif
+    for (index_t ii = 0; ii < rows; ++ii) {
+        const size_t i = static_cast<size_t>(ii);
+        const T* xr = x + i * k;
+        if constexpr (Format == SparseFormat::CSR) {
+            // Row i of the result combines the rows of B selected by the nonzeros of a's row
+            std::vector<A> row(n, A(0));
+            for (size_t kk = 0; kk < k; ++kk) {
+                const A v = static_cast<A>(xr[kk]);
+                if (v == A(0)) continue;
+                for (int64_t p = indptr[kk]; p < indptr[kk + 1]; ++p) row[static_cast<size_t>(indices[p])] += v * static_cast<A>(values[p]);
+            }
+            for (size_t j = 0; j < n; ++j) y[i * n + j] = static_cast<T>(row[j]);
+        } else {
+            // Each result element is a sparse dot product with one column of B
+            for (size_t j = 0; j < n; ++j) {
+                A sum = A(0);
+                for (int64_t p = indptr[j]; p < indptr[j + 1]; ++p)
+                    sum += static_cast<A>(xr[indices[p]]) * static_cast<A>(values[p]);
+                y[i * n + j] = static_cast<T>(sum);
+            }
+        }
+    }
+    return out;
+}
+
+/**
+ * @brief Sparse x dense product of a COO matrix (converted to CSR first).
+ */
+template<typename T>
+ndarray<T> matmul(const coo_matrix<T>& a, const ndarray<T>& b) {
+    return matmul(a.tocsr(), b);
+}
+
+/**
+ * @brief Dense x sparse product with a COO right operand (converted to CSR first).
+ */
+template<typename T>
+ndarray<T> matmul(const ndarray<T>& a, const coo_matrix<T>& b) {
+    return matmul(a, b.tocsr());
+}
+
+/** @brief Same as matmul(sparse, dense), including the SpMV case. */
+template<typename T, SparseFormat Format>
+ndarray<T> dot(const compressed_matrix<T, Format>& a, const ndarray<T>& b) { return matmul(a, b); }
+
+/** @brief Same as matmul(dense, sparse). */
+template<typename T, SparseFormat Format>
+ndarray<T> dot(const ndarray<T>& a, const compressed_matrix<T, Format>& b) { return matmul(a, b); }
+
+/**
+ * @brief Combine two compressed matrices slice by slice, dropping zero results.
+ *
+ * With `union_pattern`, an element present in only one operand is combined
+ * with 0 (add, subtract); otherwise only common elements are kept (multiply).
+ */
+template<typename T, SparseFormat Format, typename Op>
+compressed_matrix<T, Format> sparse_binary(const compressed_matrix<T, Format>& a,
+                                           const compressed_matrix<T, Format>& b, Op op, bool union_pattern) {
+    if (a.rows() != b.rows() || a.cols() != b.cols())
+        throw std::runtime_error("Sparse matrices must have the same shape");
+    const size_t major = a.major_size();
+    const auto& ap = a.indptr();
+    const auto& bp = b.indptr();
+    const auto& ai = a.indices();
+    const auto& bi = b.indices();
+    const auto& av = a.data();
+    const auto& bv = b.data();
+
+    // Walk both sorted slices and call emit(index, value) for every nonzero result
+    auto merge = [&](size_t s, auto emit) {
+        int64_t p = ap[s], q = bp[s];
+        while (p < ap[s + 1] || q < bp[s + 1]) {
+            const int64_t ja = p < ap[s + 1] ? ai[static_cast<size_t>(p)] : INT64_MAX;
+            const int64_t jb = q < bp[s + 1] ? bi[static_cast<size_t>(q)] : INT64_MAX;
+            T v;
+            int64_t j;
+            if (ja == jb) {
+                v = op(av[static_cast<size_t>(p++)], bv[static_cast<size_t>(q++)]);
+                j = ja;
+            } else if (ja < jb) {
+                j = ja;
+                const T x = av[static_cast<size_t>(p++)];
+                if (!union_pattern) continue;
+                v = op(x, T(0));
+            } else {
+                j = jb;
+                const T y = bv[static_cast<size_t>(q++)];
+                if (!union_pattern) continue;
+                v = op(T(0), y);
+            }
+            if (v != T(0)) emit(j, v);
+        }
+    };
+
+    std::vector<int64_t> indptr(major + 1, 0);
+    const index_t slices = static_cast<index_t>(major);
+    const bool parallel = a.nnz() + b.nnz() >= SPARSE_PARALLEL_NNZ;
+    (void)parallel;
+#ifdef _OPENMP
+    #pragma omp parallel for if(parallel) schedule(static)
+#endif
+    for (index_t s = 0; s < slices; ++s) {
+        int64_t count = 0;
+        merge(static_cast<size_t>(s), [&](int64_t, T) { ++count; });
+        indptr[static_cast<size_t>(s) + 1] = count;
+    }
+    for (size_t s = 0; s < major; ++s) indptr[s + 1] += indptr[s];
+
+    std::vector<int64_t> indices(static_cast<size_t>(indptr.back()));
+    std::vector<T> data(indices.size());
+#ifdef _OPENMP
+    #pragma omp parallel for if(parallel) schedule(static)
+#endif
+    for (index_t s = 0; s < slices; ++s) {
+        size_t out = static_cast<size_t>(indptr[static_cast<size_t>(s)]);
+        merge(static_cast<size_t>(s), [&](int64_t j, T v) {
+            indices[out] = j;
+            data[out++] = v;
+        });
+    }
+    using M = compressed_matrix<T, Format>;
+    return M(a.rows(), a.cols(), std::move(indptr), std::move(indices), std::move(data), typename M::trusted());
+}
+
+/** @brief Element-wise sum of two sparse matrices of the same shape and format. */
+template<typename T, SparseFormat Format>
+compressed_matrix<T, Format> add(const compressed_matrix<T, Format>& a, const compressed_matrix<T, Format>& b) {
+    return sparse_binary(a, b, [](T x, T y) { return static_cast<T>(x + y); }, true);
+}
+
+/** @brief Element-wise difference of two sparse matrices of the same shape and format. */
+template<typename T, SparseFormat Format>
+compressed_matrix<T, Format> subtract(const compressed_matrix<T, Format>& a, const compressed_matrix<T, Format>& b) {
+    return sparse_binary(a, b, [](T x, T y) { return static_cast<T>(x - y); }, true);
+}
+
+/** @brief Element-wise (Hadamard) product; only positions stored in both operands can be nonzero. */
+template<typename T, SparseFormat Format>
+compressed_matrix<T, Format> multiply(const compressed_matrix<T, Format>& a, const compressed_matrix<T, Format>& b) {
+    return sparse_binary(a, b, [](T x, T y) { return static_cast<T>(x * y); }, false);
+}
+
+/** @brief Multiply every stored value by a scalar (the pattern is kept). */
+template<typename T, SparseFormat Format>
+compressed_matrix<T, Format> multiply_scalar(const compressed_matrix<T, Format>& a, T scalar) {
+    compressed_matrix<T, Format> out = a;
+    for (T& v : out.data()) v = static_cast<T>(v * scalar);
+    return out;
+}
+
+/**
+ * @brief Write one component array as a `.cb` record.
+ */
+template<typename V>
+void write_sparse_block(std::ostream& file, const std::vector<V>& values) {
+    write_cb_header(file, dtype_from_type<V>(), Shape{values.size()});
+    file.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(V)));
+}
+
+/**
+ * @brief Read one component array written by write_sparse_block().
+ *
+ * The stored length is checked against `max_size` and the bytes left in the
+ * stream before anything is allocated.
+ */
+template<typename V>
+std::vector<V> read_sparse_block(std::istream& file, size_t max_size, const std::string& filename) {
+    CbHeader header = read_cb_header(file, filename);
+    if (header.dtype != dtype_from_type<V>() || header.compressed || header.shape.size() != 1)
+        throw std::runtime_error("Type mismatch: " + filename);
+    if (header.size > max_size) throw std::runtime_error("Corrupt sparse block size: " + filename);
+    const std::streampos start = file.tellg();
+    file.seekg(0, std::ios::end);
+    const std::streamoff left = file.tellg() - start;
+    file.seekg(start);
+    if (!file || left < 0 || header.size > static_cast<size_t>(left) / sizeof(V))
+        throw std::runtime_error("Error reading dump: " + filename);
+    std::vector<V> values(header.size);
+    file.read(reinterpret_cast<char*>(values.data()), static_cast<std::streamsize>(header.size * sizeof(V)));
+    if (!file) throw std::runtime_error("Error reading dump: " + filename);
+    return values;
+}
+
+/**
+ * @brief Write a sparse matrix header and its three component arrays.
+ */
+template<typename T>
+void dump_sparse(SparseFormat format, size_t rows, size_t cols, const std::vector<int64_t>& first,
+                 const std::vector<int64_t>& second, const std::vector<T>& data, const std::string& filename) {
+    std::string full_filename = ensure_cb_extension(filename);
+    std::ofstream file(full_filename, std::ios::binary);
+    if (!file) throw std::runtime_error("Cannot open file: " + full_filename);
+    const uint32_t tag = CB_SPARSE_FLAG | static_cast<uint32_t>(format);
+    file.write(reinterpret_cast<const char*>(&tag), sizeof(tag));
+    file.write(reinterpret_cast<const char*>(&rows), sizeof(size_t));
+    file.write(reinterpret_cast<const char*>(&cols), sizeof(size_t));
+    write_sparse_block(file, first);
+    write_sparse_block(file, second);
+    write_sparse_block(file, data);
+    if (!file) throw std::runtime_error("Error writing dump: " + full_filename);
+}
+
+/**
+ * @brief Archive a CSR or CSC matrix in a `.cb` file (indptr, indices, data).
+ *
+ * @throws std::runtime_error if writing fails
+ */
+template<typename T, SparseFormat Format>
+void dump(const compressed_matrix<T, Format>& m, const std::string& filename) {
+    dump_sparse(Format, m.rows(), m.cols(), m.indptr(), m.indices(), m.data(), filename);
+}
+
+/**
+ * @brief Archive a COO matrix in a `.cb` file (row, col, data).
+ *
+ * @throws std::runtime_error if writing fails
+ */
+template<typename T>
+void dump(const coo_matrix<T>& m, const std::string& filename) {
+    dump_sparse(SparseFormat::COO, m.rows(), m.cols(), m.row(), m.col(), m.data(), filename);
+}
+
+/**
+ * @brief Load a sparse matrix archived with dump(), converting it to the requested format.
+ *
+ * @code
+ * auto A = load_sparse<csr_matrix<float>>("features.cb");  // stored as CSR, CSC or COO
+ * @endcode
+ *
+ * @tparam M csr_matrix<T>, csc_matrix<T> or coo_matrix<T>
+ * @throws std::runtime_error If the file is not a sparse matrix of element type T or is corrupt
+ */
+template<typename M>
+M load_sparse(const std::string& filename) {
+    using T = typename M::value_type;
+    std::string full_filename = ensure_cb_extension(filename);
+    std::ifstream file(full_filename, std::ios::binary);
+    if (!file) throw std::runtime_error("Cannot open file: " + full_filename);
+
+    uint32_t tag = 0;
+    size_t rows = 0, cols = 0;
+    file.read(reinterpret_cast<char*>(&tag), sizeof(tag));
+    file.read(reinterpret_cast<char*>(&rows), sizeof(size_t));
+    file.read(reinterpret_cast<char*>(&cols), sizeof(size_t));
+    if (!file) throw std::runtime_error("Error reading header: " + full_filename);
+    if ((tag & ~0xFFu) != CB_SPARSE_FLAG) throw std::runtime_error("Not a sparse matrix file: " + full_filename);
+    const SparseFormat format = static_cast<SparseFormat>(tag & 0xFFu);
+    if (format != SparseFormat::CSR && format != SparseFormat::CSC && format != SparseFormat::COO)
+        throw std::runtime_error("Unknown sparse format in: " + full_filename);
+
+    // Upper bounds on the stored lengths: nnz <= rows * cols, indptr has major + 1 entries
+    constexpr size_t unbounded = std::numeric_limits<size_t>::max();
+    const size_t max_nnz = (cols != 0 && rows > unbounded / cols) ? unbounded : rows * cols;
+    const size_t major = format == SparseFormat::CSR ? rows : cols;
+    const size_t max_first = format == SparseFormat::COO ? max_nnz : std::max(major, major + 1);
+    std::vector<int64_t> first = read_sparse_block<int64_t>(file, max_first, full_filename);
+    std::vector<int64_t> second = read_sparse_block<int64_t>(file, max_nnz, full_filename);
+    std::vector<T> data = read_sparse_block<T>(file, max_nnz, full_filename);
+
+    auto convert = [](const auto& stored) -> M {
+        if constexpr (M::format == SparseFormat::CSR) return stored.tocsr();
+        else if constexpr (M::format == SparseFormat::CSC) return stored.tocsc();
+        else return stored.tocoo();
+    };
+    switch (format) {
+        case SparseFormat::CSR:
+            return convert(csr_matrix<T>(rows, cols, std::move(first), std::move(second), std::move(data)));
+        case SparseFormat::CSC:
+            return convert(csc_matrix<T>(rows, cols, std::move(first), std::move(second), std::move(data)));
+        case SparseFormat::COO:
+            return convert(coo_matrix<T>(rows, cols, std::move(first), std::move(second), std::move(data)));
+    }
+    throw std::runtime_error("Unknown sparse format in: " + full_filename);
+}
+
+} // namespace numbits
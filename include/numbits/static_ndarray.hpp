@@ -0,0 +1,457 @@
+/**
+ * @file static_ndarray.hpp
+ * @brief Fixed-size arrays with compile-time shapes for tiny matrices.
+ *
+ * This header provides:
+ *   - static_ndarray<T, Dims...>: stack storage, constexpr shape and strides
+ *   - Zero-copy interoperability with ndarray (view(), checked construction)
+ *   - Fixed-size matmul, transpose, trace, determinant and inverse, with
+ *     closed-form 2x2, 3x3 and 4x4 determinant/inverse
+ *
+ * These overloads sit next to the dynamic ones in linear_algebra.hpp and are
+ * selected automatically for static_ndarray arguments. Loop bounds are
+ * compile-time constants, so the compiler fully unrolls small products.
+ *
+ * @example
+ * @code
+ *   static_ndarray<float, 3, 3> R = {0, -1, 0, 1, 0, 0, 0, 0, 1};
+ *   static_ndarray<float, 3> p = {1, 2, 3};
+ *   auto q = matmul(R, p);           // static_ndarray<float, 3>
+ *   auto Rinv = inverse(R);          // closed-form adjugate
+ *   ndarray<float> v = R.view();     // shares R's storage
+ * @endcode
+ *
+ * @namespace numbits
+ */
+
+#pragma once
+
+#include "ndarray.hpp"
+#include "linear_algebra.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+
+namespace numbits {
+
+/**
+ * @class static_ndarray
+ * @brief N-dimensional array whose shape is fixed at compile time.
+ *
+ * Elements are stored inline in row-major order, so the object can live on
+ * the stack and be copied without any allocation. Indexing through
+ * operator() compiles to a constant-stride offset computation.
+ *
+ * @tparam T Element type.
+ * @tparam Dims Extent of each dimension (at least one, all positive).
+ */
+template<typename T, size_t... Dims>
+class static_ndarray {
+    static_assert(sizeof...(Dims) > 0, "static_ndarray needs at least one dimension");
+    static_assert(((Dims > 0) && ...), "static_ndarray extents must be positive");
+
+public:
+    using value_type = T;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    /** @brief Extent of every dimension. */
+    static constexpr std::array<size_t, sizeof...(Dims)> extents = {Dims...};
+
+    /** @brief Row-major strides, in elements. */
+    static constexpr std::array<size_t, sizeof...(Dims)> stride_values = [] {
+        std::array<size_t, sizeof...(Dims)> s{};
+        size_t step = 1;
+        for (size_t i = sizeof...(Dims); i-- > 0;) {
+            s[i] = step;
+            step *= extents[i];
+        }
+        return s;
+    }();
+
+    /** @return Number of dimensions. */
+    static constexpr size_t ndim() { return sizeof...(Dims); }
+
+    /** @return Total number of elements. */
+    static constexpr size_t size() { return (Dims * ...); }
+
+    /** @brief Zero-initialized array. */
+    constexpr static_ndarray() : data_{} {}
+
+    /**
+     * @brief Construct from a flat row-major list of values.
+     *
+     * @throws std::runtime_error If the list length differs from size().
+     */
+    static_ndarray(std::initializer_list<T> values) : data_{} {
+        if (values.size() != size())
+            throw std::runtime_error("static_ndarray: initializer size mismatch");
+        std::copy(values.begin(), values.end(), data_);
+    }
+
+    /**
+     * @brief Copy the contents of a dynamic array with the same shape.
+     *
+     * @throws std::runtime_error If the shapes differ.
+     */
+    explicit static_ndarray(const ndarray<T>& arr) : data_{} {
+        if (arr.ndim() != ndim() || !std::equal(extents.begin(), extents.end(), arr.shape().begin()))
+            throw std::runtime_error("static_ndarray: shape mismatch with ndarray");
+        std::copy(arr.begin(), arr.end(), data_);
+    }
+
+    // Factories
+
+    /** @brief Array of zeros. */
+    static constexpr static_ndarray zeros() { return static_ndarray(); }
+
+    /** @brief Array filled with `value`. */
+    static constexpr static_ndarray full(const T& value) {
+        static_ndarray result;
+        for (size_t i = 0; i < size(); ++i) result.data_[i] = value;
+        return result;
+    }
+
+    /** @brief Array of ones. */
+    static constexpr static_ndarray ones() { return full(T{1}); }
+
+    /** @brief Identity matrix (square 2D arrays only). */
+    static constexpr static_ndarray identity() {
+        static_assert(sizeof...(Dims) == 2 && extents[0] == extents[1],
+                      "identity requires a square 2D static_ndarray");
+        static_ndarray result;
+        for (size_t i = 0; i < extents[0]; ++i) result.data_[i * (extents[0] + 1)] = T{1};
+        return result;
+    }
+
+    // Metadata
+
+    /** @return Shape as a runtime Shape. */
+    Shape shape() const { return Shape{Dims...}; }
+
+    /** @return Strides as runtime Strides. */
+    Strides strides() const { return Strides(stride_values.begin(), stride_values.end()); }
+
+    // Element access
+
+    /** @brief Flat element access (unchecked). */
+    constexpr T& operator[](size_t index) { return data_[index]; }
+    constexpr const T& operator[](size_t index) const { return data_[index]; }
+
+    /**
+     * @brief Multi-index element access (unchecked).
+     *
+     * @code
+     * static_ndarray<double, 4, 4> M;
+     * M(1, 2) = 3.0;
+     * @endcode
+     */
+    template<typename... Idx>
+    constexpr T& operator()(Idx... idx) {
+        return data_[offset(idx...)];
+    }
+
+    template<typename... Idx>
+    constexpr const T& operator()(Idx... idx) const {
+        return data_[offset(idx...)];
+    }
+
+    constexpr T* data() { return data_; }
+    constexpr const T* data() const { return data_; }
+
+    constexpr iterator begin() { return data_; }
+    constexpr iterator end() { return data_ + size(); }
+    constexpr const_iterator begin() const { return data_; }
+    constexpr const_iterator end() const { return data_ + size(); }
+
+    // Interoperability
+
+    /**
+     * @brief Non-owning ndarray view of this array's storage.
+     *
+     * The view must not outlive the static_ndarray. Writes through the view
+     * are visible here and vice versa.
+     */
+    ndarray<T> view() {
+        return ndarray<T>().create_view(shape(), strides(), data_);
+    }
+
+    /** @brief Owning ndarray copy. */
+    ndarray<T> to_ndarray() const {
+        return ndarray<T>(shape(), std::vector<T>(begin(), end()));
+    }
+
+    // Elementwise arithmetic
+
+    friend constexpr static_ndarray operator+(const static_ndarray& a, const static_ndarray& b) {
+        static_ndarray r;
+        for (size_t i = 0; i < size(); ++i) r.data_[i] = a.data_[i] + b.data_[i];
+        return r;
+    }
+
+    friend constexpr static_ndarray operator-(const static_ndarray& a, const static_ndarray& b) {
+        static_ndarray r;
+        for (size_t i = 0; i < size(); ++i) r.data_[i] = a.data_[i] - b.data_[i];
+        return r;
+    }
+
+    friend constexpr static_ndarray operator*(const static_ndarray& a, const T& s) {
+        static_ndarray r;
+        for (size_t i = 0; i < size(); ++i) r.data_[i] = a.data_[i] * s;
+        return r;
+    }
+
+    friend constexpr static_ndarray operator*(const T& s, const static_ndarray& a) { return a * s; }
+
+    friend constexpr bool operator==(const static_ndarray& a, const static_ndarray& b) {
+        for (size_t i = 0; i < size(); ++i)
+            if (!(a.data_[i] == b.data_[i])) return false;
+        return true;
+    }
+
+    friend constexpr bool operator!=(const static_ndarray& a, const static_ndarray& b) { return !(a == b); }
+
+private:
+    template<typename... Idx>
+    static constexpr size_t offset(Idx... idx) {
+        static_assert(sizeof...(Idx) == sizeof...(Dims), "Number of indices does not match dimensions");
+        const size_t index[] = {static_cast<size_t>(idx)...};
+        size_t flat = 0;
+        for (size_t i = 0; i < sizeof...(Dims); ++i) flat += index[i] * stride_values[i];
+        return flat;
+    }
+
+    T data_[(Dims * ...)];
+};
+
+/**
+ * @brief Fixed-size matrix product.
+ *
+ * @param a Matrix of shape (M, N)
+ * @param b Matrix of shape (N, P)
+ * @return static_ndarray<T, M, P>
+ */
+template<typename T, size_t M, size_t N, size_t P>
+constexpr static_ndarray<T, M, P> matmul(const static_ndarray<T, M, N>& a,
+                                         const static_ndarray<T, N, P>& b) {
+    static_ndarray<T, M, P> r;
+    for (size_t i = 0; i < M; ++i)
+        for (size_t k = 0; k < N; ++k) {
+            const T aik = a(i, k);
+            for (size_t j = 0; j < P; ++j) r(i, j) += aik * b(k, j);
+        }
+    return r;
+}
+
+/**
+ * @brief Fixed-size matrix-vector product.
+ *
+ * @param a Matrix of shape (M, N)
+ * @param x Vector of length N
+ * @return static_ndarray<T, M>
+ */
+template<typename T, size_t M, size_t N>
+constexpr static_ndarray<T, M> matmul(const static_ndarray<T, M, N>& a,
+                                      const static_ndarray<T, N>& x) {
+    static_ndarray<T, M> r;
+    for (size_t i = 0; i < M; ++i) {
+        T sum = T{0};
+        for (size_t k = 0; k < N; ++k) sum += a(i, k) * x[k];
+        r[i] = sum;
+    }
+    return r;
+}
+
+/**
+ * @brief Fixed-size matrix transpose.
+ */
+template<typename T, size_t M, size_t N>
+constexpr static_ndarray<T, N, M> transpose(const static_ndarray<T, M, N>& a) {
+    static_ndarray<T, N, M> r;
+    for (size_t i = 0; i < M; ++i)
+        for (size_t j = 0; j < N; ++j) r(j, i) = a(i, j);
+    return r;
+}
+
+/**
+ * @brief Trace of a fixed-size square matrix.
+ */
+template<typename T, size_t N>
+constexpr T trace(const static_ndarray<T, N, N>& a) {
+    T sum = T{0};
+    for (size_t i = 0; i < N; ++i) sum += a(i, i);
+    return sum;
+}
+
+/**
+ * @brief Determinant of a fixed-size square matrix.
+ *
+ * Closed form for N <= 4 (cofactor expansion via 2x2 minors); LU
+ * decomposition with partial pivoting on a stack copy otherwise.
+ */
+template<typename T, size_t N>
+T determinant(const static_ndarray<T, N, N>& a) {
+    if constexpr (N == 1) {
+        return a[0];
+    } else if constexpr (N == 2) {
+        return a[0] * a[3] - a[1] * a[2];
+    } else if constexpr (N == 3) {
+        return a[0] * (a[4] * a[8] - a[5] * a[7])
+             - a[1] * (a[3] * a[8] - a[5] * a[6])
+             + a[2] * (a[3] * a[7] - a[4] * a[6]);
+    } else if constexpr (N == 4) {
+        const T s0 = a[0] * a[5] - a[4] * a[1];
+        const T s1 = a[0] * a[6] - a[4] * a[2];
+        const T s2 = a[0] * a[7] - a[4] * a[3];
+        const T s3 = a[1] * a[6] - a[5] * a[2];
+        const T s4 = a[1] * a[7] - a[5] * a[3];
+        const T s5 = a[2] * a[7] - a[6] * a[3];
+        const T c5 = a[10] * a[15] - a[14] * a[11];
+        const T c4 = a[9] * a[15] - a[13] * a[11];
+        const T c3 = a[9] * a[14] - a[13] * a[10];
+        const T c2 = a[8] * a[15] - a[12] * a[11];
+        const T c1 = a[8] * a[14] - a[12] * a[10];
+        const T c0 = a[8] * a[13] - a[12] * a[9];
+        return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+    } else {
+        static_ndarray<T, N, N> lu = a;
+        T det = T{1};
+        for (size_t i = 0; i < N; ++i) {
+            size_t p = i;
+            for (size_t k = i + 1; k < N; ++k)
+                if (std::abs(lu(k, i)) > std::abs(lu(p, i))) p = k;
+            if (lu(p, i) == T{0}) return T{0};
+            if (p != i) {
+                for (size_t j = 0; j < N; ++j) std::swap(lu(i, j), lu(p, j));
+                det = -det;
+            }
+            det *= lu(i, i);
+            for (size_t k = i + 1; k < N; ++k) {
+                const T f = lu(k, i) / lu(i, i);
+                for (size_t j = i + 1; j < N; ++j) lu(k, j) -= f * lu(i, j);
+            }
+        }
+        return det;
+    }
+}
+
+/**
+ * @brief Singularity threshold for the determinant of a: TOL * max|a_ij|^N.
+ */
+template<typename T, size_t N>
+double singular_threshold(const static_ndarray<T, N, N>& a) {
+    double scale = 0.0;
+    for (size_t i = 0; i < N * N; ++i) scale = std::max(scale, static_cast<double>(std::abs(a[i])));
+    double threshold = TOL;
+    for (size_t i = 0; i < N; ++i) threshold *= scale;
+    return threshold;
+}
+
+/**
+ * @brief Inverse of a fixed-size square matrix.
+ *
+ * Closed-form adjugate for N <= 4; Gauss-Jordan elimination with partial
+ * pivoting on stack storage otherwise.
+ *
+ * @throws std::runtime_error If the matrix is singular: |det| <= TOL * max|a_ij|^N for the
+ *         closed forms, so the check does not depend on the scale of the matrix, or a
+ *         pivot below TOL as in inverse(const ndarray<T>&).
+ */
+template<typename T, size_t N>
+static_ndarray<T, N, N> inverse(const static_ndarray<T, N, N>& a) {
+    static_ndarray<T, N, N> r;
+    if constexpr (N == 1) {
+        if (a[0] == T{0}) throw std::runtime_error("Matrix is singular");
+        r[0] = T{1} / a[0];
+    } else if constexpr (N == 2) {
+        const T det = determinant(a);
+        if (std::abs(det) <= singular_threshold(a)) throw std::runtime_error("Matrix is singular");
+        const T inv_det = T{1} / det;
+        r[0] = a[3] * inv_det;
+        r[1] = -a[1] * inv_det;
+        r[2] = -a[2] * inv_det;
+        r[3] = a[0] * inv_det;
+    } else if constexpr (N == 3) {
+        const T b00 = a[4] * a[8] - a[5] * a[7];
+        const T b10 = a[5] * a[6] - a[3] * a[8];
+        const T b20 = a[3] * a[7] - a[4] * a[6];
+        const T det = a[0] * b00 + a[1] * b10 + a[2] * b20;
+        if (std::abs(det) <= singular_threshold(a)) throw std::runtime_error("Matrix is singular");
+        const T inv_det = T{1} / det;
+        r[0] = b00 * inv_det;
+        r[1] = (a[2] * a[7] - a[1] * a[8]) * inv_det;
+        r[2] = (a[1] * a[5] - a[2] * a[4]) * inv_det;
+        r[3] = b10 * inv_det;
+        r[4] = (a[0] * a[8] - a[2] * a[6]) * inv_det;
+        r[5] = (a[2] * a[3] - a[0] * a[5]) * inv_det;
+        r[6] = b20 * inv_det;
+        r[7] = (a[1] * a[6] - a[0] * a[7]) * inv_det;
+        r[8] = (a[0] * a[4] - a[1] * a[3]) * inv_det;
+    } else if constexpr (N == 4) {
+        const T s0 = a[0] * a[5] - a[4] * a[1];
+        const T s1 = a[0] * a[6] - a[4] * a[2];
+        const T s2 = a[0] * a[7] - a[4] * a[3];
+        const T s3 = a[1] * a[6] - a[5] * a[2];
+        const T s4 = a[1] * a[7] - a[5] * a[3];
+        const T s5 = a[2] * a[7] - a[6] * a[3];
+        const T c5 = a[10] * a[15] - a[14] * a[11];
+        const T c4 = a[9] * a[15] - a[13] * a[11];
+        const T c3 = a[9] * a[14] - a[13] * a[10];
+        const T c2 = a[8] * a[15] - a[12] * a[11];
+        const T c1 = a[8] * a[14] - a[12] * a[10];
+        const T c0 = a[8] * a[13] - a[12] * a[9];
+        const T det = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+        if (std::abs(det) <= singular_threshold(a)) throw std::runtime_error("Matrix is singular");
+        const T inv_det = T{1} / det;
+        r[0]  = ( a[5] * c5 - a[6] * c4 + a[7] * c3) * inv_det;
+        r[1]  = (-a[1] * c5 + a[2] * c4 - a[3] * c3) * inv_det;
+        r[2]  = ( a[13] * s5 - a[14] * s4 + a[15] * s3) * inv_det;
+        r[3]  = (-a[9] * s5 + a[10] * s4 - a[11] * s3) * inv_det;
+        r[4]  = (-a[4] * c5 + a[6] * c2 - a[7] * c1) * inv_det;
+        r[5]  = ( a[0] * c5 - a[2] * c2 + a[3] * c1) * inv_det;
+        r[6]  = (-a[12] * s5 + a[14] * s2 - a[15] * s1) * inv_det;
+        r[7]  = ( a[8] * s5 - a[10] * s2 + a[11] * s1) * inv_det;
+        r[8]  = ( a[4] * c4 - a[5] * c2 + a[7] * c0) * inv_det;
+        r[9]  = (-a[0] * c4 + a[1] * c2 - a[3] * c0) * inv_det;
+        r[10] = ( a[12] * s4 - a[13] * s2 + a[15] * s0) * inv_det;
+        r[11] = (-a[8] * s4 + a[9] * s2 - a[11] * s0) * inv_det;
+        r[12] = (-a[4] * c3 + a[5] * c1 - a[6] * c0) * inv_det;
+        r[13] = ( a[0] * c3 - a[1] * c1 + a[2] * c0) * inv_det;
+        r[14] = (-a[12] * s3 + a[13] * s1 - a[14] * s0) * inv_det;
+        r[15] = ( a[8] * s3 - a[9] * s1 + a[10] * s0) * inv_det;
+    } else {
+        static_ndarray<T, N, N> m = a;
+        r = static_ndarray<T, N, N>::identity();
+        for (size_t i = 0; i < N; ++i) {
+            size_t p = i;
+            for (size_t k = i + 1; k < N; ++k)
+                if (std::abs(m(k, i)) > std::abs(m(p, i))) p = k;
+            if (std::abs(m(p, i)) < TOL) throw std::runtime_error("Matrix is singular");
+            if (p != i) {
+                for (size_t j = 0; j < N; ++j) {
+                    std::swap(m(i, j), m(p, j));
+                    std::swap(r(i, j), r(p, j));
+                }
+            }
+            const T inv_pivot = T{1} / m(i, i);
+            for (size_t j = 0; j < N; ++j) {
+                m(i, j) *= inv_pivot;
+                r(i, j) *= inv_pivot;
+            }
+            for (size_t k = 0; k < N; ++k) {
+                if (k == i) continue;
+                const T f = m(k, i);
+                for (size_t j = 0; j < N; ++j) {
+                    m(k, j) -= f * m(i, j);
+                    r(k, j) -= f * r(i, j);
+                }
+            }
+        }
+    }
+    return r;
+}
+
+} // namespace numbits
@@ -0,0 +1,774 @@
+/**
+ * @file statistics.hpp
+ * @brief Order statistics and histograms.
+ *
+ * Provides:
+ *   - quantile(), percentile(), median(): over the whole array or along an
+ *     axis, for one or several quantiles, with linear interpolation
+ *   - histogram(): counts in uniform bins
+ *   - bincount(): occurrences (or summed weights) of non-negative integers
+ *   - var(), std(), skew(), kurtosis(): central moments over the whole
+ *     array or along an axis
+ *
+ * Quantiles never fully sort: a single quantile selects its rank with
+ * introselect and takes the next order statistic as the minimum of the
+ * upper part; several quantiles are selected together by recursive
+ * multi-selection. Histogram and bincount compute bin indices in
+ * branch-free blocks and count into per-thread bin arrays that are summed
+ * at the end.
+ *
+ * Moments are accumulated in a single pass over memory: each block of
+ * MOMENT_BLOCK elements is reduced exactly around its own mean while it is
+ * in cache, and blocks, thread chunks and lanes are combined with the
+ * pairwise update of Chan et al. (extended to third and fourth moments by
+ * Pebay). This avoids the cancellation of the sum-of-squares formula.
+ *
+ * @namespace numbits
+ */
+
+#pragma once
+
+#include "ndarray.hpp"
+#include "sorting.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace numbits {
+
+/**
+ * @brief Result type of quantiles: T for floating-point input, double otherwise.
+ */
+template<typename T>
+using quantile_t = std::conditional_t<std::is_floating_point_v<T>, T, double>;
+
+/**
+ * @brief Number of elements whose bin indices are computed per block.
+ */
+constexpr size_t HISTOGRAM_BLOCK = 256;
+
+/**
+ * @brief Minimum number of input bytes before histogram and bincount run in parallel.
+ */
+constexpr size_t HISTOGRAM_PARALLEL_BYTES = size_t(1) << 16;
+
+/**
+ * @brief Number of contiguous elements reduced around a common mean before merging.
+ */
+constexpr size_t MOMENT_BLOCK = 256;
+
+/**
+ * @brief Minimum number of input bytes before moments are computed in parallel.
+ */
+constexpr size_t MOMENT_PARALLEL_BYTES = size_t(1) << 16;
+
+/**
+ * @brief Place the order statistics `ranks[rb, re)` (sorted) of `v[first, last)`.
+ *
+ * Selects the middle rank with introselect, which partitions the range,
+ * then recurses into each side with the ranks that fall there. Costs
+ * O(n log m) for m ranks instead of a full sort.
+ */
+template<typename T>
+void multi_select(T* v, size_t first, size_t last, const size_t* rb, const size_t* re) {
+    while (rb != re && first < last) {
+        const size_t* mid = rb + (re - rb) / 2;
+        std::nth_element(v + first, v + *mid, v + last, sort_less<T>);
+        multi_select(v, first, *mid, rb, mid);
+        first = *mid + 1;
+        rb = mid + 1;
+    }
+}
+
+/**
+ * @brief Compute quantiles of a lane that may be reordered.
+ *
+ * Writes `out[k * out_stride]` for every `qs[k]`, interpolating linearly
+ * between the neighbouring order statistics (NumPy's default method).
+ * A lane containing NaN yields NaN.
+ */
+template<typename T>
+void quantiles_of_lane(T* v, size_t n, const std::vector<double>& qs,
+                       quantile_t<T>* out, size_t out_stride) {
+    using R = quantile_t<T>;
+    if constexpr (std::is_floating_point_v<T>) {
+        for (size_t i = 0; i < n; ++i) {
+            if (std::isnan(v[i])) {
+                for (size_t k = 0; k < qs.size(); ++k) out[k * out_stride] = std::numeric_limits<R>::quiet_NaN();
+                return;
+            }
+        }
+    }
+
+    std::vector<size_t> ranks;
+    ranks.reserve(2 * qs.size());
+    for (double q : qs) {
+        size_t lo = static_cast<size_t>(std::floor(q * static_cast<double>(n - 1)));
+        ranks.push_back(lo);
+        if (lo + 1 < n) ranks.push_back(lo + 1);
+    }
+    std::sort(ranks.begin(), ranks.end());
+    ranks.erase(std::unique(ranks.begin(), ranks.end()), ranks.end());
+
+    if (ranks.size() <= 2 && ranks.back() - ranks.front() <= 1) {
+        // One quantile: select its rank, then the next value is the upper part's minimum
+        std::nth_element(v, v + ranks.front(), v + n, sort_less<T>);
+        if (ranks.size() == 2) std::iter_swap(v + ranks.back(), std::min_element(v + ranks.back(), v + n, sort_less<T>));
+    } else {
+        multi_select(v, 0, n, ranks.data(), ranks.data() + ranks.size());
+    }
+
+    for (size_t k = 0; k < qs.size(); ++k) {
+        double pos = qs[k] * static_cast<double>(n - 1);
+        size_t lo = static_cast<size_t>(std::floor(pos));
+        size_t hi = std::min(lo + 1, n - 1);
+        double frac = pos - static_cast<double>(lo);
+        double a = static_cast<double>(v[lo]), b = static_cast<double>(v[hi]);
+        out[k * out_stride] = static_cast<R>(frac == 0.0 ? a : a + frac * (b - a));
+    }
+}
+
+/**
+ * @brief Validate quantiles.
+ *
+ * @throws std::runtime_error If a quantile lies outside [0, 1].
+ */
+inline void check_quantiles(const std::vector<double>& qs) {
+    for (double q : qs)
+        if (!(q >= 0.0 && q <= 1.0)) throw std::runtime_error("Quantiles must be in the range [0, 1]");
+}
+
+/**
+ * @brief Quantiles of all elements.
+ *
+ * Matches NumPy `quantile(arr, qs)` with linear interpolation.
+ *
+ * @return ndarray<quantile_t<T>> One value per quantile, shape {qs.size()}
+ *
+ * @throws std::runtime_error If arr is empty or a quantile lies outside [0, 1]
+ */
+template<typename T>
+ndarray<quantile_t<T>> quantile(const ndarray<T>& arr, const std::vector<double>& qs) {
+    check_quantiles(qs);
+    if (arr.size() == 0) throw std::runtime_error("quantile of an empty array");
+    std::vector<T> values(arr.begin(), arr.end());
+    ndarray<quantile_t<T>> result(Shape{qs.size()});
+    if (!qs.empty()) quantiles_of_lane(values.data(), values.size(), qs, result.data(), 1);
+    return result;
+}
+
+/**
+ * @brief Quantiles along an axis.
+ *
+ * Matches NumPy `quantile(arr, qs, axis)`: the result has shape
+ * `{qs.size()} + arr.shape` with `axis` removed. Lanes are processed in
+ * parallel for large arrays.
+ *
+ * @code
+ * auto q = quantile(prices, {0.05, 0.5, 0.95}, 0);   // per-column, shape {3, ncols}
+ * @endcode
+ *
+ * @throws std::runtime_error If the axis is empty or out of range, or a quantile lies outside [0, 1]
+ */
+template<typename T>
+ndarray<quantile_t<T>> quantile(const ndarray<T>& arr, const std::vector<double>& qs, int axis) {
+    check_quantiles(qs);
+    const size_t ax = normalize_axis(axis, arr.ndim());
+    AxisSplit split = split_axis(arr.shape(), ax);
+    if (split.len == 0) throw std::runtime_error("quantile along an empty axis");
+
+    Shape out_shape = arr.shape();
+    out_shape.erase(out_shape.begin() + static_cast<std::ptrdiff_t>(ax));
+    out_shape.insert(out_shape.begin(), qs.size());
+    ndarray<quantile_t<T>> result(out_shape);
+    if (result.size() == 0) return result;
+
+    const T* src = arr.data();
+    quantile_t<T>* out = result.data();
+    const size_t len = split.len, inner = split.inner;
+    const size_t lanes = split.outer * inner;
+    const bool parallel = arr.size() * sizeof(T) >= SORT_PARALLEL_BYTES;
+
+    for_each_lane<std::vector<T>>(split, parallel, [&](std::vector<T>& buf, size_t base) {
+        buf.resize(len);
+        load_lane(src + base, len, inner, buf.data());
+        size_t lane = (base / (len * inner)) * inner + base % inner;
+        quantiles_of_lane(buf.data(), len, qs, out + lane, lanes);
+    });
+    return result;
+}
+
+/**
+ * @brief Single quantile of all elements.
+ *
+ * @throws std::runtime_error If arr is empty or q lies outside [0, 1]
+ */
+template<typename T>
+quantile_t<T> quantile(const ndarray<T>& arr, double q) {
+    return quantile(arr, std::vector<double>{q})[0];
+}
+
+/**
+ * @brief Single quantile along an axis; the result has `axis` removed.
+ */
+template<typename T>
+ndarray<quantile_t<T>> quantile(const ndarray<T>& arr, double q, int axis) {
+    ndarray<quantile_t<T>> all = quantile(arr, std::vector<double>{q}, axis);
+    Shape shape(all.shape().begin() + 1, all.shape().end());
+    return all.reshape(shape);
+}
+
+/**
+ * @brief Percentiles (quantiles scaled to [0, 100]) of all elements.
+ */
+template<typename T>
+ndarray<quantile_t<T>> percentile(const ndarray<T>& arr, const std::vector<double>& ps) {
+    std::vector<double> qs(ps.size());
+    for (size_t i = 0; i < ps.size(); ++i) qs[i] = ps[i] / 100.0;
+    return quantile(arr, qs);
+}
+
+/**
+ * @brief Percentiles along an axis; the result has shape `{ps.size()}` + reduced shape.
+ */
+template<typename T>
+ndarray<quantile_t<T>> percentile(const ndarray<T>& arr, const std::vector<double>& ps, int axis) {
+    std::vector<double> qs(ps.size());
+    for (size_t i = 0; i < ps.size(); ++i) qs[i] = ps[i] / 100.0;
+    return quantile(arr, qs, axis);
+}
+
+/**
+ * @brief Single percentile of all elements.
+ */
+template<typename T>
+quantile_t<T> percentile(const ndarray<T>& arr, double p) {
+    return quantile(arr, p / 100.0);
+}
+
+/**
+ * @brief Single percentile along an axis; the result has `axis` removed.
+ */
+template<typename T>
+ndarray<quantile_t<T>> percentile(const ndarray<T>& arr, double p, int axis) {
+    return quantile(arr, p / 100.0, axis);
+}
+
+/**
+ * @brief Median of all elements.
+ *
+ * @throws std::runtime_error If arr is empty
+ */
+template<typename T>
+quantile_t<T> median(const ndarray<T>& arr) {
+    return quantile(arr, 0.5);
+}
+
+/**
+ * @brief Median along an axis; the result has `axis` removed.
+ *
+ * @code
+ * auto col_medians = median(table, 0);
+ * @endcode
+ */
+template<typename T>
+ndarray<quantile_t<T>> median(const ndarray<T>& arr, int axis) {
+    return quantile(arr, 0.5, axis);
+}
+
+/**
+ * @struct Moments
+ * @brief Count, mean and central sums of powers of a sample, mergeable across parts.
+ *
+ * `m2`, `m3` and `m4` are sums of (x - mean)^k; `m3` and `m4` are only
+ * maintained when `Order` is 4.
+ */
+template<typename A, int Order>
+struct Moments {
+    static_assert(Order == 2 || Order == 4, "Moments tracks order 2 or 4");
+    A n = A(0);
+    A mean = A(0);
+    A m2 = A(0);
+    A m3 = A(0);
+    A m4 = A(0);
+
+    /**
+     * @brief Welford's update (Terriberry's form for higher orders) of one value `x`.
+     *
+     * `n1` is the count before the update and `inv` is 1 / (n1 + 1). Works
+     * on separate accumulators so that it can update arrays of lanes.
+     */
+    static void update(A& mean, A& m2, A& m3, A& m4, A x, A n1, A inv) {
+        const A n = n1 + A(1);
+        const A delta = x - mean;
+        const A dn = delta * inv;
+        const A term = delta * dn * n1;
+        if constexpr (Order == 4) {
+            const A dn2 = dn * dn;
+            m4 += term * dn2 * (n * n - A(3) * n + A(3)) + A(6) * dn2 * m2 - A(4) * dn * m3;
+            m3 += term * dn * (n - A(2)) - A(3) * dn * m2;
+        }
+        mean += dn;
+        m2 += term;
+    }
+
+    /** @brief Add one value. */
+    void push(A x) {
+        update(mean, m2, m3, m4, x, n, A(1) / (n + A(1)));
+        n += A(1);
+    }
+
+    /** @brief Combine with the moments of a disjoint sample. */
+    void merge(const Moments& b) {
+        if (b.n == A(0)) return;
+        if (n == A(0)) { *this = b; return; }
+        const A na = n, nb = b.n, total = na + nb;
+        const A delta = b.mean - mean;
+        const A d2 = delta * delta;
+        if constexpr (Order == 4) {
+            m4 += b.m4 + d2 * d2 * na * nb * (na * na - na * nb + nb * nb) / (total * total * total)
+                + A(6) * d2 * (na * na * b.m2 + nb * nb * m2) / (total * total)
+                + A(4) * delta * (na * b.m3 - nb * m3) / total;
+            m3 += b.m3 + d2 * delta * na * nb * (na - nb) / (total * total)
+                + A(3) * delta * (na * b.m2 - nb * m2) / total;
+        }
+        m2 += b.m2 + d2 * na * nb / total;
+        mean += delta * nb / total;
+        n = total;
+    }
+};
+
+/**
+ * @brief Moments of `n` contiguous elements, reduced block by block.
+ *
+ * Each block's mean is taken first, then its central sums in a second
+ * sweep over the same (cached) elements; the block is then merged.
+ */
+template<typename A, int Order, typename T>
+Moments<A, Order> moments_of_run(const T* x, size_t n) {
+    Moments<A, Order> acc;
+    for (size_t lo = 0; lo < n; lo += MOMENT_BLOCK) {
+        const size_t nb = std::min(MOMENT_BLOCK, n - lo);
+        const T* p = x + lo;
+        A s = A(0);
+        for (size_t i = 0; i < nb; ++i) s += static_cast<A>(p[i]);
+        Moments<A, Order> block;
+        block.n = static_cast<A>(nb);
+        block.mean = s / block.n;
+        A s2 = A(0), s3 = A(0), s4 = A(0);
+        for (size_t i = 0; i < nb; ++i) {
+            const A d = static_cast<A>(p[i]) - block.mean;
+            const A d2 = d * d;
+            s2 += d2;
+            if constexpr (Order == 4) {
+                s3 += d2 * d;
+                s4 += d2 * d2;
+            }
+        }
+        block.m2 = s2;
+        block.m3 = s3;
+        block.m4 = s4;
+        acc.merge(block);
+    }
+    return acc;
+}
+
+/**
+ * @brief Moments of all elements; thread chunks are merged in order.
+ */
+template<typename A, int Order, typename T>
+Moments<A, Order> moments_of(const ndarray<T>& arr) {
+    const T* x = arr.data();
+    const size_t n = arr.size();
+    size_t chunks = 1;
+#ifdef _OPENMP
+    if (n * sizeof(T) >= MOMENT_PARALLEL_BYTES)
+        chunks = std::min(static_cast<size_t>(omp_get_max_threads()), (n + MOMENT_BLOCK - 1) / MOMENT_BLOCK);
+#endif
+    if (chunks <= 1) return moments_of_run<A, Order>(x, n);
+    std::vector<Moments<A, Order>> parts(chunks);
+    const index_t nc = static_cast<index_t>(chunks);
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(static)
+#endif
+    for (index_t c = 0; c < nc; ++c) {
+        const size_t lo = n * static_cast<size_t>(c) / chunks, hi = n * (static_cast<size_t>(c) + 1) / chunks;
+        parts[static_cast<size_t>(c)] = moments_of_run<A, Order>(x + lo, hi - lo);
+    }
+    for (size_t c = 1; c < chunks; ++c) parts[0].merge(parts[c]);
+    return parts[0];
+}
+
+/**
+ * @brief Reduce every lane along `axis` to `finish(moments)`; the result has `axis` removed.
+ *
+ * Contiguous lanes use moments_of_run(); lanes along an outer axis are
+ * updated row by row in groups of adjacent columns.
+ *
+ * @throws std::runtime_error If axis is out of range
+ */
+template<typename R, typename A, int Order, typename T, typename Finish>
+ndarray<R> moments_along(const ndarray<T>& arr, int axis, Finish finish) {
+    const size_t ax = normalize_axis(axis, arr.ndim());
+    const AxisSplit split = split_axis(arr.shape(), ax);
+    Shape out_shape;
+    for (size_t i = 0; i < arr.ndim(); ++i)
+        if (i != ax) out_shape.push_back(arr.shape()[i]);
+    ndarray<R> result(out_shape);
+    if (result.size() == 0) return result;
+    if (split.len == 0) {
+        // Moments of empty lanes are undefined
+        result.fill(std::numeric_limits<R>::quiet_NaN());
+        return result;
+    }
+    if (split.outer * split.inner == 1) {
+        result[0] = finish(moments_of<A, Order>(arr));
+        return result;
+    }
+    const T* in = arr.data();
+    R* out = result.data();
+    const size_t len = split.len, stride = split.inner;
+    for_each_lane_group(split, arr.size() * sizeof(T) >= MOMENT_PARALLEL_BYTES, [=](size_t base, size_t width) {
+        R* dst = out + (base / (len * stride)) * stride + base % stride;
+        if (stride == 1) {
+            dst[0] = finish(moments_of_run<A, Order>(in + base, len));
+            return;
+        }
+        // One array per accumulator so the update vectorizes across columns
+        A mean[LANE_GROUP_COLUMNS] = {}, m2[LANE_GROUP_COLUMNS] = {};
+        A m3[LANE_GROUP_COLUMNS] = {}, m4[LANE_GROUP_COLUMNS] = {};
+        for (size_t j = 0; j < len; ++j) {
+            const T* row = in + base + j * stride;
+            const A n1 = static_cast<A>(j), inv = A(1) / static_cast<A>(j + 1);
+            for (size_t c = 0; c < width; ++c)
+                Moments<A, Order>::update(mean[c], m2[c], m3[c], m4[c], static_cast<A>(row[c]), n1, inv);
+        }
+        for (size_t c = 0; c < width; ++c) {
+            Moments<A, Order> m;
+            m.n = static_cast<A>(len);
+            m.mean = mean[c];
+            m.m2 = m2[c];
+            m.m3 = m3[c];
+            m.m4 = m4[c];
+            dst[c] = finish(m);
+        }
+    });
+    return result;
+}
+
+/**
+ * @brief Sample variance m2 / (n - ddof); NaN when n <= ddof.
+ */
+template<typename R, typename A, int Order>
+R variance_of(const Moments<A, Order>& m, size_t ddof) {
+    const A dof = m.n - static_cast<A>(ddof);
+    return dof > A(0) ? static_cast<R>(m.m2 / dof) : std::numeric_limits<R>::quiet_NaN();
+}
+
+/**
+ * @brief Variance of all elements, computed in one pass.
+ *
+ * Matches NumPy `var(arr, ddof=ddof)`. Returns NaN if the array has no
+ * more than `ddof` elements.
+ */
+template<typename T>
+quantile_t<T> var(const ndarray<T>& arr, size_t ddof = 0) {
+    using R = quantile_t<T>;
+    return variance_of<R>(moments_of<double, 2>(arr), ddof);
+}
+
+/**
+ * @brief Variance along an axis; the result has `axis` removed.
+ *
+ * @code
+ * auto col_var = var(table, 0);        // population variance per column
+ * auto row_var = var(table, 1, 1);     // sample variance per row
+ * @endcode
+ *
+ * @throws std::runtime_error If axis is out of range
+ */
+template<typename T>
+ndarray<quantile_t<T>> var(const ndarray<T>& arr, int axis, size_t ddof = 0) {
+    using R = quantile_t<T>;
+    return moments_along<R, double, 2>(arr, axis, [ddof](const Moments<double, 2>& m) {
+        return variance_of<R>(m, ddof);
+    });
+}
+
+/**
+ * @brief Standard deviation of all elements (square root of var()).
+ */
+template<typename T>
+quantile_t<T> std(const ndarray<T>& arr, size_t ddof = 0) {
+    return static_cast<quantile_t<T>>(std::sqrt(var(arr, ddof)));
+}
+
+/**
+ * @brief Standard deviation along an axis; the result has `axis` removed.
+ * @throws std::runtime_error If axis is out of range
+ */
+template<typename T>
+ndarray<quantile_t<T>> std(const ndarray<T>& arr, int axis, size_t ddof = 0) {
+    using R = quantile_t<T>;
+    return moments_along<R, double, 2>(arr, axis, [ddof](const Moments<double, 2>& m) {
+        return static_cast<R>(std::sqrt(variance_of<R>(m, ddof)));
+    });
+}
+
+/**
+ * @brief Sample skewness m3 / m2^1.5 (scaled), optionally bias-corrected.
+ */
+template<typename R>
+R skew_of(const Moments<double, 4>& m, bool bias) {
+    const double n = m.n;
+    if (n == 0.0 || (!bias && n < 3.0)) return std::numeric_limits<R>::quiet_NaN();
+    double g1 = std::sqrt(n) * m.m3 / std::pow(m.m2, 1.5);
+    if (!bias) g1 *= std::sqrt(n * (n - 1.0)) / (n - 2.0);
+    return static_cast<R>(g1);
+}
+
+/**
+ * @brief Sample kurtosis n * m4 / m2^2, optionally bias-corrected; minus 3 if `fisher`.
+ */
+template<typename R>
+R kurtosis_of(const Moments<double, 4>& m, bool fisher, bool bias) {
+    const double n = m.n;
+    if (n == 0.0 || (!bias && n < 4.0)) return std::numeric_limits<R>::quiet_NaN();
+    double g2 = n * m.m4 / (m.m2 * m.m2);
+    if (!bias) g2 = ((n * n - 1.0) * g2 - 3.0 * (n - 1.0) * (n - 1.0)) / ((n - 2.0) * (n - 3.0)) + 3.0;
+    return static_cast<R>(fisher ? g2 - 3.0 : g2);
+}
+
+/**
+ * @brief Skewness of all elements.
+ *
+ * Matches SciPy `stats.skew(arr, axis=None, bias=bias)`. A constant
+ * sample yields NaN.
+ */
+template<typename T>
+quantile_t<T> skew(const ndarray<T>& arr, bool bias = true) {
+    return skew_of<quantile_t<T>>(moments_of<double, 4>(arr), bias);
+}
+
+/**
+ * @brief Skewness along an axis; the result has `axis` removed.
+ * @throws std::runtime_error If axis is out of range
+ */
+template<typename T>
+ndarray<quantile_t<T>> skew(const ndarray<T>& arr, int axis, bool bias = true) {
+    using R = quantile_t<T>;
+    return moments_along<R, double, 4>(arr, axis, [bias](const Moments<double, 4>& m) {
+        return skew_of<R>(m, bias);
+    });
+}
+
+/**
+ * @brief Kurtosis of all elements.
+ *
+ * Matches SciPy `stats.kurtosis(arr, axis=None, fisher=fisher, bias=bias)`:
+ * by default the excess kurtosis (0 for a normal distribution).
+ */
+template<typename T>
+quantile_t<T> kurtosis(const ndarray<T>& arr, bool fisher = true, bool bias = true) {
+    return kurtosis_of<quantile_t<T>>(moments_of<double, 4>(arr), fisher, bias);
+}
+
+/**
+ * @brief Kurtosis along an axis; the result has `axis` removed.
+ * @throws std::runtime_error If axis is out of range
+ */
+template<typename T>
+ndarray<quantile_t<T>> kurtosis(const ndarray<T>& arr, int axis, bool fisher = true, bool bias = true) {
+    using R = quantile_t<T>;
+    return moments_along<R, double, 4>(arr, axis, [fisher, bias](const Moments<double, 4>& m) {
+        return kurtosis_of<R>(m, fisher, bias);
+    });
+}
+
+/**
+ * @brief Count into per-thread bin arrays, then sum them.
+ *
+ * `fn(lo, hi, bins)` adds the contributions of elements [lo, hi) to a
+ * zero-initialized array of `nbins` counters owned by the calling thread.
+ */
+template<typename C, typename Fn>
+std::vector<C> accumulate_bins(size_t n, size_t nbins, bool parallel, Fn fn) {
+    std::vector<C> total(nbins, C(0));
+    (void)parallel;
+#ifdef _OPENMP
+    if (parallel) {
+        const size_t threads = static_cast<size_t>(omp_get_max_threads());
+        std::vector<std::vector<C>> partial(threads);
+        #pragma omp parallel num_threads(static_cast<int>(threads))
+        {
+            const size_t t = static_cast<size_t>(omp_get_thread_num());
+            const size_t count = static_cast<size_t>(omp_get_num_threads());
+            partial[t].assign(nbins, C(0));
+            fn(n * t / count, n * (t + 1) / count, partial[t].data());
+        }
+        for (const auto& local : partial)
+            for (size_t b = 0; b < local.size(); ++b) total[b] += local[b];
+        return total;
+    }
+#endif
+    fn(size_t(0), n, total.data());
+    return total;
+}
+
+/**
+ * @struct Histogram
+ * @brief Counts and bin edges returned by histogram().
+ */
+struct Histogram {
+    ndarray<int64_t> counts;   ///< Number of values per bin, shape {bins}
+    ndarray<double> bin_edges; ///< Bin edges, shape {bins + 1}
+};
+
+/**
+ * @brief Histogram of all elements over `bins` uniform bins spanning [lo, hi].
+ *
+ * Matches NumPy `histogram(arr, bins, range=(lo, hi))`: bins are half-open
+ * except the last, which includes `hi`; values outside the range and NaN
+ * are ignored.
+ *
+ * Bin indices are computed for blocks of HISTOGRAM_BLOCK elements in a
+ * branch-free loop (out-of-range values go to a discard bin), then counted
+ * into per-thread bins.
+ *
+ * @throws std::runtime_error If bins is zero or the range is invalid
+ */
+template<typename T>
+Histogram histogram(const ndarray<T>& arr, size_t bins, double lo, double hi) {
+    if (bins == 0) throw std::runtime_error("histogram: bins must be positive");
+    if (!(lo < hi) || !std::isfinite(lo) || !std::isfinite(hi))
+        throw std::runtime_error("histogram: range must be finite with lo < hi");
+
+    Histogram result{ndarray<int64_t>(Shape{bins}), ndarray<double>(Shape{bins + 1})};
+    double* edges = result.bin_edges.data();
+    const double width = (hi - lo) / static_cast<double>(bins);
+    for (size_t b = 0; b <= bins; ++b) edges[b] = lo + static_cast<double>(b) * width;
+    edges[bins] = hi;
+
+    const T* src = arr.data();
+    const double scale = static_cast<double>(bins) / (hi - lo);
+    const double last = static_cast<double>(bins - 1);
+    const double discard = static_cast<double>(bins);
+    const bool parallel = arr.size() * sizeof(T) >= HISTOGRAM_PARALLEL_BYTES;
+
+    std::vector<int64_t> counts = accumulate_bins<int64_t>(arr.size(), bins + 1, parallel,
+        [&](size_t begin, size_t end, int64_t* local) {
+            uint32_t idx[HISTOGRAM_BLOCK];
+            for (size_t i = begin; i < end; i += HISTOGRAM_BLOCK) {
+                const size_t m = std::min(HISTOGRAM_BLOCK, end - i);
+                for (size_t j = 0; j < m; ++j) {
+                    double x = static_cast<double>(src[i + j]);
+                    bool in = x >= lo && x <= hi;
+                    double f = std::min((x - lo) * scale, last);
+                    idx[j] = static_cast<uint32_t>(in ? f : discard);
+                }
+                for (size_t j = 0; j < m; ++j) {
+                    size_t k = idx[j];
+                    if (k < bins) {
+                        // Correct rounding at bin edges, as NumPy does
+                        double x = static_cast<double>(src[i + j]);
+                        if (x < edges[k]) --k;
+                        else if (k + 1 < bins && x >= edges[k + 1]) ++k;
+                    }
+                    ++local[k];
+                }
+            }
+        });
+    std::copy(counts.begin(), counts.begin() + static_cast<std::ptrdiff_t>(bins), result.counts.data());
+    return result;
+}
+
+/**
+ * @brief Histogram over the range of the finite data.
+ *
+ * Uses [min, max] of the non-NaN values; a constant array uses
+ * [value - 0.5, value + 0.5] as NumPy does.
+ */
+template<typename T>
+Histogram histogram(const ndarray<T>& arr, size_t bins = 10) {
+    double lo = std::numeric_limits<double>::infinity();
+    double hi = -lo;
+    for (size_t i = 0; i < arr.size(); ++i) {
+        double x = static_cast<double>(arr[i]);
+        if (std::isnan(x)) continue;
+        lo = std::min(lo, x);
+        hi = std::max(hi, x);
+    }
+    if (lo > hi) { lo = 0.0; hi = 1.0; }
+    if (lo == hi) { lo -= 0.5; hi += 0.5; }
+    return histogram(arr, bins, lo, hi);
+}
+
+/**
+ * @brief Largest value of a non-negative integer array, for sizing bincount().
+ *
+ * @throws std::runtime_error If any value is negative
+ */
+template<typename T>
+size_t bincount_length(const ndarray<T>& x, size_t minlength) {
+    static_assert(std::is_integral_v<T> && !std::is_same_v<T, bool>, "bincount requires an integer array");
+    T lo = 0, hi = 0;
+    for (size_t i = 0; i < x.size(); ++i) {
+        lo = std::min(lo, x[i]);
+        hi = std::max(hi, x[i]);
+    }
+    if (lo < 0) throw std::runtime_error("bincount: input must be non-negative");
+    return std::max(minlength, x.size() == 0 ? size_t(0) : static_cast<size_t>(hi) + 1);
+}
+
+/**
+ * @brief Number of occurrences of each value in a non-negative integer array.
+ *
+ * Matches NumPy `bincount(x, minlength=...)`; counts are accumulated in
+ * per-thread bins.
+ *
+ * @return ndarray<int64_t> Shape {max(max(x) + 1, minlength)}
+ *
+ * @throws std::runtime_error If any value is negative
+ */
+template<typename T>
+ndarray<int64_t> bincount(const ndarray<T>& x, size_t minlength = 0) {
+    const size_t nbins = bincount_length(x, minlength);
+    const T* src = x.data();
+    const bool parallel = x.size() * sizeof(T) >= HISTOGRAM_PARALLEL_BYTES;
+    std::vector<int64_t> counts = accumulate_bins<int64_t>(x.size(), nbins, parallel,
+        [src](size_t begin, size_t end, int64_t* local) {
+            for (size_t i = begin; i < end; ++i) ++local[static_cast<size_t>(src[i])];
+        });
+    return ndarray<int64_t>(Shape{nbins}, counts);
+}
+
+/**
+ * @brief Sum of `weights` for each value in a non-negative integer array.
+ *
+ * Matches NumPy `bincount(x, weights, minlength)`.
+ *
+ * @throws std::runtime_error If any value is negative or the shapes differ
+ */
+template<typename T, typename W>
+ndarray<double> bincount(const ndarray<T>& x, const ndarray<W>& weights, size_t minlength = 0) {
+    if (weights.shape() != x.shape()) throw std::runtime_error("bincount: weights must match the input shape");
+    const size_t nbins = bincount_length(x, minlength);
+    const T* src = x.data();
+    const W* w = weights.data();
+    const bool parallel = x.size() * sizeof(T) >= HISTOGRAM_PARALLEL_BYTES;
+    std::vector<double> sums = accumulate_bins<double>(x.size(), nbins, parallel,
+        [src, w](size_t begin, size_t end, double* local) {
+            for (size_t i = begin; i < end; ++i) local[static_cast<size_t>(src[i])] += static_cast<double>(w[i]);
+        });
+    return ndarray<double>(Shape{nbins}, sums);
+}
+
+} // namespace numbits
@@ -0,0 +1,265 @@
+/**
+ * @file strided_view.hpp
+ * @brief Non-owning strided views over ndarray storage.
+ *
+ * Provides strided_view, the result type of N-dimensional slicing:
+ *   - Arbitrary signed strides (negative steps, broadcast/newaxis strides of 0)
+ *   - O(1) creation; element access through operator()
+ *   - copy(): materialize into a contiguous ndarray, copying maximal
+ *     contiguous runs with memcpy and strided rows with a tight loop
+ *   - fill()/assign(): write through the view
+ *
+ * @namespace numbits
+ */
+
+#pragma once
+
+#include "ndarray.hpp"
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace numbits {
+
+/**
+ * @brief Signed per-dimension strides of a strided_view, in elements.
+ */
+using ViewStrides = SmallVector<index_t, MAX_INLINE_DIMS>;
+
+/**
+ * @brief Minimum number of bytes copied before view materialization runs in parallel.
+ */
+constexpr size_t VIEW_COPY_PARALLEL_BYTES = size_t(1) << 16;
+
+/**
+ * @brief Copy one row of `count` elements (memcpy for trivially copyable types).
+ */
+template<typename T>
+inline void copy_row(const T* src, size_t count, T* dst) {
+    if constexpr (std::is_trivially_copyable_v<T>) {
+        std::memcpy(dst, src, count * sizeof(T));
+    } else {
+        std::copy_n(src, count, dst);
+    }
+}
+
+/**
+ * @class strided_view
+ * @brief Window into another array's memory described by shape and signed strides.
+ *
+ * A view never owns its data: it stays valid only as long as the array it
+ * was created from, and writes through it modify that array. `T` may be
+ * const-qualified for read-only views.
+ *
+ * @code
+ * ndarray<float> batch(Shape{8, 64, 64, 3});
+ * auto crop = slice(batch, {ellipsis, Slice(16, 48), Slice(16, 48), Slice()});
+ * ndarray<float> dense = crop.copy();   // {8, 32, 32, 3}
+ * @endcode
+ *
+ * @tparam T Element type.
+ */
+template<typename T>
+class strided_view {
+public:
+    using value_type = std::remove_const_t<T>;
+
+    /**
+     * @brief Construct a view.
+     *
+     * @param data Pointer to the element at index (0, 0, ...).
+     * @param shape Extent of each dimension.
+     * @param strides Signed step of each dimension, in elements.
+     */
+    strided_view(T* data, const Shape& shape, const ViewStrides& strides)
+        : data_(data), shape_(shape), strides_(strides), size_(compute_size(shape)) {
+        if (shape_.size() != strides_.size())
+            throw std::runtime_error("strided_view: shape and strides differ in length");
+    }
+
+    /** @brief View covering a whole ndarray. */
+    template<typename U, typename = std::enable_if_t<std::is_same_v<std::remove_const_t<T>, U>>>
+    strided_view(ndarray<U>& arr)
+        : strided_view(arr.data(), arr.shape(), ViewStrides(arr.strides().begin(), arr.strides().end())) {}
+
+    /** @brief Read-only view covering a whole ndarray. */
+    template<typename U, typename = std::enable_if_t<std::is_same_v<T, const U>>>
+    strided_view(const ndarray<U>& arr)
+        : strided_view(arr.data(), arr.shape(), ViewStrides(arr.strides().begin(), arr.strides().end())) {}
+
+    /** @return Shape of the view. */
+    const Shape& shape() const { return shape_; }
+
+    /** @return Signed strides of the view. */
+    const ViewStrides& strides() const { return strides_; }
+
+    /** @return Number of dimensions. */
+    size_t ndim() const { return shape_.size(); }
+
+    /** @return Total number of elements. */
+    size_t size() const { return size_; }
+
+    /** @return Pointer to the first element. */
+    T* data() const { return data_; }
+
+    /**
+     * @return true if the elements are laid out densely in row-major order,
+     *         ignoring dimensions of extent 1.
+     */
+    bool is_contiguous() const {
+        index_t expected = 1;
+        for (size_t d = shape_.size(); d-- > 0;) {
+            if (shape_[d] == 1) continue;
+            if (strides_[d] != expected) return false;
+            expected *= static_cast<index_t>(shape_[d]);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Multi-index element access.
+     *
+     * Checked only when NUMBITS_DEBUG_BOUNDS is defined.
+     */
+    template<typename... Idx>
+    T& operator()(Idx... idx) const {
+        NUMBITS_BOUNDS_CHECK(sizeof...(Idx) == shape_.size());
+        index_t offset = 0;
+        size_t dim = 0;
+        ((NUMBITS_BOUNDS_CHECK(static_cast<size_t>(idx) < shape_[dim]),
+          offset += static_cast<index_t>(idx) * strides_[dim], ++dim), ...);
+        return data_[offset];
+    }
+
+    /**
+     * @brief Zero-copy ndarray over a contiguous view.
+     *
+     * @throws std::runtime_error If the view is not contiguous.
+     */
+    ndarray<value_type> as_ndarray() const {
+        if (!is_contiguous()) throw std::runtime_error("as_ndarray: view is not contiguous");
+        return ndarray<value_type>().create_view(shape_, compute_strides(shape_),
+                                                 const_cast<value_type*>(data_));
+    }
+
+    /**
+     * @brief Materialize the view into a new contiguous ndarray.
+     */
+    ndarray<value_type> copy() const {
+        ndarray<value_type> out(shape_);
+        if (size_ > 0) copy_to(out.data());
+        return out;
+    }
+
+    /**
+     * @brief Copy the elements, in row-major order, into `dst`.
+     *
+     * Trailing dimensions that are contiguous in memory are merged into one
+     * run copied with memcpy; otherwise the innermost dimension is copied
+     * with a strided loop. Runs are distributed over threads for large views.
+     */
+    void copy_to(value_type* dst) const {
+        if (size_ == 0) return;
+        for_each_run([&](const T* src, size_t len, index_t step, size_t out_offset) {
+            value_type* out = dst + out_offset;
+            if (step == 1) {
+                copy_row(src, len, out);
+            } else {
+                for (size_t j = 0; j < len; ++j) out[j] = src[static_cast<index_t>(j) * step];
+            }
+        });
+    }
+
+    /**
+     * @brief Set every element of the view to `value`.
+     */
+    void fill(const value_type& value) const {
+        static_assert(!std::is_const_v<T>, "fill requires a writable view");
+        for_each_run([&](T* dst, size_t len, index_t step, size_t) {
+            for (size_t j = 0; j < len; ++j) dst[static_cast<index_t>(j) * step] = value;
+        });
+    }
+
+    /**
+     * @brief Copy `src` (same shape, row-major contiguous) into the viewed elements.
+     *
+     * @throws std::runtime_error If shapes differ.
+     */
+    void assign(const ndarray<value_type>& src) const {
+        static_assert(!std::is_const_v<T>, "assign requires a writable view");
+        if (src.shape() != shape_)
+            throw std::runtime_error("assign: shape " + shape_to_string(src.shape()) +
+                                     " does not match view " + shape_to_string(shape_));
+        const value_type* in = src.data();
+        for_each_run([&](T* dst, size_t len, index_t step, size_t in_offset) {
+            if (step == 1) {
+                copy_row(in + in_offset, len, dst);
+            } else {
+                for (size_t j = 0; j < len; ++j) dst[static_cast<index_t>(j) * step] = in[in_offset + j];
+            }
+        });
+    }
+
+private:
+    /**
+     * @brief Call `fn(row_ptr, len, step, flat_offset)` for every innermost run.
+     *
+     * `flat_offset` is the row-major position of the run's first element.
+     */
+    template<typename Fn>
+    void for_each_run(Fn fn) const {
+        const size_t nd = shape_.size();
+        if (nd == 0) {
+            fn(data_, 1, 1, 0);
+            return;
+        }
+
+        // Merge trailing dimensions that form one dense run
+        size_t run = 1;
+        size_t outer_dims = nd;
+        while (outer_dims > 0 &&
+               (shape_[outer_dims - 1] == 1 || strides_[outer_dims - 1] == static_cast<index_t>(run))) {
+            run *= shape_[outer_dims - 1];
+            --outer_dims;
+        }
+
+        size_t len = run;
+        index_t step = 1;
+        if (run == 1) {
+            // Innermost dimension is strided
+            outer_dims = nd - 1;
+            len = shape_[nd - 1];
+            step = strides_[nd - 1];
+        }
+
+        size_t outer = 1;
+        for (size_t d = 0; d < outer_dims; ++d) outer *= shape_[d];
+
+        const index_t count = static_cast<index_t>(outer);
+        const bool parallel = outer > 1 && size_ * sizeof(value_type) >= VIEW_COPY_PARALLEL_BYTES;
+        (void)parallel;
+#ifdef _OPENMP
+        #pragma omp parallel for if(parallel) schedule(static)
+#endif
+        for (index_t o = 0; o < count; ++o) {
+            size_t rem = static_cast<size_t>(o);
+            index_t offset = 0;
+            for (size_t d = outer_dims; d-- > 0;) {
+                offset += static_cast<index_t>(rem % shape_[d]) * strides_[d];
+                rem /= shape_[d];
+            }
+            fn(data_ + offset, len, step, static_cast<size_t>(o) * len);
+        }
+    }
+
+    T* data_;
+    Shape shape_;
+    ViewStrides strides_;
+    size_t size_;
+};
+
+} // namespace numbits
@@ -4,9 +4,10 @@
  *
  * This header defines fundamental types for n-dimensional arrays (ndarrays) in NumBits:
  *   - Index and size types
- *   - Shape and strides representations
- *   - DType enum for supported data types
+ *   - Shape, strides and index representations (inline small-vector storage)
+ *   - DType enum for supported data types (including float16 and bfloat16 storage)
  *   - Compile-time utilities for mapping between C++ types and DType
+ *   - Runtime dispatch on a DType value (visit_dtype, dtype_size)
  *
  * @namespace numbits
  */
@@ -19,6 +20,8 @@
 #include <initializer_list>
 #include <type_traits>
 #include <stdexcept>
+#include "small_vector.hpp"
+#include "half.hpp"
 
 namespace numbits {
 
@@ -44,7 +47,10 @@ enum class DType {
     UINT16,   ///< 16-bit unsigned integer
     UINT32,   ///< 32-bit unsigned integer
     UINT64,   ///< 64-bit unsigned integer
-    BOOL      ///< Boolean type
+    BOOL,     ///< Boolean type
+    FLOAT16,  ///< 16-bit IEEE half-precision floating point
+    BFLOAT16, ///< 16-bit brain floating point (8-bit exponent)
+    INT8      ///< 8-bit signed integer
 };
 
 /**
@@ -70,6 +76,9 @@ constexpr DType dtype_from_type() {
     else if constexpr (std::is_same_v<T, uint32_t>) return DType::UINT32;
     else if constexpr (std::is_same_v<T, uint64_t>) return DType::UINT64;
     else if constexpr (std::is_same_v<T, bool>) return DType::BOOL;
+    else if constexpr (std::is_same_v<T, float16>) return DType::FLOAT16;
+    else if constexpr (std::is_same_v<T, bfloat16>) return DType::BFLOAT16;
+    else if constexpr (std::is_same_v<T, int8_t>) return DType::INT8;
     else static_assert(std::is_same_v<T, void>, "Unsupported type for dtype_from_type");
 }
 
@@ -96,19 +105,79 @@ template<> struct dtype_to_type<DType::UINT16>  { using type = uint16_t; };
 template<> struct dtype_to_type<DType::UINT32>  { using type = uint32_t; };
 template<> struct dtype_to_type<DType::UINT64>  { using type = uint64_t; };
 template<> struct dtype_to_type<DType::BOOL>    { using type = bool; };
+template<> struct dtype_to_type<DType::FLOAT16> { using type = float16; };
+template<> struct dtype_to_type<DType::BFLOAT16> { using type = bfloat16; };
+template<> struct dtype_to_type<DType::INT8>    { using type = int8_t; };
+
+/**
+ * @brief Empty tag carrying a type, passed to visit_dtype() callbacks.
+ */
+template<typename T>
+struct type_tag { using type = T; };
+
+/**
+ * @brief Call `fn(type_tag<T>())` with the C++ type T of a runtime DType.
+ *
+ * @code
+ * size_t bytes = visit_dtype(dt, [](auto tag) {
+ *     return sizeof(typename decltype(tag)::type);
+ * });
+ * @endcode
+ *
+ * @throws std::runtime_error If dtype is not a valid DType value
+ */
+template<typename Fn>
+decltype(auto) visit_dtype(DType dtype, Fn&& fn) {
+    switch (dtype) {
+        case DType::FLOAT32: return fn(type_tag<float>());
+        case DType::FLOAT64: return fn(type_tag<double>());
+        case DType::INT32:   return fn(type_tag<int32_t>());
+        case DType::INT64:   return fn(type_tag<int64_t>());
+        case DType::UINT8:   return fn(type_tag<uint8_t>());
+        case DType::UINT16:  return fn(type_tag<uint16_t>());
+        case DType::UINT32:  return fn(type_tag<uint32_t>());
+        case DType::UINT64:  return fn(type_tag<uint64_t>());
+        case DType::BOOL:    return fn(type_tag<bool>());
+        case DType::FLOAT16: return fn(type_tag<float16>());
+        case DType::BFLOAT16: return fn(type_tag<bfloat16>());
+        case DType::INT8:    return fn(type_tag<int8_t>());
+    }
+    throw std::runtime_error("Unsupported dtype");
+}
+
+/**
+ * @brief Size in bytes of one element of a runtime DType.
+ * @throws std::runtime_error If dtype is not a valid DType value
+ */
+inline size_t dtype_size(DType dtype) {
+    return visit_dtype(dtype, [](auto tag) { return sizeof(typename decltype(tag)::type); });
+}
+
+/**
+ * @brief Number of dimensions stored inline by Shape, Strides and Indices.
+ *
+ * Arrays with at most this many dimensions carry their metadata without any
+ * heap allocation; higher-rank arrays fall back to a heap buffer.
+ */
+constexpr size_t MAX_INLINE_DIMS = 8;
 
 /**
  * @brief Represents the shape of an ndarray (number of elements in each dimension).
  *
  * Example: A 3x4 array has shape {3, 4}.
  */
-using Shape = std::vector<size_t>;
+using Shape = SmallVector<size_t, MAX_INLINE_DIMS>;
 
 /**
  * @brief Represents the strides of an ndarray (step in memory for each dimension).
  *
  * Strides are used for indexing and broadcasting calculations.
  */
-using Strides = std::vector<size_t>;
+using Strides = SmallVector<size_t, MAX_INLINE_DIMS>;
+
+/**
+ * @brief Represents a multi-dimensional index into an ndarray.
+ */
+using Indices = SmallVector<size_t, MAX_INLINE_DIMS>;
 
 } // namespace numbits
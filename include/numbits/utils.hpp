@@ -10,6 +10,7 @@
  *   - `broadcast_shapes`: Determine the resulting shape when broadcasting two arrays
  *   - `can_broadcast`: Check if two shapes are broadcast-compatible
  *   - `shape_to_string`: Format shape as a human-readable string
+ *   - `normalize_axis`: Resolve a possibly negative axis
  *
  * @namespace numbits
  */
@@ -76,7 +77,7 @@ inline Strides compute_strides(const Shape& shape) {
  * Example:
  * @code
  * Strides st = {20, 5, 1};
- * std::vector<size_t> idx = {2, 1, 3};
+ * Indices idx = {2, 1, 3};
  * size_t flat = flatten_index(idx, st); // returns 2*20 + 1*5 + 3*1 = 48
  * @endcode
  *
@@ -84,7 +85,7 @@ inline Strides compute_strides(const Shape& shape) {
  * @param strides Strides of the array
  * @return Flattened 1D index
  */
-inline size_t flatten_index(const std::vector<size_t>& indices, const Strides& strides) {
+inline size_t flatten_index(const Indices& indices, const Strides& strides) {
     size_t flat_idx = 0;
     for (size_t i = 0; i < indices.size(); ++i) {
         flat_idx += indices[i] * strides[i];
@@ -99,7 +100,7 @@ inline size_t flatten_index(const std::vector<size_t>& indices, const Strides& s
  * @code
  * Shape s = {3, 4, 5};
  * Strides st = compute_strides(s);
- * std::vector<size_t> idx = unravel_index(48, s, st); // returns {2, 1, 3}
+ * Indices idx = unravel_index(48, s, st); // returns {2, 1, 3}
  * @endcode
  *
  * @param flat_idx Flat 1D index
@@ -107,8 +108,8 @@ inline size_t flatten_index(const std::vector<size_t>& indices, const Strides& s
  * @param strides Strides of the array
  * @return Multi-dimensional indices corresponding to the flat index
  */
-inline std::vector<size_t> unravel_index(size_t flat_idx, const Shape& shape, const Strides& strides) {
-    std::vector<size_t> indices(shape.size());
+inline Indices unravel_index(size_t flat_idx, const Shape& shape, const Strides& strides) {
+    Indices indices(shape.size());
     for (size_t i = 0; i < shape.size(); ++i) {
         indices[i] = flat_idx / strides[i];
         flat_idx %= strides[i];
@@ -193,4 +194,26 @@ inline std::string shape_to_string(const Shape& shape) {
     return oss.str();
 }
 
+/**
+ * @brief Resolve an axis that may count from the end (NumPy style).
+ *
+ * Example:
+ * @code
+ * size_t ax = normalize_axis(-1, 3); // returns 2
+ * @endcode
+ *
+ * @param axis Axis in [-ndim, ndim)
+ * @param ndim Number of dimensions
+ * @return Axis in [0, ndim)
+ * @throws std::runtime_error if axis is out of range
+ */
+inline size_t normalize_axis(int axis, size_t ndim) {
+    const int n = static_cast<int>(ndim);
+    if (axis < -n || axis >= n) {
+        throw std::runtime_error("Axis " + std::to_string(axis) +
+                                 " out of range for array of dimension " + std::to_string(ndim));
+    }
+    return static_cast<size_t>(axis < 0 ? axis + n : axis);
+}
+
 } // namespace numbits
@@ -0,0 +1,179 @@
+/**
+ * @file test_activations.cpp
+ * @brief Unit tests for fused activation and normalization kernels.
+ *
+ * Tests the following:
+ *   - softmax(), log_softmax() and logsumexp() along both axes, including
+ *     large logits, -inf and NaN
+ *   - sigmoid() and gelu() in both forms
+ *   - layer_norm() with and without affine parameters
+ *   - standardize() along strided axes against a two-pass reference
+ *
+ * @date 2025
+ */
+
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+#include "numbits/numbits.hpp"
+
+using namespace numbits;
+
+#define TEST_CASE(name) void name()
+#define RUN_TEST(name)  \
+    std::cout << "Running " #name "... "; \
+    name(); \
+    std::cout << "OK\n";
+
+static bool approx(double a, double b, double tol = 1e-9) {
+    return std::fabs(a - b) <= tol * std::max(1.0, std::fabs(b));
+}
+
+/**
+ * @brief Build an array of pseudo-random values in [lo, hi).
+ */
+static ndarray<double> random_array(const Shape& shape, double lo, double hi, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> dist(lo, hi);
+    ndarray<double> arr(shape);
+    for (auto& x : arr) x = dist(gen);
+    return arr;
+}
+
+/**
+ * @brief Test softmax(), log_softmax() and logsumexp() against direct formulas.
+ */
+TEST_CASE(test_softmax) {
+    ndarray<double> m({2, 3}, {1.0, 2.0, 3.0,
+                               1000.0, 1000.0, 1000.0});
+    auto p = softmax(m);
+    double z = std::exp(1.0) + std::exp(2.0) + std::exp(3.0);
+    assert(approx(p(0, 0), std::exp(1.0) / z) && approx(p(0, 2), std::exp(3.0) / z));
+    assert(approx(p(1, 1), 1.0 / 3.0));  // no overflow for large logits
+
+    auto lp = log_softmax(m);
+    assert(approx(lp(0, 1), 2.0 - std::log(z)) && approx(lp(1, 0), -std::log(3.0)));
+    auto lse = logsumexp(m, 1);
+    assert((lse.shape() == Shape{2}) && approx(lse[0], std::log(z)) && approx(lse[1], 1000.0 + std::log(3.0)));
+    assert(approx(logsumexp(ndarray<double>({3}, {1.0, 2.0, 3.0})), std::log(z)));
+
+    auto pc = softmax(m, 0);
+    assert(approx(pc(0, 0) + pc(1, 0), 1.0) && pc(1, 0) > 0.999);
+
+    // Long rows use the partial-accumulator path; columns use lane groups
+    auto big = random_array({300, 37}, -20, 20, 1);
+    for (int axis : {0, 1}) {
+        auto s = softmax(big, axis);
+        auto ls = log_softmax(big, axis);
+        auto l = logsumexp(big, axis);
+        const size_t lanes = axis == 0 ? 37 : 300, len = axis == 0 ? 300 : 37;
+        for (size_t lane = 0; lane < lanes; ++lane) {
+            double total = 0.0, mx = -1e300;
+            for (size_t j = 0; j < len; ++j) mx = std::max(mx, axis == 0 ? big(j, lane) : big(lane, j));
+            for (size_t j = 0; j < len; ++j) total += std::exp((axis == 0 ? big(j, lane) : big(lane, j)) - mx);
+            const double ref = mx + std::log(total);
+            assert(approx(l[lane], ref));
+            double sum = 0.0;
+            for (size_t j = 0; j < len; ++j) {
+                double x = axis == 0 ? big(j, lane) : big(lane, j);
+                double sv = axis == 0 ? s(j, lane) : s(lane, j);
+                double lv = axis == 0 ? ls(j, lane) : ls(lane, j);
+                assert(approx(sv, std::exp(x - ref), 1e-12));
+                assert(approx(lv, x - ref));
+                sum += sv;
+            }
+            assert(approx(sum, 1.0));
+        }
+    }
+
+    const float inf = std::numeric_limits<float>::infinity();
+    ndarray<float> neg({2, 2}, {-inf, 0.0f, -inf, -inf});
+    auto pn = softmax(neg);
+    assert(pn(0, 0) == 0.0f && pn(0, 1) == 1.0f);
+    assert(std::isinf(logsumexp(neg, 1)[1]) && logsumexp(neg, 1)[1] < 0);
+    ndarray<float> with_nan({3}, {1.0f, std::numeric_limits<float>::quiet_NaN(), 2.0f});
+    assert(std::isnan(softmax(with_nan)[0]) && std::isnan(logsumexp(with_nan)));
+
+    bool threw = false;
+    try { softmax(m, 2); } catch (const std::runtime_error&) { threw = true; }
+    assert(threw);
+}
+
+/**
+ * @brief Test sigmoid() and gelu() for extreme and ordinary inputs.
+ */
+TEST_CASE(test_activations) {
+    ndarray<double> x({5}, {-800.0, -2.0, 0.0, 1.5, 800.0});
+    auto s = sigmoid(x);
+    assert(s[0] == 0.0 && s[2] == 0.5 && s[4] == 1.0);
+    assert(approx(s[1], 1.0 / (1.0 + std::exp(2.0))) && approx(s[3], 1.0 / (1.0 + std::exp(-1.5))));
+
+    auto g = gelu(x);
+    assert(g[0] == 0.0 && g[2] == 0.0 && g[4] == 800.0);
+    assert(approx(g[3], 0.5 * 1.5 * (1.0 + std::erf(1.5 / std::sqrt(2.0)))));
+    auto ga = gelu(x, true);
+    assert(std::fabs(ga[3] - g[3]) < 1e-3 && std::fabs(ga[1] - g[1]) < 1e-3);
+
+    ndarray<float> many(Shape{100000});
+    for (size_t i = 0; i < many.size(); ++i) many[i] = static_cast<float>(i % 200) * 0.1f - 10.0f;
+    auto sm = sigmoid(many);
+    for (size_t i = 0; i < many.size(); ++i)
+        assert(std::fabs(sm[i] - 1.0f / (1.0f + std::exp(-many[i]))) < 1e-6f);
+}
+
+/**
+ * @brief Test layer_norm() and standardize() against a two-pass mean/variance.
+ */
+TEST_CASE(test_normalization) {
+    ndarray<double> x({2, 4}, {1.0, 2.0, 3.0, 4.0,
+                               10.0, 10.0, 10.0, 30.0});
+    auto n = layer_norm(x, 0.0);
+    const double sd = std::sqrt(1.25);
+    assert(approx(n(0, 0), -1.5 / sd) && approx(n(0, 3), 1.5 / sd));
+    assert(approx(n(1, 3), std::sqrt(3.0)));
+
+    ndarray<double> gamma({4}, {1.0, 2.0, 1.0, 1.0});
+    ndarray<double> beta({4}, {0.0, 0.0, 0.0, 5.0});
+    auto a = layer_norm(x, gamma, beta, 0.0);
+    assert(approx(a(0, 1), -1.0 / sd) && approx(a(0, 3), 5.0 + 1.5 / sd));
+
+    // Welford stays accurate with a large common offset
+    auto big = random_array({50, 1000}, -1, 1, 2);
+    for (auto& v : big) v += 1e6;
+    for (int axis : {0, 1}) {
+        auto z = standardize(big, axis);
+        const size_t lanes = axis == 0 ? 1000 : 50, len = axis == 0 ? 50 : 1000;
+        for (size_t lane = 0; lane < lanes; lane += 7) {
+            auto at = [&](const ndarray<double>& arr, size_t j) { return axis == 0 ? arr(j, lane) : arr(lane, j); };
+            double mean = 0.0, var = 0.0;
+            for (size_t j = 0; j < len; ++j) mean += at(big, j);
+            mean /= static_cast<double>(len);
+            for (size_t j = 0; j < len; ++j) var += (at(big, j) - mean) * (at(big, j) - mean);
+            var /= static_cast<double>(len);
+            for (size_t j = 0; j < len; ++j)
+                assert(std::fabs(at(z, j) - (at(big, j) - mean) / std::sqrt(var)) < 1e-6);
+        }
+    }
+
+    ndarray<float> constant({3}, {2.0f, 2.0f, 2.0f});
+    assert(std::isnan(standardize(constant)[0]));
+    assert(layer_norm(constant)[0] == 0.0f);
+
+    bool threw = false;
+    try { layer_norm(x, ndarray<double>({3}, {1.0, 1.0, 1.0}), beta); } catch (const std::runtime_error&) { threw = true; }
+    assert(threw);
+}
+
+int main() {
+    std::cout << "=== NumBits Activation Tests ===\n\n";
+
+    RUN_TEST(test_softmax);
+    RUN_TEST(test_activations);
+    RUN_TEST(test_normalization);
+
+    std::cout << "\nAll tests passed!\n";
+    return 0;
+}
@@ -9,10 +9,15 @@
  *   - Reshape and flatten operations
  *   - Element access methods
  *   - Array creation functions (arange, linspace, eye)
+ *   - Inline small-vector storage behind Shape/Strides/Indices
+ *   - Variadic operator() and unchecked accessors (debug bounds enabled)
  *
  * @date 2025
  */
 
+// Exercise the debug checks of unchecked accessors in this test binary
+#define NUMBITS_DEBUG_BOUNDS
+
 #include <iostream>
 #include <cassert>
 #include <cmath>
@@ -177,6 +182,82 @@ TEST_CASE(test_ndarray_iterators) {
     assert(sum == 10);
 }
 
+/**
+ * @brief Test SmallVector storage used by Shape, Strides and Indices.
+ */
+TEST_CASE(test_small_vector_shape) {
+    Shape s = {2, 3, 4};
+    assert(s.is_inline() && s.size() == 3 && s.back() == 4);
+
+    s.insert(s.begin() + 1, 7);
+    assert((s == Shape{2, 7, 3, 4}));
+    s.erase(s.begin());
+    assert((s == Shape{7, 3, 4}));
+
+    // Spill to the heap past the inline capacity and back through copies/moves
+    Shape big;
+    for (size_t i = 0; i < MAX_INLINE_DIMS + 4; ++i) big.push_back(i + 1);
+    assert(!big.is_inline() && big.size() == MAX_INLINE_DIMS + 4);
+    assert(big[MAX_INLINE_DIMS + 3] == MAX_INLINE_DIMS + 4);
+    Shape copy = big;
+    Shape moved = std::move(big);
+    assert(copy == moved && big.empty() && big.is_inline());
+    big.insert(big.end(), moved.begin(), moved.end());
+    assert(big == moved);
+
+    // std::vector interoperability
+    std::vector<size_t> v = s;
+    assert((v == std::vector<size_t>{7, 3, 4}));
+    assert(Shape(v) == s);
+
+    // Arrays above the inline rank still work
+    Shape high(10, 1);
+    high[9] = 3;
+    ndarray<int> arr(high);
+    Indices last(10, 0);
+    last[9] = 2;
+    arr.at(last) = 5;
+    assert(arr.size() == 3 && arr[2] == 5);
+}
+
+/**
+ * @brief Test variadic operator() and the unchecked accessor proxy.
+ */
+TEST_CASE(test_variadic_and_unchecked_access) {
+    ndarray<float> arr({2, 3}, {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f});
+    assert(arr(1, 2) == 6.0f);
+    arr(0, 1) = 9.0f;
+    assert((arr.at({0, 1}) == 9.0f));
+
+    bool threw = false;
+    try { arr(2, 0); } catch (const std::out_of_range&) { threw = true; }
+    assert(threw);
+    threw = false;
+    try { arr(1); } catch (const std::runtime_error&) { threw = true; }
+    assert(threw);
+
+    auto acc = arr.unchecked<2>();
+    assert(acc.shape(0) == 2 && acc.shape(1) == 3);
+    float sum = 0.0f;
+    for (size_t i = 0; i < acc.shape(0); ++i)
+        for (size_t j = 0; j < acc.shape(1); ++j) sum += acc(i, j);
+    assert(sum == 28.0f);
+    acc(1, 0) = 0.0f;
+    assert(arr[3] == 0.0f);
+
+    const ndarray<float>& carr = arr;
+    auto cacc = carr.unchecked<2>();
+    assert(cacc(0, 2) == 3.0f);
+
+    // Rank is validated once; per-index checks only under NUMBITS_DEBUG_BOUNDS
+    threw = false;
+    try { arr.unchecked<3>(); } catch (const std::runtime_error&) { threw = true; }
+    assert(threw);
+    threw = false;
+    try { acc(0, 3); } catch (const std::out_of_range&) { threw = true; }
+    assert(threw);
+}
+
 int main() {
     RUN_TEST(test_ndarray_creation);
     RUN_TEST(test_ndarray_with_data);
@@ -192,6 +273,8 @@ int main() {
     RUN_TEST(test_ndarray_flatten);
     RUN_TEST(test_ndarray_ndim);
     RUN_TEST(test_ndarray_iterators);
+    RUN_TEST(test_small_vector_shape);
+    RUN_TEST(test_variadic_and_unchecked_access);
 
     std::cout << "All tests passed!\n";
     return 0;
@@ -0,0 +1,143 @@
+/**
+ * @file test_array_handle.cpp
+ * @brief Unit tests for the type-erased array handle.
+ *
+ * Tests the following:
+ *   - Construction, typed access, shared storage and deep copies
+ *   - load_any()/dump() for files of every dtype
+ *   - promote_types() and element-wise operations across dtypes
+ *   - Reductions and runtime astype()
+ *
+ * @date 2025
+ */
+
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "numbits/numbits.hpp"
+
+using namespace numbits;
+
+#define TEST_CASE(name) void name()
+#define RUN_TEST(name)  \
+    std::cout << "Running " #name "... "; \
+    name(); \
+    std::cout << "OK\n";
+
+/**
+ * @brief Test construction, typed access and storage sharing.
+ */
+TEST_CASE(test_handle) {
+    // Typed arrays must be wrapped explicitly, so typed calls never resolve to the array overloads
+    static_assert(!std::is_convertible_v<ndarray<float>, array>, "array(ndarray<T>) must be explicit");
+    static_assert(std::is_constructible_v<array, ndarray<float>>, "array must wrap typed arrays");
+
+    array a(ndarray<int32_t>({2, 2}, {1, 2, 3, 4}));
+    assert(a.dtype() == DType::INT32 && (a.shape() == Shape{2, 2}) && a.size() == 4 && a.nbytes() == 16);
+    assert(a.as<int32_t>()(1, 0) == 3);
+
+    array shared = a;
+    shared.as<int32_t>()[0] = 10;
+    assert(a.as<int32_t>()[0] == 10 && shared.data() == a.data());
+    array deep = a.copy();
+    deep.as<int32_t>()[0] = 0;
+    assert(a.as<int32_t>()[0] == 10 && deep.data() != a.data());
+
+    bool threw = false;
+    try { a.as<float>(); } catch (const std::runtime_error&) { threw = true; }
+    assert(threw);
+
+    array z(Shape{3}, DType::UINT16);
+    assert(z.dtype() == DType::UINT16 && z.as<uint16_t>()[2] == 0);
+    array none;
+    assert(none.empty() && none.size() == 0 && none.data() == nullptr);
+
+    const size_t n = a.visit([](const auto& typed) { return typed.size(); });
+    assert(n == 4);
+    assert(a.astype(DType::INT32).data() == a.data());  // same dtype shares storage
+    auto f = a.astype(DType::FLOAT64);
+    assert(f.dtype() == DType::FLOAT64 && f.as<double>()[3] == 4.0);
+}
+
+/**
+ * @brief Test load_any() for every dtype written by dump().
+ */
+TEST_CASE(test_load_any) {
+    const std::vector<DType> dtypes = {DType::FLOAT32, DType::FLOAT64, DType::INT32, DType::INT64,
+                                       DType::UINT8, DType::UINT16, DType::UINT32, DType::UINT64,
+                                       DType::BOOL, DType::FLOAT16, DType::BFLOAT16, DType::INT8};
+    array source(ndarray<double>({2, 3}, {0.0, 1.0, 2.0, 3.0, 4.0, 5.0}));
+    for (DType dtype : dtypes) {
+        array typed = source.astype(dtype);
+        dump(typed, "test_array_any.cb");
+        array loaded = load_any("test_array_any.cb");
+        assert(loaded.dtype() == dtype && (loaded.shape() == Shape{2, 3}));
+        auto back = loaded.astype(DType::FLOAT64).as<double>();
+        for (size_t i = 0; i < back.size(); ++i)
+            assert(back[i] == (dtype == DType::BOOL ? (i != 0 ? 1.0 : 0.0) : static_cast<double>(i)));
+    }
+    std::remove("test_array_any.cb");
+
+    // Compressed files written through the typed API load the same way
+    ndarray<uint16_t> counts({4}, {7, 7, 7, 9});
+    dump(counts, "test_array_any_c.cb", CompressionOptions());
+    array c = load_any("test_array_any_c.cb");
+    std::remove("test_array_any_c.cb");
+    assert(c.dtype() == DType::UINT16 && c.as<uint16_t>()[3] == 9);
+
+    bool threw = false;
+    try { load_any("does_not_exist.cb"); } catch (const std::runtime_error&) { threw = true; }
+    assert(threw);
+}
+
+/**
+ * @brief Test type promotion, element-wise operations and reductions.
+ */
+TEST_CASE(test_dispatch) {
+    assert(promote_types(DType::UINT8, DType::INT32) == DType::INT32);
+    assert(promote_types(DType::UINT8, DType::INT8) == DType::INT32);
+    assert(promote_types(DType::UINT32, DType::INT32) == DType::INT64);
+    assert(promote_types(DType::UINT64, DType::INT64) == DType::FLOAT64);
+    assert(promote_types(DType::UINT16, DType::UINT64) == DType::UINT64);
+    assert(promote_types(DType::INT64, DType::FLOAT32) == DType::FLOAT32);
+    assert(promote_types(DType::FLOAT16, DType::INT8) == DType::FLOAT32);
+    assert(promote_types(DType::FLOAT16, DType::BFLOAT16) == DType::FLOAT32);
+    assert(promote_types(DType::FLOAT16, DType::FLOAT64) == DType::FLOAT64);
+    assert(promote_types(DType::BOOL, DType::UINT8) == DType::UINT8);
+
+    array img(ndarray<uint8_t>({2, 2}, {10, 20, 30, 250}));
+    array offset(ndarray<int32_t>({2}, {1, -300}));
+    array s = add(img, offset);  // broadcasts along rows
+    assert(s.dtype() == DType::INT32 && s.as<int32_t>()(1, 0) == 31 && s.as<int32_t>()(1, 1) == -50);
+
+    array half(ndarray<double>({1}, {0.5}));
+    array p = multiply(img, half);
+    assert(p.dtype() == DType::FLOAT64 && p.as<double>()[3] == 125.0);
+    assert(subtract(img, img).dtype() == DType::UINT8);
+    assert(divide(half, array(ndarray<float>({1}, {2.0f}))).as<double>()[0] == 0.25);
+
+    assert(sum(img) == 310.0 && mean(img) == 77.5 && min(img) == 10.0 && max(img) == 250.0);
+    array flags(ndarray<bool>({3}, {true, false, true}));
+    assert(sum(flags) == 2.0);
+    array h(ndarray<float16>({2}, {float16(1.5f), float16(-2.0f)}));
+    assert(sum(h) == -0.5 && min(h) == -2.0);
+
+    bool threw = false;
+    try { add(img, array(ndarray<int32_t>({3}, {1, 2, 3}))); } catch (const std::runtime_error&) { threw = true; }
+    assert(threw);
+}
+
+int main() {
+    std::cout << "=== NumBits Array Handle Tests ===\n\n";
+
+    RUN_TEST(test_handle);
+    RUN_TEST(test_load_any);
+    RUN_TEST(test_dispatch);
+
+    std::cout << "\nAll tests passed!\n";
+    return 0;
+}
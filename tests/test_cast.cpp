@@ -0,0 +1,154 @@
+/**
+ * @file test_cast.cpp
+ * @brief Unit tests for element type conversion.
+ *
+ * Tests the following:
+ *   - astype() between integer, floating-point and bool types
+ *   - Wrapping and saturating integer narrowing
+ *   - Float-to-integer truncation, rounding, clamping and NaN handling
+ *   - The fused scale/offset conversion
+ *   - Runtime-dtype cast() over every DType pair
+ *
+ * @date 2025
+ */
+
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
+#include "numbits/numbits.hpp"
+
+using namespace numbits;
+
+#define TEST_CASE(name) void name()
+#define RUN_TEST(name)  \
+    std::cout << "Running " #name "... "; \
+    name(); \
+    std::cout << "OK\n";
+
+/**
+ * @brief Test plain astype() conversions.
+ */
+TEST_CASE(test_astype) {
+    ndarray<uint8_t> img({2, 2}, {0, 1, 128, 255});
+    auto f = img.astype<float>();
+    assert((f.shape() == Shape{2, 2}) && f(1, 0) == 128.0f && f(1, 1) == 255.0f);
+
+    ndarray<double> d({4}, {-1.5, 0.0, 2.75, 1e10});
+    auto fl = d.astype<float>();
+    assert(fl[0] == -1.5f && fl[2] == 2.75f);
+    auto b = d.astype<bool>();
+    assert(b[0] && !b[1] && b[2]);
+    auto back = b.astype<int32_t>();
+    assert(back[0] == 1 && back[1] == 0);
+
+    // Integer narrowing wraps by default and clamps when saturating
+    ndarray<int32_t> wide({4}, {-1, 255, 256, 70000});
+    auto wrapped = wide.astype<uint8_t>();
+    assert(wrapped[0] == 255 && wrapped[1] == 255 && wrapped[2] == 0);
+    auto clamped = wide.astype<uint8_t>({true, false});
+    assert(clamped[0] == 0 && clamped[2] == 255 && clamped[3] == 255);
+    ndarray<uint64_t> big({2}, {std::numeric_limits<uint64_t>::max(), 5});
+    auto big_sat = big.astype<int64_t>({true, false});
+    assert(big_sat[0] == std::numeric_limits<int64_t>::max() && big_sat[1] == 5);
+    ndarray<int64_t> neg({2}, {-5, std::numeric_limits<int64_t>::min()});
+    assert(neg.astype<int32_t>({true, false})[1] == std::numeric_limits<int32_t>::min());
+    assert(neg.astype<uint32_t>({true, false})[0] == 0u);
+}
+
+/**
+ * @brief Test float-to-integer rounding, clamping and NaN handling.
+ */
+TEST_CASE(test_float_to_int) {
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    const double inf = std::numeric_limits<double>::infinity();
+    ndarray<double> v({8}, {2.5, 3.5, -2.5, -0.7, 1e300, -inf, nan, 2.9});
+    auto t = v.astype<int32_t>();
+    assert(t[0] == 2 && t[2] == -2 && t[3] == 0 && t[7] == 2);
+    assert(t[4] == std::numeric_limits<int32_t>::max() && t[5] == std::numeric_limits<int32_t>::min());
+    assert(t[6] == 0);
+    auto r = v.astype<int32_t>({false, true});
+    assert(r[0] == 2 && r[1] == 4 && r[2] == -2 && r[3] == -1 && r[7] == 3);
+
+    ndarray<float> f({3}, {3e9f, -1.0f, 4e19f});
+    auto u32 = f.astype<uint32_t>();
+    assert(u32[0] == 3000000000u && u32[1] == 0u);
+    auto u64 = f.astype<uint64_t>();
+    assert(u64[2] > 18000000000000000000ull);  // clamped below 2^64, no overflow
+    auto i32 = f.astype<int32_t>();
+    assert(i32[0] == 2147483520);  // largest float below 2^31
+
+    ndarray<double> huge({2}, {1e300, -inf});
+    auto hs = huge.astype<float>({true, false});
+    assert(hs[0] == std::numeric_limits<float>::max() && std::isinf(hs[1]));
+    assert(std::isinf(huge.astype<float>()[0]));
+}
+
+/**
+ * @brief Test the fused scale/offset conversion used for image normalization.
+ */
+TEST_CASE(test_scaled_astype) {
+    const size_t n = 300000;  // large enough for the parallel path
+    ndarray<uint8_t> img(Shape{n});
+    for (size_t i = 0; i < n; ++i) img[i] = static_cast<uint8_t>(i % 256);
+    auto norm = img.astype<float>(1.0 / 127.5, -1.0);
+    for (size_t i = 0; i < 256; ++i)
+        assert(std::fabs(norm[i] - (static_cast<float>(i) / 127.5f - 1.0f)) < 1e-6f);
+    auto restored = norm.astype<uint8_t>(127.5, 127.5, {true, true});
+    for (size_t i = 0; i < n; ++i) assert(restored[i] == img[i]);
+
+    ndarray<float> over({3}, {-0.5f, 0.5f, 1.5f});
+    auto q = over.astype<uint8_t>(255.0, 0.0, {true, true});
+    assert(q[0] == 0 && q[1] == 128 && q[2] == 255);
+    auto q16 = over.astype<int16_t>(1000.0, 0.5);
+    assert(q16[0] == -499 && q16[2] == 1500);
+}
+
+/**
+ * @brief Test runtime cast() for every DType pair against astype().
+ */
+TEST_CASE(test_runtime_cast) {
+    const std::vector<DType> dtypes = {DType::FLOAT32, DType::FLOAT64, DType::INT32, DType::INT64,
+                                       DType::UINT8, DType::UINT16, DType::UINT32, DType::UINT64,
+                                       DType::BOOL, DType::FLOAT16, DType::BFLOAT16};
+    ndarray<double> values({5}, {0.0, 1.0, 7.0, 42.0, 200.0});
+    for (DType from : dtypes) {
+        std::vector<unsigned char> src(values.size() * dtype_size(from));
+        cast(values.data(), DType::FLOAT64, src.data(), from, values.size());
+        for (DType to : dtypes) {
+            std::vector<unsigned char> dst(values.size() * dtype_size(to));
+            cast(src.data(), from, dst.data(), to, values.size());
+            std::vector<double> round_trip(values.size());
+            cast(dst.data(), to, round_trip.data(), DType::FLOAT64, values.size());
+            for (size_t i = 0; i < values.size(); ++i) {
+                const double expected = (from == DType::BOOL || to == DType::BOOL)
+                                            ? (values[i] != 0.0 ? 1.0 : 0.0) : values[i];
+                assert(round_trip[i] == expected);
+            }
+        }
+    }
+    assert(dtype_size(DType::UINT16) == 2 && dtype_size(DType::FLOAT64) == 8);
+
+    ndarray<int32_t> ints({3}, {-3, 300, 5});
+    std::vector<uint8_t> bytes(3);
+    cast(ints.data(), dtype_from_type<int32_t>(), bytes.data(), DType::UINT8, 3, {true, false});
+    assert(bytes[0] == 0 && bytes[1] == 255 && bytes[2] == 5);
+
+    bool threw = false;
+    try { dtype_size(static_cast<DType>(99)); } catch (const std::runtime_error&) { threw = true; }
+    assert(threw);
+}
+
+int main() {
+    std::cout << "=== NumBits Cast Tests ===\n\n";
+
+    RUN_TEST(test_astype);
+    RUN_TEST(test_float_to_int);
+    RUN_TEST(test_scaled_astype);
+    RUN_TEST(test_runtime_cast);
+
+    std::cout << "\nAll tests passed!\n";
+    return 0;
+}
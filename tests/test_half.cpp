@@ -0,0 +1,182 @@
+/**
+ * @file test_half.cpp
+ * @brief Unit tests for the float16 and bfloat16 storage types.
+ *
+ * Tests the following:
+ *   - Scalar conversions: rounding to even, subnormals, overflow, inf and NaN
+ *   - Bulk conversions against the scalar ones
+ *   - astype() to and from 16-bit floats, with and without saturation
+ *   - dump()/load() round trips, plain and compressed
+ *   - float32 accumulation in sum(), mean(), matmul() and dot()
+ *
+ * @date 2025
+ */
+
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <vector>
+#include "numbits/numbits.hpp"
+
+using namespace numbits;
+
+#define TEST_CASE(name) void name()
+#define RUN_TEST(name)  \
+    std::cout << "Running " #name "... "; \
+    name(); \
+    std::cout << "OK\n";
+
+/**
+ * @brief Test scalar float16 and bfloat16 conversions at the edges of their ranges.
+ */
+TEST_CASE(test_scalar_conversion) {
+    const float inf = std::numeric_limits<float>::infinity();
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+
+    assert(float16(1.0f).bits == 0x3C00 && float16(-2.0f).bits == 0xC000);
+    assert(float16(0.0f).bits == 0 && float16(-0.0f).bits == 0x8000);
+    assert(float16(65504.0f).bits == 0x7BFF);
+    assert(float16(65519.0f).bits == 0x7BFF);  // rounds down to the largest finite value
+    assert(float16(65520.0f).bits == 0x7C00);  // rounds up to infinity
+    assert(float16(1e10f).bits == 0x7C00 && float16(-inf).bits == 0xFC00);
+    assert(std::isnan(static_cast<float>(float16(nan))));
+
+    // Ties to even: 1 + 2^-11 lies halfway between 1 and 1 + 2^-10
+    assert(float16(1.0f + std::ldexp(1.0f, -11)).bits == 0x3C00);
+    assert(float16(1.0f + 3 * std::ldexp(1.0f, -11)).bits == 0x3C02);
+
+    // Subnormals down to 2^-24, and below half of it to zero
+    assert(float16(std::ldexp(1.0f, -24)).bits == 0x0001);
+    assert(float16(std::ldexp(1.0f, -25)).bits == 0x0000);
+    assert(float16(std::ldexp(3.0f, -25)).bits == 0x0002);
+    assert(static_cast<float>(float16::from_bits(0x0001)) == std::ldexp(1.0f, -24));
+    assert(static_cast<float>(float16::from_bits(0x03FF)) == std::ldexp(1023.0f, -24));
+
+    // Every float16 value survives a round trip through float
+    for (uint32_t b = 0; b < 0x10000; ++b) {
+        const float16 h = float16::from_bits(static_cast<uint16_t>(b));
+        const float f = h;
+        if (std::isnan(f)) assert((b & 0x7C00) == 0x7C00 && (b & 0x03FF) != 0);
+        else assert(float16(f).bits == b);
+    }
+
+    assert(bfloat16(1.0f).bits == 0x3F80 && static_cast<float>(bfloat16::from_bits(0x4049)) == 3.140625f);
+    assert(bfloat16(1.0f + std::ldexp(1.0f, -8)).bits == 0x3F80);      // tie to even
+    assert(bfloat16(1.0f + 3 * std::ldexp(1.0f, -8)).bits == 0x3F82);
+    assert(bfloat16(std::numeric_limits<float>::max()).bits == 0x7F80);
+    assert(std::isnan(static_cast<float>(bfloat16(nan))) && bfloat16(-inf).bits == 0xFF80);
+
+    float16 acc = 1.0f;
+    acc += 2;
+    acc *= 0.5f;
+    assert(acc == 1.5f && static_cast<float>(std::numeric_limits<float16>::max()) == 65504.0f);
+}
+
+/**
+ * @brief Test bulk conversions and astype() against the scalar conversions.
+ */
+TEST_CASE(test_astype_half) {
+    const size_t n = 200003;  // odd length, large enough for the parallel path
+    ndarray<float> f(Shape{n});
+    for (size_t i = 0; i < n; ++i) f[i] = std::ldexp(static_cast<float>(i) - 100000.0f, static_cast<int>(i % 40) - 30);
+
+    auto h = f.astype<float16>();
+    auto b = f.astype<bfloat16>();
+    auto hf = h.astype<float>();
+    auto bf = b.astype<float>();
+    for (size_t i = 0; i < n; ++i) {
+        assert(h[i].bits == float16(f[i]).bits && hf[i] == static_cast<float>(h[i]));
+        assert(b[i].bits == bfloat16(f[i]).bits && bf[i] == static_cast<float>(b[i]));
+    }
+
+    ndarray<double> d({4}, {1e6, -1e6, 0.1, 1e40});
+    auto sat = d.astype<float16>({true, false});
+    assert(sat[0] == 65504.0f && sat[1] == -65504.0f && std::fabs(sat[2] - 0.1f) < 1e-4f);
+    assert(std::isinf(static_cast<float>(d.astype<float16>()[0])));
+    auto bsat = d.astype<bfloat16>({true, false});
+    assert(!std::isinf(static_cast<float>(bsat[3])) && std::isinf(static_cast<float>(d.astype<bfloat16>()[3])));
+
+    ndarray<float16> q({4}, {float16(-1.5f), float16(2.5f), float16(300.0f), float16(1e5f)});
+    auto u8 = q.astype<uint8_t>({true, true});
+    assert(u8[0] == 0 && u8[1] == 2 && u8[2] == 255 && u8[3] == 255);
+    auto bf16 = q.astype<bfloat16>();
+    assert(bf16[1] == 2.5f && bf16[2] == 300.0f && std::isinf(static_cast<float>(bf16[3])));
+
+    ndarray<uint8_t> img({3}, {0, 128, 255});
+    auto norm = img.astype<float16>(1.0 / 255.0, 0.0);
+    assert(norm[0] == 0.0f && norm[2] == 1.0f && std::fabs(norm[1] - 128.0f / 255.0f) < 1e-3f);
+}
+
+/**
+ * @brief Test dump()/load() round trips and the runtime cast() of 16-bit dtypes.
+ */
+TEST_CASE(test_dump_load_half) {
+    ndarray<float16> h({3, 5});
+    ndarray<bfloat16> b({3, 5});
+    for (size_t i = 0; i < h.size(); ++i) {
+        h[i] = static_cast<float>(i) * 0.25f - 1.0f;
+        b[i] = static_cast<float>(i) * 1000.5f;
+    }
+    dump(h, "test_half_f16.cb");
+    dump(b, "test_half_bf16.cb", CompressionOptions());
+    auto h2 = load<float16>("test_half_f16.cb");
+    auto b2 = load<bfloat16>("test_half_bf16.cb");
+    assert((h2.shape() == Shape{3, 5}) && (b2.shape() == Shape{3, 5}));
+    for (size_t i = 0; i < h.size(); ++i) assert(h2[i].bits == h[i].bits && b2[i].bits == b[i].bits);
+
+    bool threw = false;
+    try { load<float>("test_half_f16.cb"); } catch (const std::runtime_error&) { threw = true; }
+    assert(threw);
+    std::remove("test_half_f16.cb");
+    std::remove("test_half_bf16.cb");
+
+    assert(dtype_from_type<float16>() == DType::FLOAT16 && dtype_size(DType::BFLOAT16) == 2);
+    std::vector<float16> raw(3);
+    const double values[3] = {0.5, -3.0, 1e9};
+    cast(values, DType::FLOAT64, raw.data(), DType::FLOAT16, 3);
+    assert(raw[0] == 0.5f && raw[1] == -3.0f && std::isinf(static_cast<float>(raw[2])));
+}
+
+/**
+ * @brief Test that reductions and products accumulate in float32.
+ */
+TEST_CASE(test_float32_accumulation) {
+    // 4096 ones: a float16 running sum would stall at 2048
+    ndarray<float16> ones(Shape{4096});
+    ones.fill(float16(1.0f));
+    assert(sum(ones) == 4096.0f && mean(ones) == 1.0f);
+    ndarray<bfloat16> bones(Shape{1000});
+    bones.fill(bfloat16(1.0f));
+    assert(sum(bones) == 1000.0f && mean(bones) == 1.0f);
+
+    ndarray<float16> a({2, 3}, {float16(1.0f), float16(2.0f), float16(3.0f),
+                                float16(4.0f), float16(5.0f), float16(6.0f)});
+    ndarray<float16> c({3, 2}, {float16(1.0f), float16(0.0f), float16(0.0f),
+                                float16(1.0f), float16(1.0f), float16(1.0f)});
+    auto m = matmul(a, c);
+    assert((m.shape() == Shape{2, 2}) && m(0, 0) == 4.0f && m(0, 1) == 5.0f && m(1, 0) == 10.0f && m(1, 1) == 11.0f);
+
+    ndarray<float16> x(Shape{3000});
+    x.fill(float16(1.0f));
+    assert(dot(x, x)[0] == 3000.0f);
+    ndarray<bfloat16> y({2}, {bfloat16(3.0f), bfloat16(4.0f)});
+    assert(dot(y, y)[0] == 25.0f);
+
+    bool threw = false;
+    try { matmul(a, a); } catch (const std::runtime_error&) { threw = true; }
+    assert(threw);
+}
+
+int main() {
+    std::cout << "=== NumBits Half-Precision Tests ===\n\n";
+
+    RUN_TEST(test_scalar_conversion);
+    RUN_TEST(test_astype_half);
+    RUN_TEST(test_dump_load_half);
+    RUN_TEST(test_float32_accumulation);
+
+    std::cout << "\nAll tests passed!\n";
+    return 0;
+}
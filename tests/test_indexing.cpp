@@ -0,0 +1,344 @@
+/**
+ * @file test_indexing.cpp
+ * @brief Unit tests for indexing, gather and scatter operations.
+ *
+ * Tests the following:
+ *   - take() along different axes with vector and ndarray<int64_t> indices
+ *   - Advanced indexing with index lists and index arrays
+ *   - put(), scatter_add() and index_add()
+ *   - Parallel gathers and scatters match serial results
+ *
+ * @date 2025
+ */
+
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <numeric>
+#include "numbits/numbits.hpp"
+
+using namespace numbits;
+
+#define TEST_CASE(name) void name()
+#define RUN_TEST(name)  \
+    std::cout << "Running " #name "... "; \
+    name(); \
+    std::cout << "OK\n";
+
+/**
+ * @brief Build a {rows, cols} float array holding 0, 1, 2, ...
+ */
+static ndarray<float> iota2d(size_t rows, size_t cols) {
+    ndarray<float> arr(Shape{rows, cols});
+    std::iota(arr.begin(), arr.end(), 0.0f);
+    return arr;
+}
+
+/**
+ * @brief Test take() along axis 0 and 1 and with an index array.
+ */
+TEST_CASE(test_take) {
+    auto arr = iota2d(3, 4);
+
+    auto rows = take(arr, std::vector<size_t>{2, 0}, 0);
+    assert((rows.shape() == Shape{2, 4}));
+    assert(rows(0, 0) == 8.0f && rows(1, 3) == 3.0f);
+
+    auto cols = take(arr, std::vector<size_t>{3, 1, 3}, 1);
+    assert((cols.shape() == Shape{3, 3}));
+    assert(cols(0, 0) == 3.0f && cols(2, 1) == 9.0f && cols(2, 2) == 11.0f);
+
+    // Embedding lookup: the index shape replaces the gathered axis
+    ndarray<int64_t> idx(Shape{2, 2}, std::vector<int64_t>{0, -1, 1, 2});
+    auto emb = take(arr, idx);
+    assert((emb.shape() == Shape{2, 2, 4}));
+    assert(emb(0, 1, 0) == 8.0f && emb(1, 0, 2) == 6.0f);
+
+    bool threw = false;
+    try { take(arr, std::vector<size_t>{3}, 0); } catch (const std::out_of_range&) { threw = true; }
+    assert(threw);
+    threw = false;
+    try { take(arr, std::vector<size_t>{0}, 2); } catch (const std::runtime_error&) { threw = true; }
+    assert(threw);
+}
+
+/**
+ * @brief Test advanced indexing with both index representations.
+ */
+TEST_CASE(test_advanced_indexing) {
+    auto arr = iota2d(3, 4);
+    auto picked = advanced_indexing(arr, std::vector<std::vector<size_t>>{{0, 2, 1}, {1, 3, 0}});
+    assert((picked.shape() == Shape{3}));
+    assert(picked[0] == 1.0f && picked[1] == 11.0f && picked[2] == 4.0f);
+
+    ndarray<int64_t> r(Shape{2, 1}, std::vector<int64_t>{-1, 0});
+    ndarray<int64_t> c(Shape{2, 1}, std::vector<int64_t>{0, -1});
+    auto grid = advanced_indexing(arr, std::vector<ndarray<int64_t>>{r, c});
+    assert((grid.shape() == Shape{2, 1}));
+    assert(grid[0] == 8.0f && grid[1] == 3.0f);
+
+    bool threw = false;
+    try {
+        advanced_indexing(arr, std::vector<std::vector<size_t>>{{0}, {4}});
+    } catch (const std::out_of_range&) {
+        threw = true;
+    }
+    assert(threw);
+}
+
+/**
+ * @brief Test put, scatter_add and index_add semantics.
+ */
+TEST_CASE(test_put_and_scatter) {
+    ndarray<float> arr(Shape{5});
+    put(arr, ndarray<int64_t>(Shape{3}, std::vector<int64_t>{0, 4, -2}), ndarray<float>{7.0f});
+    assert(arr[0] == 7.0f && arr[4] == 7.0f && arr[3] == 7.0f && arr[1] == 0.0f);
+
+    ndarray<float> acc(Shape{4});
+    ndarray<int64_t> where_idx(Shape{5}, std::vector<int64_t>{1, 1, 3, 1, 0});
+    scatter_add(acc, where_idx, ndarray<float>{1.0f, 2.0f, 3.0f, 4.0f, 5.0f});
+    assert(acc[0] == 5.0f && acc[1] == 7.0f && acc[2] == 0.0f && acc[3] == 3.0f);
+
+    auto table = ndarray<float>::zeros(Shape{3, 2});
+    auto src = iota2d(4, 2);
+    index_add(table, 0, ndarray<int64_t>(Shape{4}, std::vector<int64_t>{2, 0, 2, 1}), src);
+    assert(table(0, 0) == 2.0f && table(1, 1) == 7.0f);
+    assert(table(2, 0) == 0.0f + 4.0f && table(2, 1) == 1.0f + 5.0f);
+
+    // Along axis 1
+    auto wide = ndarray<float>::zeros(Shape{2, 3});
+    index_add(wide, 1, ndarray<int64_t>(Shape{2}, std::vector<int64_t>{0, 0}), iota2d(2, 2));
+    assert(wide(0, 0) == 1.0f && wide(1, 0) == 5.0f && wide(1, 2) == 0.0f);
+
+    bool threw = false;
+    try { index_add(wide, 1, ndarray<int64_t>(Shape{1}, std::vector<int64_t>{0}), iota2d(2, 2)); }
+    catch (const std::runtime_error&) { threw = true; }
+    assert(threw);
+}
+
+/**
+ * @brief Test large gathers/scatters that take the parallel paths.
+ */
+TEST_CASE(test_large_gather_scatter) {
+    const size_t rows = 2000, dim = 64, n = 5000;
+    auto table = iota2d(rows, dim);
+    ndarray<int64_t> idx(Shape{n});
+    for (size_t i = 0; i < n; ++i) idx[i] = static_cast<int64_t>((i * 7919) % rows);
+
+    auto out = take(table, idx);
+    assert((out.shape() == Shape{n, dim}));
+    for (size_t i = 0; i < n; i += 97)
+        for (size_t j = 0; j < dim; ++j)
+            assert(out(i, j) == table(static_cast<size_t>(idx[i]), j));
+
+    // index_add of the gathered rows back into a zero table equals count * row
+    auto back = ndarray<float>::zeros(Shape{rows, dim});
+    index_add(back, 0, idx, ndarray<float>::ones(Shape{n, dim}));
+    std::vector<float> counts(rows, 0.0f);
+    for (size_t i = 0; i < n; ++i) counts[static_cast<size_t>(idx[i])] += 1.0f;
+    for (size_t r = 0; r < rows; r += 13) assert(back(r, dim - 1) == counts[r]);
+
+    ndarray<float> flat(Shape{rows});
+    scatter_add(flat, idx, ndarray<float>::ones(Shape{n}));
+    for (size_t r = 0; r < rows; ++r) assert(flat[r] == counts[r]);
+
+    // Rounding-sensitive values with heavy repeats: bit-identical to a serial loop
+    const size_t m = 200000;
+    ndarray<int64_t> hot(Shape{m});
+    ndarray<float> vals(Shape{m});
+    for (size_t i = 0; i < m; ++i) {
+        hot[i] = static_cast<int64_t>((i * i) % 37 + (i % 3) * 600);
+        vals[i] = 1.0f / static_cast<float>(i % 101 + 1) + (i % 5 == 0 ? 1e4f : 0.0f);
+    }
+    ndarray<float> acc(Shape{rows});
+    scatter_add(acc, hot, vals);
+    std::vector<float> ref(rows, 0.0f);
+    for (size_t i = 0; i < m; ++i) ref[static_cast<size_t>(hot[i])] += vals[i];
+    for (size_t r = 0; r < rows; ++r) assert(acc[r] == ref[r]);
+}
+
+/**
+ * @brief Test N-dimensional slicing: ranges, negative steps, indices, newaxis, ellipsis.
+ */
+TEST_CASE(test_nd_slice) {
+    auto arr = iota2d(4, 6).reshape({2, 2, 6});
+    const index_t N = Slice::NONE;
+
+    // arr[1, :, 1:5:2]
+    auto v = slice(arr, {1, Slice(), Slice(1, 5, 2)});
+    assert((v.shape() == Shape{2, 2}));
+    assert(v(0, 0) == 13.0f && v(0, 1) == 15.0f && v(1, 1) == 21.0f);
+    assert(!v.is_contiguous());
+
+    // arr[..., ::-1] and arr[:, ::-1, -1]
+    auto rev = slice(arr, {ellipsis, Slice(N, N, -1)});
+    assert((rev.shape() == Shape{2, 2, 6}));
+    assert(rev(0, 0, 0) == 5.0f && rev(1, 1, 5) == 18.0f);
+    auto last = slice(arr, {Slice(), Slice(N, N, -1), -1});
+    assert((last.shape() == Shape{2, 2}));
+    assert(last(0, 0) == 11.0f && last(1, 1) == 17.0f);
+
+    // Clamping, negative bounds and empty results
+    assert(slice(arr, {Slice(-1, 100)}).shape()[0] == 1);
+    assert(slice(arr, {Slice(), Slice(), Slice(4, 2)}).size() == 0);
+    assert(slice(arr, {Slice(), Slice(), Slice(-2, N, -2)}).shape()[2] == 3);
+
+    // newaxis inserts a unit dimension with zero stride
+    auto nv = slice(arr, {newaxis, 0, newaxis});
+    assert((nv.shape() == Shape{1, 1, 2, 6}));
+    assert(nv.is_contiguous());
+    auto dense = nv.as_ndarray();
+    assert(dense.data() == arr.data() && dense[7] == 7.0f);
+
+    // copy() materializes; contiguous runs and strided rows agree with element access
+    auto c = rev.copy();
+    for (size_t i = 0; i < 2; ++i)
+        for (size_t j = 0; j < 2; ++j)
+            for (size_t k = 0; k < 6; ++k) assert(c(i, j, k) == arr(i, j, 5 - k));
+    auto inner = slice(arr, {Slice(), Slice(0, 1)}).copy();
+    assert((inner.shape() == Shape{2, 1, 6}) && inner(1, 0, 3) == 15.0f);
+
+    // Views write through; views of views compose
+    auto sub = slice(arr, {Slice(), 0, Slice(0, 6, 3)});
+    sub.fill(-1.0f);
+    assert(arr(0, 0, 0) == -1.0f && arr(1, 0, 3) == -1.0f && arr(1, 0, 4) == 16.0f);
+    auto nested = slice(slice(arr, {1}), {Slice(N, N, -1), 2});
+    assert(nested(0) == 20.0f && nested(1) == 14.0f);
+    ndarray<float> vals(Shape{2});
+    vals[0] = 100.0f; vals[1] = 200.0f;
+    nested.assign(vals);
+    assert(arr(1, 1, 2) == 100.0f && arr(1, 0, 2) == 200.0f);
+
+    const auto& carr = arr;
+    strided_view<const float> cv = slice(carr, {0});
+    assert(cv(1, 1) == 7.0f);
+
+    // 1D compatibility wrapper
+    auto line = iota2d(1, 10).reshape({10});
+    auto s = slice_1d(line, 1, 8, 3);
+    assert(s.size() == 3 && s[0] == 1.0f && s[2] == 7.0f);
+
+    bool threw = false;
+    try { slice(arr, {Slice(0, 1, 0)}); } catch (const std::runtime_error&) { threw = true; }
+    assert(threw);
+    threw = false;
+    try { slice(arr, {0, 0, 6}); } catch (const std::out_of_range&) { threw = true; }
+    assert(threw);
+    threw = false;
+    try { slice(arr, {0, 0, 0, 0}); } catch (const std::out_of_range&) { threw = true; }
+    assert(threw);
+}
+
+/**
+ * @brief Test materializing a large non-contiguous view (parallel copy path).
+ */
+TEST_CASE(test_large_slice_copy) {
+    auto big = iota2d(512, 300);
+    const index_t N = Slice::NONE;
+    auto v = slice(big, {Slice(1, N, 2), Slice(10, 266)});
+    auto c = v.copy();
+    assert((c.shape() == Shape{256, 256}));
+    for (size_t i = 0; i < 256; i += 17)
+        for (size_t j = 0; j < 256; j += 5) assert(c(i, j) == big(2 * i + 1, j + 10));
+
+    auto t = slice(big, {Slice(N, N, -3), Slice(N, N, -7)}).copy();
+    assert(t(0, 0) == big(511, 299) && t(1, 1) == big(508, 292));
+}
+
+/**
+ * @brief Test masked_select, compress, nonzero, argwhere and masked writes.
+ */
+TEST_CASE(test_boolean_masks) {
+    auto arr = iota2d(3, 4);
+    ndarray<float> threshold(Shape{1}, std::vector<float>{6.5f});
+    auto mask = greater(arr, threshold);
+
+    auto sel = masked_select(arr, mask);
+    assert((sel.shape() == Shape{5}));
+    assert(sel[0] == 7.0f && sel[4] == 11.0f);
+
+    // A broadcast row mask selects the same columns in every row
+    ndarray<bool> cols(Shape{4}, std::vector<bool>{true, false, false, true});
+    auto bc = masked_select(arr, cols);
+    assert(bc.size() == 6 && bc[0] == 0.0f && bc[1] == 3.0f && bc[5] == 11.0f);
+
+    ndarray<bool> rows(Shape{2}, std::vector<bool>{false, true});
+    auto c0 = compress(rows, arr, 0);
+    assert((c0.shape() == Shape{1, 4}) && c0(0, 2) == 6.0f);
+    auto c1 = compress(cols, arr, 1);
+    assert((c1.shape() == Shape{3, 2}) && c1(2, 0) == 8.0f && c1(2, 1) == 11.0f);
+    auto cf = compress(cols, arr);
+    assert(cf.size() == 2 && cf[1] == 3.0f);
+
+    auto nz = nonzero(mask);
+    assert(nz.size() == 2 && nz[0].size() == 5);
+    assert(nz[0][0] == 1 && nz[1][0] == 3 && nz[0][4] == 2 && nz[1][4] == 3);
+    auto back = advanced_indexing(arr, nz);
+    for (size_t k = 0; k < back.size(); ++k) assert(back[k] == sel[k]);
+
+    ndarray<int> ints(Shape{5}, std::vector<int>{0, 3, 0, 0, -1});
+    auto fnz = flatnonzero(ints);
+    assert(fnz.size() == 2 && fnz[0] == 1 && fnz[1] == 4);
+    auto aw = argwhere(arr);
+    assert((aw.shape() == Shape{11, 2}) && aw(0, 0) == 0 && aw(0, 1) == 1 && aw(10, 0) == 2);
+
+    auto filled = arr;
+    masked_fill(filled, mask, -1.0f);
+    assert(filled(1, 2) == 6.0f && filled(1, 3) == -1.0f && filled(2, 3) == -1.0f);
+
+    ndarray<float> vals(Shape{5}, std::vector<float>{10, 20, 30, 40, 50});
+    masked_assign(arr, mask, vals);
+    assert(arr(1, 3) == 10.0f && arr(2, 0) == 20.0f && arr(2, 3) == 50.0f && arr(1, 2) == 6.0f);
+
+    bool threw = false;
+    try { masked_assign(arr, mask, ndarray<float>(Shape{3})); } catch (const std::runtime_error&) { threw = true; }
+    assert(threw);
+    threw = false;
+    try { compress(ndarray<bool>(Shape{5}), arr, 1); } catch (const std::out_of_range&) { threw = true; }
+    assert(threw);
+}
+
+/**
+ * @brief Test mask compaction on arrays large enough for the blocked parallel path.
+ */
+TEST_CASE(test_large_mask_compaction) {
+    const size_t n = 200003;
+    ndarray<int32_t> values(Shape{n});
+    ndarray<bool> mask(Shape{n});
+    size_t expected = 0;
+    for (size_t i = 0; i < n; ++i) {
+        values[i] = static_cast<int32_t>(i);
+        // Mix of all-false, all-true and sparse words
+        bool on = (i / 64) % 3 == 0 ? false : ((i / 64) % 3 == 1 ? true : (i % 7 == 0));
+        mask[i] = on;
+        expected += on;
+    }
+    auto sel = masked_select(values, mask);
+    assert(sel.size() == expected);
+    auto idx = flatnonzero(mask);
+    assert(idx.size() == expected);
+    size_t k = 0;
+    for (size_t i = 0; i < n; ++i) {
+        if (!mask[i]) continue;
+        assert(sel[k] == static_cast<int32_t>(i) && idx[k] == static_cast<int64_t>(i));
+        ++k;
+    }
+    masked_assign(values, mask, ndarray<int32_t>(Shape{expected}));
+    for (size_t i = 0; i < n; i += 11) assert(values[i] == (mask[i] ? 0 : static_cast<int32_t>(i)));
+}
+
+int main() {
+    std::cout << "=== NumBits Indexing Tests ===\n\n";
+
+    RUN_TEST(test_take);
+    RUN_TEST(test_advanced_indexing);
+    RUN_TEST(test_put_and_scatter);
+    RUN_TEST(test_large_gather_scatter);
+    RUN_TEST(test_nd_slice);
+    RUN_TEST(test_large_slice_copy);
+    RUN_TEST(test_boolean_masks);
+    RUN_TEST(test_large_mask_compaction);
+
+    std::cout << "\nAll tests passed!\n";
+    return 0;
+}
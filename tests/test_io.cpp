@@ -8,6 +8,9 @@
  *   - Binary I/O without separators
  *   - Type mismatch error handling
  *   - Whitespace flexibility in text parsing
+ *   - Chunked streaming I/O (ChunkReader/ChunkWriter)
+ *   - Asynchronous prefetching (AsyncLoader)
+ *   - Compressed dump/load (shuffle filter, RLE and LZ codecs)
  *
  * @date 2025
  */
@@ -17,6 +20,7 @@
 #include <algorithm>
 #include <fstream>
 #include <vector>
+#include <string>
 #include "numbits/numbits.hpp"
 
 using namespace numbits;
@@ -185,6 +189,180 @@ TEST_CASE(test_io_preserves_shape) {
     remove_file("test_shape.cb");
 }
 
+/**
+ * @brief Test streaming a .cb file in row blocks with ChunkReader.
+ */
+TEST_CASE(test_chunk_reader) {
+    ndarray<float> arr({5, 2}, {0, 1, 2, 3, 4, 5, 6, 7, 8, 9});
+    dump(arr, "test_chunks.cb");
+
+    ChunkReader<float> reader("test_chunks.cb", 2);
+    assert((reader.shape() == Shape{5, 2}));
+
+    ndarray<float> block;
+    std::vector<size_t> block_rows;
+    float total = 0;
+    while (reader.next(block)) {
+        assert(block.ndim() == 2 && block.shape()[1] == 2);
+        block_rows.push_back(block.shape()[0]);
+        total += sum(block);
+    }
+    assert((block_rows == std::vector<size_t>{2, 2, 1}));
+    assert(total == 45.0f);
+
+    reader.seek(3);
+    assert(reader.next(block));
+    assert(block[0] == 6.0f && block.shape()[0] == 2);
+
+    remove_file("test_chunks.cb");
+}
+
+/**
+ * @brief Test ChunkWriter header fix-up and append mode.
+ */
+TEST_CASE(test_chunk_writer) {
+    {
+        ChunkWriter<int> writer("test_writer.cb", {3});
+        writer.append(ndarray<int>({2, 3}, {1, 2, 3, 4, 5, 6}));
+        writer.append(ndarray<int>({3}, {7, 8, 9}));
+        writer.close();
+        assert(writer.rows() == 3);
+    }
+    auto loaded = load<int>("test_writer.cb");
+    assert((loaded.shape() == Shape{3, 3}));
+    assert(loaded[8] == 9);
+
+    {
+        ChunkWriter<int> writer("test_writer.cb", {3}, true);
+        writer.append(ndarray<int>({1, 3}, {10, 11, 12}));
+    }   // destructor finalizes the header
+    loaded = load<int>("test_writer.cb");
+    assert((loaded.shape() == Shape{4, 3}));
+    assert(loaded[11] == 12);
+
+    bool threw = false;
+    try {
+        ChunkWriter<int> writer("test_writer.cb", {4}, true);
+    } catch (...) {
+        threw = true;
+    }
+    assert(threw);
+
+    remove_file("test_writer.cb");
+}
+
+/**
+ * @brief Test prefetching a sequence of shards with AsyncLoader.
+ */
+TEST_CASE(test_async_loader) {
+    std::vector<std::string> files;
+    for (int i = 0; i < 4; ++i) {
+        std::string name = "test_shard" + std::to_string(i) + ".cb";
+        dump(ndarray<int>({2}, {i, i * 10}), name);
+        files.push_back(name);
+    }
+
+    AsyncLoader<int> loader(files, 2);
+    int count = 0;
+    while (loader.has_next()) {
+        auto shard = loader.next();
+        assert(shard[0] == count && shard[1] == count * 10);
+        ++count;
+    }
+    assert(count == 4);
+
+    // Errors surface through the future
+    auto missing = loader.submit("does_not_exist.cb");
+    bool threw = false;
+    try {
+        missing.get();
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+
+    for (const auto& f : files) remove_file(f);
+}
+
+/**
+ * @brief Test compressed dump/load round trips for every codec.
+ */
+TEST_CASE(test_dump_load_compressed) {
+    // Smooth float data, several chunks
+    ndarray<float> smooth({1000});
+    for (size_t i = 0; i < smooth.size(); ++i) smooth[i] = static_cast<float>(i % 50) * 0.25f;
+
+    // Sparse integer data
+    ndarray<int64_t> sparse({40, 25});
+    sparse[7] = 3;
+    sparse[999] = -12;
+
+    for (Codec codec : {Codec::NONE, Codec::RLE, Codec::LZ}) {
+        CompressionOptions options;
+        options.codec = codec;
+        options.chunk_bytes = 1000;
+
+        dump(smooth, "test_compressed_f.cb", options);
+        auto f = load<float>("test_compressed_f.cb");
+        assert(f.shape() == smooth.shape());
+        assert(std::equal(f.begin(), f.end(), smooth.begin()));
+
+        options.shuffle = false;
+        dump(sparse, "test_compressed_i.cb", options);
+        auto i = load<int64_t>("test_compressed_i.cb");
+        assert(i.shape() == sparse.shape());
+        assert(std::equal(i.begin(), i.end(), sparse.begin()));
+    }
+
+    // Compressed file really is smaller than the raw dump
+    dump(sparse, "test_compressed_i.cb", CompressionOptions{Codec::RLE, true, 1 << 16});
+    std::ifstream in("test_compressed_i.cb", std::ios::binary | std::ios::ate);
+    assert(static_cast<size_t>(in.tellg()) < sparse.size() * sizeof(int64_t) / 10);
+    in.close();
+
+    // A chunk size larger than its raw chunk is rejected before allocating
+    {
+        std::fstream patch("test_compressed_i.cb", std::ios::binary | std::ios::in | std::ios::out);
+        const size_t huge = size_t(1) << 50;
+        patch.seekp(4 + 8 + 2 * 8 + 8 + 4 + 4 + 8 + 8);  // header, codec header, then chunk_sizes[0]
+        patch.write(reinterpret_cast<const char*>(&huge), sizeof(huge));
+    }
+    bool threw = false;
+    try { load<int64_t>("test_compressed_i.cb"); } catch (const std::runtime_error&) { threw = true; }
+    assert(threw);
+
+    remove_file("test_compressed_f.cb");
+    remove_file("test_compressed_i.cb");
+}
+
+/**
+ * @brief Test that the codecs reject corrupt input instead of overrunning.
+ */
+TEST_CASE(test_codec_corruption) {
+    std::vector<uint8_t> data(300, 7);
+    auto encoded = lz_compress(data.data(), data.size());
+    std::vector<uint8_t> out(data.size());
+    lz_decompress(encoded.data(), encoded.size(), out.data(), out.size());
+    assert(out == data);
+
+    bool threw = false;
+    try {
+        lz_decompress(encoded.data(), encoded.size() / 2, out.data(), out.size());
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+
+    encoded = rle_compress(data.data(), data.size());
+    threw = false;
+    try {
+        rle_decompress(encoded.data(), encoded.size(), out.data(), out.size() - 1);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+}
+
 //   Main
 int main() {
     std::cout << "=== NumBits IO Tests ===\n\n";
@@ -197,6 +375,11 @@ int main() {
     RUN_TEST(test_text_whitespace_flexibility);
     RUN_TEST(test_load_multiple_types);
     RUN_TEST(test_io_preserves_shape);
+    RUN_TEST(test_chunk_reader);
+    RUN_TEST(test_chunk_writer);
+    RUN_TEST(test_async_loader);
+    RUN_TEST(test_dump_load_compressed);
+    RUN_TEST(test_codec_corruption);
 
     std::cout << "\nAll tests passed!\n";
     return 0;
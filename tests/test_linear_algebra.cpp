@@ -8,6 +8,8 @@
  *   - Determinant calculation (2x2 matrices)
  *   - Matrix inverse
  *   - Matrix trace (sum of diagonal elements)
+ *   - Fixed-size static_ndarray kernels and ndarray views
+ *   - axpy/vdot kernels and the cg, bicgstab and gmres solvers with preconditioners
  *
  * @date 2025
  */
@@ -130,6 +132,176 @@ TEST_CASE(test_trace_diagonal_matrix) {
     assert(trace(diag) == 10.0f);
 }
 
+/**
+ * @brief Test fixed-size kernels against the dynamic implementations.
+ */
+TEST_CASE(test_static_ndarray_kernels) {
+    static_ndarray<double, 4, 4> a = {
+        4, 1, 2, 0,
+        1, 5, 0, 3,
+        2, 0, 6, 1,
+        0, 3, 1, 7
+    };
+    ndarray<double> da = a.to_ndarray();
+    assert(std::abs(determinant(a) - determinant(da)) < 1e-9);
+
+    auto inv = inverse(a);
+    auto dinv = inverse(da);
+    for (size_t i = 0; i < a.size(); ++i) assert(std::abs(inv[i] - dinv[i]) < 1e-12);
+    auto id = matmul(a, inv);
+    for (size_t i = 0; i < 4; ++i)
+        for (size_t j = 0; j < 4; ++j) assert(std::abs(id(i, j) - (i == j ? 1.0 : 0.0)) < 1e-12);
+
+    static_ndarray<double, 3, 3> b = {2, -1, 0, -1, 2, -1, 0, -1, 2};
+    assert(std::abs(determinant(b) - 4.0) < 1e-12);
+    auto binv = inverse(b);
+    assert(std::abs(binv(0, 0) - 0.75) < 1e-12 && std::abs(binv(1, 1) - 1.0) < 1e-12);
+
+    // General path (N > 4) and singular input
+    auto big = static_ndarray<double, 5, 5>::identity() * 2.0;
+    assert(std::abs(determinant(big) - 32.0) < 1e-12);
+    assert(inverse(big)(4, 4) == 0.5);
+    bool threw = false;
+    try {
+        inverse(static_ndarray<double, 2, 2>::ones());
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+
+    // Singularity is judged relative to the matrix scale: 1e-4 * I has det 1e-12 but is well conditioned
+    auto small = static_ndarray<double, 3, 3>::identity() * 1e-4;
+    assert(std::abs(inverse(small)(2, 2) - 1e4) < 1e-6);
+    auto small4 = static_ndarray<double, 4, 4>::identity() * 1e-4;
+    assert(std::abs(inverse(small4)(0, 0) - 1e4) < 1e-6);
+    threw = false;
+    try {
+        inverse(static_ndarray<double, 3, 3>::ones() * 1e-4);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+
+    static_ndarray<float, 2, 3> m = {1, 2, 3, 4, 5, 6};
+    static_ndarray<float, 3> x = {1, 0, -1};
+    auto mx = matmul(m, x);
+    assert(mx[0] == -2.0f && mx[1] == -2.0f);
+    assert((transpose(m)(2, 1) == 6.0f));
+
+    // Zero-copy view and checked conversion back
+    ndarray<float> v = m.view();
+    assert((v.shape() == Shape{2, 3}) && v.data() == m.data());
+    v.at({1, 2}) = 9.0f;
+    assert((m(1, 2) == 9.0f));
+    static_ndarray<float, 2, 3> back(v);
+    assert(back == m);
+    threw = false;
+    try {
+        static_ndarray<float, 3, 2> wrong(v);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+}
+
+/**
+ * @brief 2D Laplacian on a g x g grid plus a convection term (nonsymmetric if c != 0).
+ */
+static csr_matrix<double> grid_operator(size_t g, double c) {
+    coo_matrix<double> coo(g * g, g * g);
+    for (size_t i = 0; i < g; ++i)
+        for (size_t j = 0; j < g; ++j) {
+            const size_t k = i * g + j;
+            coo.push_back(k, k, 4.0);
+            if (i > 0) coo.push_back(k, k - g, -1.0);
+            if (i + 1 < g) coo.push_back(k, k + g, -1.0);
+            if (j > 0) coo.push_back(k, k - 1, -1.0 - c);
+            if (j + 1 < g) coo.push_back(k, k + 1, -1.0 + c);
+        }
+    return coo.tocsr();
+}
+
+static double residual(const csr_matrix<double>& A, const ndarray<double>& x, const ndarray<double>& b) {
+    auto r = subtract(b, matmul(A, x));
+    return std::sqrt(vdot(r, r) / vdot(b, b));
+}
+
+/**
+ * @brief Test the vector kernels and the CG, BiCGSTAB and GMRES solvers.
+ */
+TEST_CASE(test_iterative_solvers) {
+    ndarray<double> u({3}, {1.0, 2.0, 3.0});
+    ndarray<double> v({3}, {4.0, 5.0, 6.0});
+    assert(vdot(u, v) == 32.0);
+    axpy(2.0, u, v);
+    assert(v[2] == 12.0);
+    axpby(1.0, u, -1.0, v);
+    assert(v[0] == -5.0);
+    // 16-bit dot products accumulate in float: 4096 ones sum exactly
+    auto h = ndarray<float>::ones(Shape{4096}).astype<float16>();
+    assert(static_cast<float>(vdot(h, h)) == 4096.0f);
+    auto hb = ndarray<float>::ones(Shape{SOLVER_PARALLEL_MIN}).astype<bfloat16>();
+    assert(static_cast<float>(vdot(hb, hb)) == static_cast<float>(SOLVER_PARALLEL_MIN));  // parallel path
+
+    const size_t g = 40;
+    auto A = grid_operator(g, 0.0);
+    ndarray<double> b(Shape{g * g});
+    for (size_t i = 0; i < b.size(); ++i) b[i] = std::sin(0.01 * static_cast<double>(i)) + 1.0;
+
+    SolverOptions opts;
+    opts.rtol = 1e-10;
+    auto plain = cg(A, b, opts);
+    assert(plain.converged && residual(A, plain.x, b) < 1e-9);
+    assert(plain.residual_history.size() == plain.iterations + 1 && plain.matvecs == plain.iterations);
+    auto jac = cg(A, b, opts, jacobi_preconditioner<double>(A));
+    assert(jac.converged && residual(A, jac.x, b) < 1e-9);
+    auto ic = cg(A, b, opts, ichol_preconditioner<double>(A));
+    assert(ic.converged && residual(A, ic.x, b) < 1e-9 && ic.iterations < plain.iterations / 2);
+
+    // Matrix-free operator and warm start
+    auto op = [&](const ndarray<double>& x, ndarray<double>& y) { spmv(A, x, y); };
+    auto mf = cg(op, b, opts, identity_preconditioner(), plain.x);
+    assert(mf.converged && mf.iterations <= 1);
+
+    // Nonsymmetric systems
+    auto N = grid_operator(g, 0.4);
+    for (size_t restart : {10, 40}) {
+        opts.restart = restart;
+        auto gm = gmres(N, b, opts, ichol_preconditioner<double>(A));
+        assert(gm.converged && residual(N, gm.x, b) < 1e-8);
+        for (size_t i = 1; i < gm.residual_history.size(); ++i)
+            assert(gm.residual_history[i] <= gm.residual_history[i - 1] * (1 + 1e-12));  // minimal residual
+    }
+    auto bi = bicgstab(N, b, opts, jacobi_preconditioner<double>(N));
+    assert(bi.converged && residual(N, bi.x, b) < 1e-8);
+    auto bi_csc = bicgstab(N.tocsc(), b, opts);
+    assert(bi_csc.converged && residual(N, bi_csc.x, b) < 1e-8);
+
+    // Dense float system
+    ndarray<float> D({3, 3}, {4.0f, 1.0f, 0.0f,
+                              1.0f, 3.0f, -1.0f,
+                              0.0f, -1.0f, 2.0f});
+    ndarray<float> db({3}, {1.0f, 2.0f, 3.0f});
+    SolverOptions fopts;
+    fopts.rtol = 1e-6;
+    auto dx = gmres(D, db, fopts);
+    auto check = matmul(D, dx.x.reshape({3, 1}));
+    for (size_t i = 0; i < 3; ++i) assert(std::fabs(check[i] - db[i]) < 1e-4f);
+    assert(cg(D, db, fopts, ichol_preconditioner<float>(D)).iterations <= 3);
+
+    // Iteration limit is reported, not thrown
+    opts.max_iter = 3;
+    auto capped = cg(A, b, opts);
+    assert(!capped.converged && capped.iterations == 3 && capped.residual_norm > 0.0);
+
+    bool threw = false;
+    try { cg(A, ndarray<double>(Shape{5}), opts); } catch (const std::runtime_error&) { threw = true; }
+    assert(threw);
+    threw = false;
+    try { ichol_preconditioner<double>(ndarray<double>({2, 2}, {1.0, 2.0, 2.0, 1.0})); } catch (const std::runtime_error&) { threw = true; }
+    assert(threw);  // indefinite
+}
+
 int main() {
     RUN_TEST(test_matrix_multiplication);
     RUN_TEST(test_transpose);
@@ -140,6 +312,8 @@ int main() {
     RUN_TEST(test_chained_matmul);
     RUN_TEST(test_transpose_twice);
     RUN_TEST(test_trace_diagonal_matrix);
+    RUN_TEST(test_static_ndarray_kernels);
+    RUN_TEST(test_iterative_solvers);
 
     std::cout << "All tests passed!\n";
     return 0;
@@ -9,7 +9,7 @@
  *   - Broadcasting with where, clip
  *   - Logical operations (and, or, xor, not)
  *   - Boolean reductions (all, any)
- *   - Cumulative operations (cumsum, cumprod)
+ *   - Cumulative operations (cumsum, cumprod, cummax, cummin), flat and along axes
  *   - Index finding (argmax, argmin)
  *
  * @date 2025
@@ -17,8 +17,14 @@
 
 #include <iostream>
 #include <cassert>
+#include <cmath>
+#include <limits>
 #include "numbits/numbits.hpp"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 using namespace numbits;
 
 #define TEST_CASE(name) void name()
@@ -99,6 +105,41 @@ TEST_CASE(test_where_broadcasting) {
     assert(result[5] == 0.0f);
 }
 
+/**
+ * @brief Test where with scalar operands and large strided broadcasts.
+ */
+TEST_CASE(test_where_scalar_and_strided) {
+    ndarray<float> arr({2, 3}, {-1.0f, 2.0f, -3.0f, 4.0f, -5.0f, 6.0f});
+    auto positive = greater(arr, ndarray<float>({1}, {0.0f}));
+
+    auto relu = where(positive, arr, 0);
+    assert(relu[0] == 0.0f && relu[1] == 2.0f && relu[4] == 0.0f && relu[5] == 6.0f);
+    auto flipped = where(positive, 1.0f, arr);
+    assert(flipped[0] == -1.0f && flipped[1] == 1.0f);
+    auto sign = where(positive, 1.0f, -1.0f);
+    assert((sign.shape() == Shape{2, 3}) && sign[2] == -1.0f && sign[3] == 1.0f);
+
+    // Row-vector fill values and a column condition, large enough to run in chunks
+    const size_t rows = 300, cols = 257;
+    ndarray<float> data({rows, cols});
+    ndarray<bool> keep({rows, 1});
+    ndarray<float> fill({cols});
+    for (size_t i = 0; i < data.size(); ++i) data[i] = static_cast<float>(i);
+    for (size_t r = 0; r < rows; ++r) keep[r] = r % 3 != 0;
+    for (size_t c = 0; c < cols; ++c) fill[c] = -static_cast<float>(c);
+
+    auto imputed = where(keep, data, fill);
+    assert((imputed.shape() == Shape{rows, cols}));
+    for (size_t r = 0; r < rows; r += 7)
+        for (size_t c = 0; c < cols; c += 5)
+            assert(imputed(r, c) == (r % 3 != 0 ? data(r, c) : fill[c]));
+
+    ndarray<bool> full({rows, cols});
+    for (size_t i = 0; i < full.size(); ++i) full[i] = i % 5 < 2;
+    auto masked = where(full, data, -1.0f);
+    for (size_t i = 0; i < masked.size(); i += 3) assert(masked[i] == (i % 5 < 2 ? data[i] : -1.0f));
+}
+
 /**
  * @brief Test clipping values to a range (scalar bounds).
  */
@@ -122,7 +163,7 @@ TEST_CASE(test_clip_broadcast) {
     assert((clipped.shape() == Shape{2, 2}));
     assert(clipped[0] == 0.0f);
     assert(clipped[1] == 0.2f);
-    assert(clipped[2] == 0.5f);
+    assert(clipped[2] == 0.9f);
     assert(clipped[3] == 0.4f);
 }
 
@@ -196,6 +237,68 @@ TEST_CASE(test_cumulative_operations) {
     assert((prods[0] == 1 && prods[1] == 2 && prods[2] == 6 && prods[3] == 24 && prods[4] == 120));
 }
 
+/**
+ * @brief Test scans along axes, NaN handling, wider accumulators and the parallel path.
+ */
+TEST_CASE(test_cumulative_axis) {
+    ndarray<int> m({2, 3}, {1, 5, 2,
+                            4, 0, 3});
+    auto down = cumsum(m, 0);
+    assert(down(0, 1) == 5 && down(1, 0) == 5 && down(1, 2) == 5);
+    auto across = cumsum(m, -1);
+    assert(across(0, 2) == 8 && across(1, 1) == 4 && across(1, 2) == 7);
+    auto prod = cumprod(m, 1);
+    assert(prod(0, 2) == 10 && prod(1, 1) == 0);
+    auto hi = cummax(m, 1);
+    assert(hi(0, 1) == 5 && hi(0, 2) == 5 && hi(1, 2) == 4);
+    auto lo = cummin(m, 0);
+    assert(lo(1, 0) == 1 && lo(1, 1) == 0 && lo(1, 2) == 2);
+    assert((cummax(m).shape() == Shape{2, 3}) && cummax(m)(1, 2) == 5);
+
+    // Strided lanes wider than one column block
+    ndarray<int> wide(Shape{3, 1500});
+    for (size_t i = 0; i < wide.size(); ++i) wide[i] = static_cast<int>(i % 1500);
+    auto col = cumsum(wide, 0);
+    assert(col(2, 0) == 0 && col(2, 1499) == 3 * 1499 && col(1, 1024) == 2048);
+
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    ndarray<float> f({5}, {1.0f, 3.0f, nan, 7.0f, 2.0f});
+    auto fmax = cummax(f);
+    assert(fmax[1] == 3.0f && std::isnan(fmax[2]) && std::isnan(fmax[4]));
+    assert(cummin(f)[1] == 1.0f && std::isnan(cummin(f)[3]));
+
+    ndarray<int32_t> big_values({3}, {2000000000, 2000000000, 2000000000});
+    auto wide_sum = cumsum<int64_t>(big_values);
+    assert(wide_sum[2] == 6000000000LL);
+    ndarray<float> tiny(Shape{100000});
+    tiny.fill(0.1f);
+    auto dsum = cumsum<double>(tiny, 0);
+    assert(std::fabs(dsum[99999] - 10000.0) < 1e-2);
+
+    bool threw = false;
+    try { cumsum(m, 2); } catch (const std::runtime_error&) { threw = true; }
+    assert(threw);
+
+#ifdef _OPENMP
+    int saved = omp_get_max_threads();
+    omp_set_num_threads(4);
+#endif
+    const size_t n = 200003;
+    ndarray<int64_t> seq(Shape{n});
+    for (size_t i = 0; i < n; ++i) seq[i] = static_cast<int64_t>(i % 11) - 5;
+    auto run = cumsum(seq);
+    auto peak = cummax(seq);
+    int64_t total = 0, best = seq[0];
+    for (size_t i = 0; i < n; ++i) {
+        total += seq[i];
+        best = std::max(best, seq[i]);
+        assert(run[i] == total && peak[i] == best);
+    }
+#ifdef _OPENMP
+    omp_set_num_threads(saved);
+#endif
+}
+
 /**
  * @brief Test subtraction of arrays.
  */
@@ -243,6 +346,58 @@ TEST_CASE(test_scalar_multiplication) {
     assert(b[3] == 12.0f);
 }
 
+/**
+ * @brief Test bit-packed masks: packed comparisons, logical ops, reductions, where.
+ */
+TEST_CASE(test_bitmask) {
+    const size_t n = 130;  // spans three words with a partial tail
+    ndarray<int> values({n}), parity({n});
+    for (size_t i = 0; i < n; ++i) {
+        values[i] = static_cast<int>(i);
+        parity[i] = static_cast<int>(i % 2);
+    }
+
+    bitmask lo = less_bits(values, 100);
+    bitmask even = equal_bits(parity, 0);
+    assert(lo.size() == n && lo.num_words() == 3 && lo.nbytes() == 24);
+    assert(lo.count() == 100 && lo[99] && !lo[100]);
+    assert(even.count() == 65);
+
+    bitmask both = lo & even;
+    assert(both.count() == 50 && both == logical_and(lo, even));
+    assert((lo | even).count() == 115);
+    assert(logical_xor(lo, even).count() == 65);
+    bitmask hi = ~lo;
+    assert(hi.count() == 30 && logical_not(hi) == lo);
+    assert(!all(lo) && any(lo) && all(lo | hi) && !any(lo & hi));
+    assert(count_nonzero(both) == 50);
+
+    // Packed results match the byte-per-element comparisons
+    ndarray<bool> bytes = less(values, ndarray<int>({1}, {100}));
+    assert(bitmask(bytes) == lo);
+    ndarray<bool> round_trip = both.to_ndarray();
+    for (size_t i = 0; i < n; ++i) assert(round_trip[i] == (i < 100 && i % 2 == 0));
+
+    // Broadcast comparison
+    ndarray<int> grid({2, 3}, {1, 5, 9, 2, 6, 10});
+    ndarray<int> row({1, 3}, {2, 5, 9});
+    bitmask ge = greater_equal_bits(grid, row);
+    assert((ge.shape() == Shape{2, 3}) && ge.count() == 5 && !ge[0]);
+
+    auto picked = where(lo, values, ndarray<int>({1}, {-1}));
+    assert(picked[0] == 0 && picked[99] == 99 && picked[100] == -1 && picked[129] == -1);
+
+    bitmask m(Shape{3});
+    m.set(1, true);
+    assert(m.count() == 1 && m[1]);
+    m.set(1, false);
+    assert(!any(m) && all(bitmask(Shape{0})));
+
+    bool threw = false;
+    try { lo & bitmask(Shape{n + 1}); } catch (const std::runtime_error&) { threw = true; }
+    assert(threw);
+}
+
 int main() {
     RUN_TEST(test_addition);
     RUN_TEST(test_scalar_addition);
@@ -250,16 +405,19 @@ int main() {
     RUN_TEST(test_sum_reduction);
     RUN_TEST(test_mean_reduction);
     RUN_TEST(test_where_broadcasting);
+    RUN_TEST(test_where_scalar_and_strided);
     RUN_TEST(test_clip_scalar);
     RUN_TEST(test_clip_broadcast);
     RUN_TEST(test_argmax_argmin);
     RUN_TEST(test_logical_operations);
     RUN_TEST(test_all_any);
     RUN_TEST(test_cumulative_operations);
+    RUN_TEST(test_cumulative_axis);
     RUN_TEST(test_subtraction);
     RUN_TEST(test_division);
     RUN_TEST(test_min_max_reduction);
     RUN_TEST(test_scalar_multiplication);
+    RUN_TEST(test_bitmask);
 
     std::cout << "All tests passed!\n";
     return 0;
@@ -0,0 +1,204 @@
+/**
+ * @file test_quantization.cpp
+ * @brief Unit tests for int8 quantization and quantized matrix multiplication.
+ *
+ * Tests the following:
+ *   - Symmetric and asymmetric per-tensor quantize()/dequantize()
+ *   - Per-channel parameters along leading and trailing axes
+ *   - matmul_int8() against a reference product, full int8 range and odd sizes
+ *   - qmatmul() with zero points and per-channel scales against float matmul
+ *   - The INT8 dtype in dump()/load() and runtime cast()
+ *
+ * @date 2025
+ */
+
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "numbits/numbits.hpp"
+
+using namespace numbits;
+
+#define TEST_CASE(name) void name()
+#define RUN_TEST(name)  \
+    std::cout << "Running " #name "... "; \
+    name(); \
+    std::cout << "OK\n";
+
+/**
+ * @brief Build an array of pseudo-random values in [lo, hi).
+ */
+static ndarray<float> random_array(const Shape& shape, float lo, float hi, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<float> dist(lo, hi);
+    ndarray<float> arr(shape);
+    for (auto& x : arr) x = dist(gen);
+    return arr;
+}
+
+/**
+ * @brief Test per-tensor and per-channel quantize()/dequantize() round trips.
+ */
+TEST_CASE(test_quantize) {
+    ndarray<float> x({5}, {-1.0f, -0.5f, 0.0f, 0.25f, 0.5f});
+    auto sym = quantize(x);
+    assert(sym.zero_points[0] == 0 && std::fabs(sym.scales[0] - 1.0f / 127.0f) < 1e-9f);
+    assert(sym.values[0] == -127 && sym.values[2] == 0 && sym.values[4] == 64);  // 63.5 rounds to even
+
+    auto asym = quantize(x, false);
+    assert(std::fabs(asym.scales[0] - 1.5f / 255.0f) < 1e-7f);
+    assert(asym.values[0] == -128 && asym.values[4] == 127);
+    auto back = dequantize(asym);
+    for (size_t i = 0; i < x.size(); ++i) assert(std::fabs(back[i] - x[i]) <= asym.scales[0] / 2 + 1e-6f);
+    assert(back[2] == 0.0f);  // zero is exact
+
+    // Large arrays take the parallel path
+    auto big = random_array({300, 500}, -3.0f, 5.0f, 1);
+    for (bool symmetric : {true, false}) {
+        auto q = quantize(big, symmetric);
+        auto d = dequantize<double>(q);
+        for (size_t i = 0; i < big.size(); ++i) assert(std::fabs(d[i] - big[i]) <= q.scales[0] / 2 + 1e-5);
+    }
+
+    // Per-channel along axis 0 (rows) and the last axis (columns)
+    ndarray<float> w({2, 3}, {1.0f, -2.0f, 0.5f,
+                              100.0f, 50.0f, -25.0f});
+    auto rows = quantize(w, 0);
+    assert(rows.axis == 0 && rows.scales.size() == 2);
+    assert(rows.values(0, 1) == -127 && rows.values(1, 0) == 127 && rows.values(1, 2) == -32);
+    auto cols = quantize(w, -1, false);
+    assert(cols.axis == 1 && cols.scales.size() == 3);
+    auto dc = dequantize(cols);
+    for (size_t i = 0; i < w.size(); ++i) assert(std::fabs(dc[i] - w[i]) <= 100.0f / 255.0f);
+
+    auto cube = random_array({4, 7, 5}, -1.0f, 1.0f, 2);
+    auto qc = quantize(cube, 1, false);
+    auto dq = dequantize(qc);
+    for (size_t i = 0; i < cube.size(); ++i) assert(std::fabs(dq[i] - cube[i]) <= qc.scales[(i / 5) % 7]);
+
+    ndarray<float> zeros({3}, {0.0f, 0.0f, 0.0f});
+    assert(dequantize(quantize(zeros))[1] == 0.0f);
+
+    bool threw = false;
+    try { quantize(ndarray<float>({2}, {1.0f, INFINITY})); } catch (const std::runtime_error&) { threw = true; }
+    assert(threw);
+    threw = false;
+    try { quantize(w, 2); } catch (const std::exception&) { threw = true; }
+    assert(threw);
+}
+
+/**
+ * @brief Test matmul_int8() against a scalar reference.
+ */
+TEST_CASE(test_matmul_int8) {
+    std::mt19937 gen(3);
+    std::uniform_int_distribution<int> dist(-128, 127);
+    for (size_t m : {1, 5, 33}) {
+        for (size_t n : {1, 7, 17, 40}) {
+            for (size_t k : {1, 3, 64, 131}) {
+                ndarray<int8_t> a(Shape{m, k});
+                ndarray<int8_t> b(Shape{k, n});
+                for (auto& v : a) v = static_cast<int8_t>(dist(gen));
+                for (auto& v : b) v = static_cast<int8_t>(dist(gen));
+                auto c = matmul_int8(a, b);
+                assert((c.shape() == Shape{m, n}));
+                for (size_t i = 0; i < m; ++i)
+                    for (size_t j = 0; j < n; ++j) {
+                        int32_t ref = 0;
+                        for (size_t kk = 0; kk < k; ++kk) ref += int32_t(a(i, kk)) * int32_t(b(kk, j));
+                        assert(c(i, j) == ref);
+                    }
+            }
+        }
+    }
+
+    // Extreme values: -128 * -128 summed over a long k
+    ndarray<int8_t> lo(Shape{2, 1000});
+    lo.fill(-128);
+    ndarray<int8_t> lo_t(Shape{1000, 3});
+    lo_t.fill(-128);
+    auto c = matmul_int8(lo, lo_t);
+    assert(c(1, 2) == 16384000);
+
+    // Large enough for the parallel path
+    ndarray<int8_t> a(Shape{70, 120});
+    ndarray<int8_t> b(Shape{120, 150});
+    for (auto& v : a) v = static_cast<int8_t>(dist(gen));
+    for (auto& v : b) v = static_cast<int8_t>(dist(gen));
+    auto big = matmul_int8(a, b);
+    auto ref = matmul(a.astype<int32_t>(), b.astype<int32_t>());
+    for (size_t i = 0; i < big.size(); ++i) assert(big[i] == ref[i]);
+
+    bool threw = false;
+    try { matmul_int8(a, a); } catch (const std::runtime_error&) { threw = true; }
+    assert(threw);
+}
+
+/**
+ * @brief Test qmatmul() against float matmul.
+ */
+TEST_CASE(test_qmatmul) {
+    auto x = random_array({16, 64}, -1.0f, 3.0f, 4);
+    auto w = random_array({64, 24}, -0.5f, 0.5f, 5);
+    for (size_t j = 0; j < 24; ++j) w(0, j) *= static_cast<float>(j + 1);  // uneven column ranges
+    auto ref = matmul(x, w);
+
+    auto qx = quantize(x, 0, false);
+    for (int axis : {-2, 1}) {
+        auto qw = axis == 1 ? quantize(w, 1) : quantize(w);
+        auto y = qmatmul(qx, qw);
+        auto y2 = qmatmul(x, qw);  // dynamic per-row quantization of x
+        double err = 0.0, norm = 0.0;
+        for (size_t i = 0; i < ref.size(); ++i) {
+            err += (y[i] - ref[i]) * (y[i] - ref[i]);
+            norm += ref[i] * ref[i];
+            assert(y2[i] == y[i]);
+        }
+        assert(std::sqrt(err / norm) < (axis == 1 ? 0.02 : 0.05));  // per-column scales absorb the outliers
+    }
+
+    // Result equals the dequantized product up to float rounding
+    auto qw = quantize(w, 1, false);
+    auto exact = matmul(dequantize(qx), dequantize(qw));
+    auto y = qmatmul(qx, qw);
+    for (size_t i = 0; i < y.size(); ++i) assert(std::fabs(y[i] - exact[i]) < 1e-4f);
+
+    bool threw = false;
+    try { qmatmul(quantize(w, 1), qw); } catch (const std::runtime_error&) { threw = true; }
+    assert(threw);
+    threw = false;
+    try { qmatmul(qx, quantize(w, 0)); } catch (const std::runtime_error&) { threw = true; }
+    assert(threw);
+}
+
+/**
+ * @brief Test the INT8 dtype in binary I/O and runtime casts.
+ */
+TEST_CASE(test_int8_dtype) {
+    auto q = quantize(random_array({4, 6}, -2.0f, 2.0f, 6), 0);
+    dump(q.values, "test_quant_values.cb");
+    auto loaded = load<int8_t>("test_quant_values.cb");
+    std::remove("test_quant_values.cb");
+    for (size_t i = 0; i < loaded.size(); ++i) assert(loaded[i] == q.values[i]);
+
+    assert(dtype_from_type<int8_t>() == DType::INT8 && dtype_size(DType::INT8) == 1);
+    const int32_t wide[3] = {-300, 5, 200};
+    int8_t narrow[3];
+    cast(wide, DType::INT32, narrow, DType::INT8, 3, {true, false});
+    assert(narrow[0] == -128 && narrow[1] == 5 && narrow[2] == 127);
+}
+
+int main() {
+    std::cout << "=== NumBits Quantization Tests ===\n\n";
+
+    RUN_TEST(test_quantize);
+    RUN_TEST(test_matmul_int8);
+    RUN_TEST(test_qmatmul);
+    RUN_TEST(test_int8_dtype);
+
+    std::cout << "\nAll tests passed!\n";
+    return 0;
+}
@@ -0,0 +1,306 @@
+/**
+ * @file test_sorting.cpp
+ * @brief Unit tests for sorting, partitioning and top-k selection.
+ *
+ * Tests the following:
+ *   - sort() and argsort() along different axes, on the comparison-sort
+ *     and radix-sort paths, including negative values and NaN
+ *   - Stability of argsort(), including signed zeros on the radix path
+ *   - partition() and argpartition()
+ *   - topk() on the heap and introselect paths
+ *   - The parallel merge sort for large 1D inputs
+ *   - searchsorted() and interp() on sorted and unsorted queries
+ *
+ * @date 2025
+ */
+
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <vector>
+#include "numbits/numbits.hpp"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace numbits;
+
+#define TEST_CASE(name) void name()
+#define RUN_TEST(name)  \
+    std::cout << "Running " #name "... "; \
+    name(); \
+    std::cout << "OK\n";
+
+/**
+ * @brief Build a 1D array of `n` pseudo-random values in [lo, hi).
+ */
+template<typename T>
+static ndarray<T> random_array(size_t n, double lo, double hi, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> dist(lo, hi);
+    ndarray<T> arr(Shape{n});
+    for (size_t i = 0; i < n; ++i) arr[i] = static_cast<T>(dist(gen));
+    return arr;
+}
+
+/**
+ * @brief Test sort() on small and radix-sized inputs of several types.
+ */
+TEST_CASE(test_sort) {
+    ndarray<int> small({5}, {3, -1, 4, -1, 5});
+    auto s = sort(small);
+    assert(s[0] == -1 && s[1] == -1 && s[2] == 3 && s[4] == 5);
+
+    const size_t n = 5000;
+    auto f = random_array<float>(n, -1e6, 1e6, 1);
+    f[10] = std::numeric_limits<float>::quiet_NaN();
+    f[11] = -0.0f;
+    f[12] = -std::numeric_limits<float>::infinity();
+    auto sf = sort(f);
+    assert(std::isinf(sf[0]) && sf[0] < 0);
+    assert(std::isnan(sf[n - 1]));
+    for (size_t i = 1; i + 1 < n; ++i) assert(sf[i - 1] <= sf[i]);
+
+    auto d = random_array<double>(n, -1e12, 1e12, 2);
+    auto sd = sort(d);
+    std::vector<double> ref(d.begin(), d.end());
+    std::sort(ref.begin(), ref.end());
+    for (size_t i = 0; i < n; ++i) assert(sd[i] == ref[i]);
+
+    auto i64 = random_array<int64_t>(n, -4e18, 4e18, 3);
+    auto si = sort(i64);
+    for (size_t i = 1; i < n; ++i) assert(si[i - 1] <= si[i]);
+
+    ndarray<uint8_t> bytes(Shape{n});
+    for (size_t i = 0; i < n; ++i) bytes[i] = static_cast<uint8_t>((i * 37) % 251);
+    auto sb = sort(bytes);
+    for (size_t i = 1; i < n; ++i) assert(sb[i - 1] <= sb[i]);
+}
+
+/**
+ * @brief Test sort() and argsort() along each axis of a 2D array.
+ */
+TEST_CASE(test_sort_axes) {
+    ndarray<float> m({2, 3}, {3.0f, 1.0f, 2.0f, 0.0f, 5.0f, 4.0f});
+    auto rows = sort(m);
+    assert(rows(0, 0) == 1.0f && rows(0, 2) == 3.0f && rows(1, 1) == 4.0f);
+    auto cols = sort(m, 0);
+    assert(cols(0, 0) == 0.0f && cols(1, 0) == 3.0f && cols(0, 1) == 1.0f && cols(1, 2) == 4.0f);
+
+    auto ar = argsort(m, -1);
+    assert(ar(0, 0) == 1 && ar(0, 1) == 2 && ar(0, 2) == 0 && ar(1, 2) == 1);
+    auto ac = argsort(m, 0);
+    assert(ac(0, 0) == 1 && ac(1, 0) == 0 && ac(0, 1) == 0);
+
+    // Radix-sized lanes along axis 0 (strided)
+    const size_t len = 600;
+    auto flat = random_array<float>(len * 3, -10, 10, 4);
+    auto tall = flat.reshape({len, 3});
+    auto st = sort(tall, 0);
+    auto at = argsort(tall, 0);
+    for (size_t c = 0; c < 3; ++c)
+        for (size_t r = 0; r < len; ++r) {
+            if (r > 0) assert(st(r - 1, c) <= st(r, c));
+            assert(tall(static_cast<size_t>(at(r, c)), c) == st(r, c));
+        }
+
+    bool threw = false;
+    try { sort(m, 2); } catch (const std::runtime_error&) { threw = true; }
+    assert(threw);
+}
+
+/**
+ * @brief Test that argsort() keeps equal elements in their original order.
+ */
+TEST_CASE(test_argsort_stable) {
+    for (size_t n : {size_t(50), size_t(3000)}) {
+        ndarray<int32_t> keys(Shape{n});
+        for (size_t i = 0; i < n; ++i) keys[i] = static_cast<int32_t>((i * 7) % 5) - 2;
+        auto idx = argsort(keys);
+        for (size_t i = 1; i < n; ++i) {
+            int32_t a = keys[static_cast<size_t>(idx[i - 1])], b = keys[static_cast<size_t>(idx[i])];
+            assert(a < b || (a == b && idx[i - 1] < idx[i]));
+        }
+    }
+
+    // -0.0 and +0.0 are equal: the radix path must keep them in input order too
+    for (size_t n : {size_t(8), size_t(512)}) {
+        ndarray<double> zeros(Shape{n});
+        for (size_t i = 0; i < n; ++i) zeros[i] = (i % 2 == 0) ? 0.0 : -0.0;
+        zeros[n - 1] = -1.0;
+        auto idx = argsort(zeros);
+        assert(idx[0] == static_cast<int64_t>(n - 1));
+        for (size_t i = 1; i < n; ++i) assert(idx[i] == static_cast<int64_t>(i - 1));
+        auto f32 = argsort(zeros.astype<float>());
+        for (size_t i = 1; i < n; ++i) assert(f32[i] == static_cast<int64_t>(i - 1));
+    }
+    auto signed_zeros = sort(ndarray<double>({RADIX_SORT_MIN}, std::vector<double>(RADIX_SORT_MIN, -0.0)));
+    assert(std::signbit(signed_zeros[0]));  // value sorts keep the sign
+}
+
+/**
+ * @brief Test partition() and argpartition().
+ */
+TEST_CASE(test_partition) {
+    auto arr = random_array<double>(1000, 0, 1, 5);
+    const size_t kth = 321;
+    auto p = partition(arr, kth);
+    auto ref = sort(arr);
+    assert(p[kth] == ref[kth]);
+    for (size_t i = 0; i < kth; ++i) assert(p[i] <= p[kth]);
+    for (size_t i = kth + 1; i < 1000; ++i) assert(p[i] >= p[kth]);
+
+    ndarray<int> m({2, 4}, {9, 1, 8, 2, 7, 3, 6, 4});
+    auto ap = argpartition(m, 1, 1);
+    assert(m(0, static_cast<size_t>(ap(0, 1))) == 2 && m(1, static_cast<size_t>(ap(1, 1))) == 4);
+    auto pc = partition(m, 0, 0);
+    assert(pc(0, 0) == 7 && pc(1, 0) == 9);
+
+    bool threw = false;
+    try { partition(m, 4); } catch (const std::out_of_range&) { threw = true; }
+    assert(threw);
+}
+
+/**
+ * @brief Test topk() on both selection paths against a full sort.
+ */
+TEST_CASE(test_topk) {
+    const size_t rows = 4, cols = 2000;
+    auto flat = random_array<float>(rows * cols, -1, 1, 6);
+    auto scores = flat.reshape({rows, cols});
+    scores(2, 17) = 5.0f;
+    scores(2, 18) = 5.0f;  // tie: the lower index wins
+
+    for (size_t k : {size_t(10), size_t(500)}) {  // heap and introselect paths
+        auto best = topk(scores, k);
+        assert((best.values.shape() == Shape{rows, k}));
+        for (size_t r = 0; r < rows; ++r) {
+            std::vector<float> row(cols);
+            for (size_t c = 0; c < cols; ++c) row[c] = scores(r, c);
+            std::sort(row.begin(), row.end(), std::greater<float>());
+            for (size_t j = 0; j < k; ++j) {
+                assert(best.values(r, j) == row[j]);
+                assert(scores(r, static_cast<size_t>(best.indices(r, j))) == row[j]);
+            }
+        }
+        assert(best.indices(2, 0) == 17 && best.indices(2, 1) == 18);
+    }
+
+    auto low = topk(scores, 3, 1, false);
+    auto ref = sort(scores);
+    for (size_t r = 0; r < rows; ++r)
+        for (size_t j = 0; j < 3; ++j) assert(low.values(r, j) == ref(r, j));
+
+    // NaN counts as the largest value
+    auto nan_row = random_array<double>(1000, 0, 1, 8);
+    nan_row[500] = std::numeric_limits<double>::quiet_NaN();
+    auto hi = topk(nan_row, 2);
+    assert(std::isnan(hi.values[0]) && hi.indices[0] == 500 && hi.values[1] < 1.0);
+    auto lo = topk(nan_row, 2, -1, false);
+    assert(!std::isnan(lo.values[0]) && lo.values[0] <= lo.values[1]);
+
+    ndarray<int> col({3, 2}, {1, 6, 5, 2, 3, 4});
+    auto c = topk(col, 2, 0);
+    assert(c.values(0, 0) == 5 && c.values(1, 0) == 3 && c.indices(0, 1) == 0 && c.indices(1, 1) == 2);
+
+    bool threw = false;
+    try { topk(col, 4, 0); } catch (const std::out_of_range&) { threw = true; }
+    assert(threw);
+}
+
+/**
+ * @brief Test the chunked parallel merge sort on a large 1D array.
+ */
+TEST_CASE(test_parallel_sort) {
+#ifdef _OPENMP
+    int saved = omp_get_max_threads();
+    omp_set_num_threads(4);
+#endif
+    const size_t n = 300001;
+    auto arr = random_array<float>(n, -1000, 1000, 7);
+    for (size_t i = 0; i < n; i += 1000) arr[i] = 0.5f;  // duplicates across chunks
+
+    auto s = sort(arr);
+    auto idx = argsort(arr);
+    for (size_t i = 1; i < n; ++i) {
+        assert(s[i - 1] <= s[i]);
+        assert(arr[static_cast<size_t>(idx[i])] == s[i]);
+        if (s[i - 1] == s[i]) assert(idx[i - 1] < idx[i]);
+    }
+#ifdef _OPENMP
+    omp_set_num_threads(saved);
+#endif
+}
+
+/**
+ * @brief Test searchsorted() against std::lower_bound/upper_bound, and interp() built on it.
+ */
+TEST_CASE(test_searchsorted_interp) {
+    ndarray<int> a({6}, {1, 2, 2, 2, 5, 9});
+    ndarray<int> v({2, 3}, {2, 0, 10, 5, 3, 9});
+    auto left = searchsorted(a, v);
+    auto right = searchsorted(a, v, SearchSide::Right);
+    assert((left.shape() == Shape{2, 3}));
+    assert(left(0, 0) == 1 && right(0, 0) == 4 && left(0, 1) == 0 && left(0, 2) == 6);
+    assert(left(1, 0) == 4 && right(1, 0) == 5 && left(1, 1) == 4 && right(1, 2) == 6);
+    assert(searchsorted(a, 2) == 1 && searchsorted(a, 2, SearchSide::Right) == 4);
+
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    ndarray<float> fa({4}, {0.0f, 1.0f, nan, nan});
+    assert(searchsorted(fa, nan) == 2 && searchsorted(fa, nan, SearchSide::Right) == 4);
+    assert(searchsorted(fa, 5.0f) == 2);
+
+    // Random (binary search) and sorted (galloping) queries, enough for the parallel path
+    std::vector<double> table(5000);
+    for (size_t i = 0; i < table.size(); ++i) table[i] = static_cast<double>(i / 3);
+    ndarray<double> sorted_table({table.size()}, table);
+    auto queries = random_array<double>(40000, -10, 1700, 9);
+    auto sorted_queries = sort(queries);
+    for (const auto* q : {&queries, &sorted_queries}) {
+        auto lo = searchsorted(sorted_table, *q);
+        auto hi = searchsorted(sorted_table, *q, SearchSide::Right);
+        for (size_t i = 0; i < q->size(); ++i) {
+            double x = (*q)[i];
+            assert(lo[i] == std::lower_bound(table.begin(), table.end(), x) - table.begin());
+            assert(hi[i] == std::upper_bound(table.begin(), table.end(), x) - table.begin());
+        }
+    }
+
+    ndarray<double> xp({4}, {0.0, 1.0, 1.0, 3.0});
+    ndarray<double> fp({4}, {0.0, 10.0, 20.0, 40.0});
+    ndarray<double> x({6}, {-1.0, 0.5, 1.0, 2.0, 3.0, 7.0});
+    auto y = interp(x, xp, fp);
+    assert(y[0] == 0.0 && y[1] == 5.0 && y[3] == 30.0 && y[4] == 40.0 && y[5] == 40.0);
+    assert(y[2] == 20.0);  // duplicate sample: the right-most value wins, as in NumPy
+    ndarray<double> with_nan({1}, {std::numeric_limits<double>::quiet_NaN()});
+    assert(std::isnan(interp(with_nan, xp, fp)[0]));
+
+    auto line = interp(sorted_queries, sorted_table, sorted_table);
+    for (size_t i = 0; i < line.size(); ++i) {
+        double q = std::min(std::max(sorted_queries[i], 0.0), table.back());
+        assert(std::fabs(line[i] - q) <= 1.0);
+    }
+
+    bool threw = false;
+    try { searchsorted(ndarray<int>(Shape{2, 2}), v); } catch (const std::runtime_error&) { threw = true; }
+    assert(threw);
+}
+
+int main() {
+    std::cout << "=== NumBits Sorting Tests ===\n\n";
+
+    RUN_TEST(test_sort);
+    RUN_TEST(test_sort_axes);
+    RUN_TEST(test_argsort_stable);
+    RUN_TEST(test_partition);
+    RUN_TEST(test_topk);
+    RUN_TEST(test_parallel_sort);
+    RUN_TEST(test_searchsorted_interp);
+
+    std::cout << "\nAll tests passed!\n";
+    return 0;
+}
@@ -0,0 +1,256 @@
+/**
+ * @file test_sparse.cpp
+ * @brief Unit tests for the CSR, CSC and COO sparse matrix formats.
+ *
+ * Tests the following:
+ *   - Construction, validation and element access
+ *   - Conversions between dense, CSR, CSC and COO (duplicates summed)
+ *   - SpMV and SpMM against dense matmul, including skewed rows
+ *   - Dense x sparse products and transpose()
+ *   - Element-wise add/subtract/multiply and scalar multiplication
+ *   - dump()/load_sparse() round trips and corrupt files
+ *
+ * @date 2025
+ */
+
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <vector>
+#include "numbits/numbits.hpp"
+
+using namespace numbits;
+
+#define TEST_CASE(name) void name()
+#define RUN_TEST(name)  \
+    std::cout << "Running " #name "... "; \
+    name(); \
+    std::cout << "OK\n";
+
+/**
+ * @brief Build a dense matrix where roughly `density` of the elements are nonzero.
+ */
+static ndarray<double> random_sparse(size_t rows, size_t cols, double density, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    std::bernoulli_distribution keep(density);
+    ndarray<double> arr(Shape{rows, cols});
+    for (auto& x : arr) x = keep(gen) ? dist(gen) : 0.0;
+    return arr;
+}
+
+static bool near(const ndarray<double>& a, const ndarray<double>& b) {
+    if (a.shape() != b.shape()) return false;
+    for (size_t i = 0; i < a.size(); ++i)
+        if (std::fabs(a[i] - b[i]) > 1e-12) return false;
+    return true;
+}
+
+/**
+ * @brief Test construction, validation and conversions between formats.
+ */
+TEST_CASE(test_formats) {
+    ndarray<double> dense({3, 4}, {0.0, 2.0, 0.0, 1.0,
+                                   0.0, 0.0, 0.0, 0.0,
+                                   5.0, 0.0, 3.0, 0.0});
+    auto csr = csr_matrix<double>::from_dense(dense);
+    assert(csr.nnz() == 4 && (csr.shape() == Shape{3, 4}));
+    assert((csr.indptr() == std::vector<int64_t>{0, 2, 2, 4}));
+    assert((csr.indices() == std::vector<int64_t>{1, 3, 0, 2}));
+    assert(csr(2, 2) == 3.0 && csr(1, 1) == 0.0);
+    assert(near(csr.to_dense(), dense));
+
+    auto csc = csr.tocsc();
+    assert((csc.indptr() == std::vector<int64_t>{0, 1, 2, 3, 4}));
+    assert((csc.indices() == std::vector<int64_t>{2, 0, 2, 0}));
+    assert(near(csc.to_dense(), dense) && near(csc_matrix<double>::from_dense(dense).to_dense(), dense));
+    assert(csc.tocsr().indices() == csr.indices());
+
+    // COO keeps duplicates until conversion, where they are summed
+    coo_matrix<double> coo(3, 4);
+    coo.push_back(2, 2, 1.0);
+    coo.push_back(0, 3, 1.0);
+    coo.push_back(2, 0, 5.0);
+    coo.push_back(0, 1, 2.0);
+    coo.push_back(2, 2, 2.0);
+    assert(coo.nnz() == 5 && near(coo.to_dense(), dense));
+    auto from_coo = coo.tocsr();
+    assert(from_coo.nnz() == 4 && from_coo.indices() == csr.indices() && from_coo.data() == csr.data());
+    assert(coo.tocsc().indices() == csc.indices() && coo.tocsc().data() == csc.data());
+    assert(near(csr.tocoo().to_dense(), dense) && near(coo_matrix<double>::from_dense(dense).to_dense(), dense));
+
+    // Large random matrices take the parallel paths
+    auto big = random_sparse(600, 200, 0.3, 1);
+    auto big_csr = csr_matrix<double>::from_dense(big);
+    assert(near(big_csr.to_dense(), big) && near(big_csr.tocsc().to_dense(), big));
+    assert(near(big_csr.tocoo().tocsc().tocsr().to_dense(), big));
+
+    auto empty = csr_matrix<double>(0, 5);
+    assert(empty.nnz() == 0 && empty.to_dense().size() == 0);
+
+    bool threw = false;
+    try { csr_matrix<double>(2, 2, {0, 2, 2}, {1, 0}, {1.0, 2.0}); } catch (const std::runtime_error&) { threw = true; }
+    assert(threw);  // unsorted indices
+    threw = false;
+    try { csr_matrix<double>(2, 2, {0, 1, 2}, {0, 2}, {1.0, 2.0}); } catch (const std::runtime_error&) { threw = true; }
+    assert(threw);  // index out of range
+    threw = false;
+    try { csr_matrix<double>(2, 4, {0, 1000, 3}, {0, 1, 2}, {1.0, 2.0, 3.0}); } catch (const std::runtime_error&) { threw = true; }
+    assert(threw);  // indptr beyond nnz (must not read past indices)
+    threw = false;
+    try { csr_matrix<double>(2, 4, {0, -1, 3}, {0, 1, 2}, {1.0, 2.0, 3.0}); } catch (const std::runtime_error&) { threw = true; }
+    assert(threw);  // negative indptr
+    threw = false;
+    try { coo_matrix<double>(2, 2, {0, 1}, {0}, {1.0, 2.0}); } catch (const std::runtime_error&) { threw = true; }
+    assert(threw);
+    threw = false;
+    try { csr(3, 0); } catch (const std::out_of_range&) { threw = true; }
+    assert(threw);
+}
+
+/**
+ * @brief Test SpMV, SpMM and dense x sparse products against dense matmul.
+ */
+TEST_CASE(test_products) {
+    for (size_t m : {1, 17, 2000}) {
+        auto dense = random_sparse(m, 150, 0.05, static_cast<unsigned>(m));
+        // A few dense rows make the nonzero distribution skewed
+        for (size_t j = 0; j < 150; ++j) dense(m / 2, j) = 0.5;
+        auto csr = csr_matrix<double>::from_dense(dense);
+        auto csc = csr.tocsc();
+        auto x = random_sparse(150, 1, 1.0, 7).reshape({150});
+        auto xm = random_sparse(150, 9, 1.0, 8);
+
+        auto ref = matmul(dense, x.reshape({150, 1})).reshape({m});
+        assert(near(matmul(csr, x), ref) && near(matmul(csc, x), ref) && near(dot(csr, x), ref));
+        auto refm = matmul(dense, xm);
+        assert(near(matmul(csr, xm), refm) && near(matmul(csc, xm), refm));
+        assert(near(matmul(csr.tocoo(), xm), refm));
+
+        auto lhs = random_sparse(6, m, 1.0, 9);
+        auto refl = matmul(lhs, dense);
+        assert(near(matmul(lhs, csr), refl) && near(matmul(lhs, csc), refl) && near(dot(lhs, csr), refl));
+    }
+
+    // transpose() swaps formats and shares the layout
+    auto dense = random_sparse(5, 8, 0.4, 10);
+    auto csr = csr_matrix<double>::from_dense(dense);
+    csc_matrix<double> t = csr.transpose();
+    assert((t.shape() == Shape{8, 5}) && t.indptr() == csr.indptr());
+    assert(near(t.to_dense(), transpose(dense)));
+    assert(near(csr.tocoo().transpose().to_dense(), transpose(dense)));
+
+    // Integer and half-precision elements
+    auto ci = csr_matrix<int32_t>::from_dense(ndarray<int32_t>({2, 2}, {0, 3, 4, 0}));
+    auto yi = matmul(ci, ndarray<int32_t>({2}, {1, 2}));
+    assert(yi[0] == 6 && yi[1] == 4);
+    auto ch = csr_matrix<float16>::from_dense(ndarray<float>({1, 3}, {1.5f, 0.0f, 2.0f}).astype<float16>());
+    assert(static_cast<float>(matmul(ch, ndarray<float>({3}, {2.0f, 9.0f, 1.0f}).astype<float16>())[0]) == 5.0f);
+
+    bool threw = false;
+    try { matmul(csr, ndarray<double>(Shape{5})); } catch (const std::runtime_error&) { threw = true; }
+    assert(threw);
+    threw = false;
+    try { matmul(ndarray<double>(Shape{2, 4}), csr); } catch (const std::runtime_error&) { threw = true; }
+    assert(threw);
+}
+
+/**
+ * @brief Test element-wise operations between sparse matrices.
+ */
+TEST_CASE(test_elementwise) {
+    for (size_t rows : {4, 1500}) {
+        auto da = random_sparse(rows, 120, 0.2, 11);
+        auto db = random_sparse(rows, 120, 0.2, 12);
+        auto a = csr_matrix<double>::from_dense(da);
+        auto b = csr_matrix<double>::from_dense(db);
+        assert(near(add(a, b).to_dense(), add(da, db)));
+        assert(near(subtract(a, b).to_dense(), subtract(da, db)));
+        assert(near(multiply(a, b).to_dense(), multiply(da, db)));
+        assert(near(add(a.tocsc(), b.tocsc()).to_dense(), add(da, db)));
+        assert(near(multiply_scalar(a, 2.5).to_dense(), multiply_scalar(da, 2.5)));
+    }
+
+    // Results that cancel are not stored
+    auto a = csr_matrix<double>::from_dense(ndarray<double>({2, 2}, {1.0, 0.0, 2.0, 3.0}));
+    assert(subtract(a, a).nnz() == 0);
+    auto b = csr_matrix<double>::from_dense(ndarray<double>({2, 2}, {0.0, 4.0, 1.0, 0.0}));
+    auto p = multiply(a, b);
+    assert(p.nnz() == 1 && p(1, 0) == 2.0);
+
+    bool threw = false;
+    try { add(a, csr_matrix<double>(2, 3)); } catch (const std::runtime_error&) { threw = true; }
+    assert(threw);
+}
+
+/**
+ * @brief Test dump()/load_sparse() round trips and format conversion on load.
+ */
+TEST_CASE(test_sparse_io) {
+    auto dense = random_sparse(30, 20, 0.2, 13);
+    auto csr = csr_matrix<double>::from_dense(dense);
+    dump(csr, "test_sparse_csr");
+    auto back = load_sparse<csr_matrix<double>>("test_sparse_csr");
+    assert(back.indptr() == csr.indptr() && back.indices() == csr.indices() && back.data() == csr.data());
+    assert(near(load_sparse<csc_matrix<double>>("test_sparse_csr").to_dense(), dense));
+
+    dump(csr.tocoo(), "test_sparse_coo.cb");
+    assert(near(load_sparse<coo_matrix<double>>("test_sparse_coo.cb").to_dense(), dense));
+    dump(csr.tocsc(), "test_sparse_csc.cb");
+    assert(near(load_sparse<csr_matrix<double>>("test_sparse_csc.cb").to_dense(), dense));
+
+    bool threw = false;
+    try { load_sparse<csr_matrix<float>>("test_sparse_csr.cb"); } catch (const std::runtime_error&) { threw = true; }
+    assert(threw);
+    threw = false;
+    try { load<double>("test_sparse_csr.cb"); } catch (const std::runtime_error&) { threw = true; }
+    assert(threw);
+
+    dump(dense, "test_sparse_dense.cb");
+    threw = false;
+    try { load_sparse<csr_matrix<double>>("test_sparse_dense.cb"); } catch (const std::runtime_error&) { threw = true; }
+    assert(threw);
+
+    // Corrupt lengths are rejected before anything is allocated
+    {
+        std::ofstream out("test_sparse_bad.cb", std::ios::binary);
+        const uint32_t tag = CB_SPARSE_FLAG | static_cast<uint32_t>(SparseFormat::CSR);
+        const size_t dims[2] = {2, 2};
+        out.write(reinterpret_cast<const char*>(&tag), sizeof(tag));
+        out.write(reinterpret_cast<const char*>(dims), sizeof(dims));
+        write_cb_header(out, DType::INT64, Shape{size_t(1) << 40});
+    }
+    threw = false;
+    try { load_sparse<csr_matrix<double>>("test_sparse_bad.cb"); } catch (const std::runtime_error&) { threw = true; }
+    assert(threw);  // indptr longer than rows + 1
+
+    {
+        std::ifstream in("test_sparse_csr.cb", std::ios::binary);
+        std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        std::ofstream out("test_sparse_bad.cb", std::ios::binary);
+        out.write(bytes.data(), static_cast<std::streamsize>(bytes.size() - 8));
+    }
+    threw = false;
+    try { load_sparse<csr_matrix<double>>("test_sparse_bad.cb"); } catch (const std::runtime_error&) { threw = true; }
+    assert(threw);  // truncated data block
+
+    for (const char* f : {"test_sparse_csr.cb", "test_sparse_coo.cb", "test_sparse_csc.cb", "test_sparse_dense.cb",
+                          "test_sparse_bad.cb"})
+        std::remove(f);
+}
+
+int main() {
+    std::cout << "=== NumBits Sparse Matrix Tests ===\n\n";
+
+    RUN_TEST(test_formats);
+    RUN_TEST(test_products);
+    RUN_TEST(test_elementwise);
+    RUN_TEST(test_sparse_io);
+
+    std::cout << "\nAll tests passed!\n";
+    return 0;
+}
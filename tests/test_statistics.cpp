@@ -0,0 +1,273 @@
+/**
+ * @file test_statistics.cpp
+ * @brief Unit tests for quantiles, histograms, bincount and moments.
+ *
+ * Tests the following:
+ *   - quantile(), percentile() and median() over all elements and along axes
+ *   - Linear interpolation and NaN propagation
+ *   - histogram() with explicit and automatic ranges
+ *   - bincount() with and without weights, including the parallel path
+ *   - var(), std(), skew() and kurtosis() against two-pass references,
+ *     with ddof, bias correction, large offsets and the parallel merge
+ *
+ * @date 2025
+ */
+
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <vector>
+#include "numbits/numbits.hpp"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace numbits;
+
+#define TEST_CASE(name) void name()
+#define RUN_TEST(name)  \
+    std::cout << "Running " #name "... "; \
+    name(); \
+    std::cout << "OK\n";
+
+static bool approx(double a, double b, double tol = 1e-9) {
+    return std::fabs(a - b) <= tol * std::max(1.0, std::fabs(b));
+}
+
+/**
+ * @brief Reference quantile computed from a fully sorted copy.
+ */
+static double sorted_quantile(std::vector<double> v, double q) {
+    std::sort(v.begin(), v.end());
+    double pos = q * static_cast<double>(v.size() - 1);
+    size_t lo = static_cast<size_t>(std::floor(pos));
+    size_t hi = std::min(lo + 1, v.size() - 1);
+    return v[lo] + (pos - static_cast<double>(lo)) * (v[hi] - v[lo]);
+}
+
+/**
+ * @brief Test quantile(), percentile() and median() over all elements.
+ */
+TEST_CASE(test_quantiles) {
+    ndarray<int> small({5}, {7, 1, 5, 3, 9});
+    assert(median(small) == 5.0);
+    assert(quantile(small, 0.0) == 1.0 && quantile(small, 1.0) == 9.0);
+    assert(approx(quantile(small, 0.1), 1.8));
+    assert(approx(percentile(small, 75.0), 7.0));
+
+    ndarray<float> even({4}, {4.0f, 1.0f, 3.0f, 2.0f});
+    assert(median(even) == 2.5f);
+
+    std::mt19937 gen(3);
+    std::normal_distribution<double> dist;
+    ndarray<double> data(Shape{10001});
+    for (auto& x : data) x = dist(gen);
+    std::vector<double> copy(data.begin(), data.end());
+    std::vector<double> qs = {0.01, 0.25, 0.5, 0.5, 0.9, 0.999};
+    auto many = quantile(data, qs);
+    assert((many.shape() == Shape{qs.size()}));
+    for (size_t k = 0; k < qs.size(); ++k) assert(approx(many[k], sorted_quantile(copy, qs[k])));
+    auto pct = percentile(data, {1.0, 99.0});
+    assert(approx(pct[1], sorted_quantile(copy, 0.99)));
+
+    data[17] = std::numeric_limits<double>::quiet_NaN();
+    assert(std::isnan(median(data)));
+
+    bool threw = false;
+    try { quantile(small, 1.5); } catch (const std::runtime_error&) { threw = true; }
+    assert(threw);
+    threw = false;
+    try { median(ndarray<float>(Shape{0})); } catch (const std::runtime_error&) { threw = true; }
+    assert(threw);
+}
+
+/**
+ * @brief Test per-column and per-row quantiles.
+ */
+TEST_CASE(test_quantiles_along_axis) {
+    ndarray<float> m({3, 4}, {1, 9, 5, 0,
+                              3, 8, 6, 0,
+                              2, 7, 4, 0});
+    auto cols = median(m, 0);
+    assert((cols.shape() == Shape{4}));
+    assert(cols[0] == 2.0f && cols[1] == 8.0f && cols[2] == 5.0f && cols[3] == 0.0f);
+    auto rows = median(m, -1);
+    assert((rows.shape() == Shape{3}) && rows[0] == 3.0f && rows[1] == 4.5f);
+
+    auto q = quantile(m, {0.0, 1.0}, 0);
+    assert((q.shape() == Shape{2, 4}));
+    assert(q(0, 1) == 7.0f && q(1, 1) == 9.0f && q(1, 2) == 6.0f);
+    auto p = percentile(m, 50.0, 1);
+    assert(p[2] == 3.0f);
+
+    // Enough columns for the parallel lane path
+    const size_t nrows = 101, ncols = 300;
+    ndarray<int32_t> big(Shape{nrows, ncols});
+    for (size_t r = 0; r < nrows; ++r)
+        for (size_t c = 0; c < ncols; ++c) big(r, c) = static_cast<int32_t>((r * 37 + c) % nrows);
+    auto bm = median(big, 0);
+    for (size_t c = 0; c < ncols; ++c) assert(bm[c] == 50.0);
+}
+
+/**
+ * @brief Test histogram() binning, edges and range handling.
+ */
+TEST_CASE(test_histogram) {
+    ndarray<double> v({8}, {0.0, 0.5, 1.0, 1.5, 2.0, 2.5, 3.0, -1.0});
+    auto h = histogram(v, 3, 0.0, 3.0);
+    assert((h.counts.shape() == Shape{3}) && (h.bin_edges.shape() == Shape{4}));
+    assert(h.counts[0] == 2 && h.counts[1] == 2 && h.counts[2] == 3);  // 3.0 lands in the last bin
+    assert(h.bin_edges[0] == 0.0 && h.bin_edges[3] == 3.0);
+
+    auto automatic = histogram(v, 4);
+    assert(automatic.bin_edges[0] == -1.0 && automatic.bin_edges[4] == 3.0);
+    int64_t total = 0;
+    for (size_t b = 0; b < 4; ++b) total += automatic.counts[b];
+    assert(total == 8);
+
+    // Values on interior edges go to the upper bin despite rounding
+    ndarray<double> edges_only({10});
+    for (size_t i = 0; i < 10; ++i) edges_only[i] = 0.1 * static_cast<double>(i);
+    auto fine = histogram(edges_only, 10, 0.0, 1.0);
+    for (size_t b = 0; b < 10; ++b) assert(fine.counts[b] == 1);
+
+    const size_t n = 100000;
+    ndarray<float> many(Shape{n});
+    for (size_t i = 0; i < n; ++i) many[i] = static_cast<float>(i % 100) + 0.5f;
+    many[5] = std::numeric_limits<float>::quiet_NaN();
+    auto hm = histogram(many, 10, 0.0, 100.0);
+    assert(hm.counts[0] == 9999 && hm.counts[9] == 10000);
+
+    bool threw = false;
+    try { histogram(v, 3, 1.0, 1.0); } catch (const std::runtime_error&) { threw = true; }
+    assert(threw);
+}
+
+/**
+ * @brief Test bincount() with and without weights.
+ */
+TEST_CASE(test_bincount) {
+    ndarray<int> x({6}, {0, 1, 1, 3, 2, 1});
+    auto c = bincount(x);
+    assert((c.shape() == Shape{4}) && c[0] == 1 && c[1] == 3 && c[2] == 1 && c[3] == 1);
+    assert(bincount(x, 7).size() == 7);
+
+    ndarray<float> w({6}, {0.5f, 1.0f, 1.0f, 2.0f, 0.25f, 1.0f});
+    auto s = bincount(x, w);
+    assert(s[1] == 3.0 && s[3] == 2.0 && s[2] == 0.25);
+
+    const size_t n = 200000;
+    ndarray<int64_t> labels(Shape{n});
+    for (size_t i = 0; i < n; ++i) labels[i] = static_cast<int64_t>((i * 7919) % 1000);
+    auto lc = bincount(labels);
+    for (size_t b = 0; b < 1000; ++b) assert(lc[b] == 200);
+
+    bool threw = false;
+    try { bincount(ndarray<int>({2}, {1, -1})); } catch (const std::runtime_error&) { threw = true; }
+    assert(threw);
+}
+
+/**
+ * @brief Reference central moment sum of (x - mean)^k computed in two passes.
+ */
+static double central_sum(const std::vector<double>& v, int k) {
+    double mean = 0.0;
+    for (double x : v) mean += x;
+    mean /= static_cast<double>(v.size());
+    double s = 0.0;
+    for (double x : v) s += std::pow(x - mean, k);
+    return s;
+}
+
+/**
+ * @brief Test var(), std(), skew() and kurtosis() over all elements and along axes.
+ */
+TEST_CASE(test_moments) {
+    ndarray<int> small({4}, {1, 2, 3, 4});
+    assert(approx(var(small), 1.25) && approx(var(small, size_t(1)), 5.0 / 3.0));
+    assert(approx(numbits::std(small), std::sqrt(1.25)));
+    assert(approx(skew(small), 0.0, 1e-12) && approx(kurtosis(small), -1.36));
+    assert(approx(kurtosis(small, false), 1.64));
+    assert(std::isnan(var(small, size_t(4))));
+
+    ndarray<double> skewed({5}, {1.0, 2.0, 3.0, 4.0, 10.0});
+    std::vector<double> sv(skewed.begin(), skewed.end());
+    const double n = 5.0, m2 = central_sum(sv, 2) / n, m3 = central_sum(sv, 3) / n, m4 = central_sum(sv, 4) / n;
+    const double g1 = m3 / std::pow(m2, 1.5), g2 = m4 / (m2 * m2) - 3.0;
+    assert(approx(skew(skewed), g1) && approx(kurtosis(skewed), g2));
+    assert(approx(skew(skewed, false), g1 * std::sqrt(n * (n - 1.0)) / (n - 2.0)));
+    assert(approx(kurtosis(skewed, true, false), ((n + 1.0) * g2 + 6.0) * (n - 1.0) / ((n - 2.0) * (n - 3.0))));
+
+    // Many blocks and chunks around a large offset: no cancellation
+#ifdef _OPENMP
+    int saved = omp_get_max_threads();
+    omp_set_num_threads(4);
+#endif
+    std::mt19937 gen(5);
+    std::gamma_distribution<double> dist(2.0, 1.0);
+    ndarray<double> data(Shape{100003});
+    for (auto& x : data) x = 1e8 + dist(gen);
+    std::vector<double> dv(data.begin(), data.end());
+    const double dn = static_cast<double>(dv.size());
+    const double v2 = central_sum(dv, 2), v3 = central_sum(dv, 3), v4 = central_sum(dv, 4);
+    assert(approx(var(data), v2 / dn, 1e-7));
+    assert(approx(var(data, size_t(1)), v2 / (dn - 1.0), 1e-7));
+    assert(approx(skew(data), std::sqrt(dn) * v3 / std::pow(v2, 1.5), 1e-5));
+    assert(approx(kurtosis(data), dn * v4 / (v2 * v2) - 3.0, 1e-5));
+#ifdef _OPENMP
+    omp_set_num_threads(saved);
+#endif
+
+    ndarray<float> m({3, 4}, {1, 2, 3, 4,
+                              2, 4, 6, 8,
+                              0, 0, 0, 9});
+    auto rows = var(m, 1);
+    assert((rows.shape() == Shape{3}) && approx(rows[0], 1.25, 1e-6) && approx(rows[1], 5.0, 1e-6));
+    auto cols = numbits::std(m, 0, 1);
+    assert((cols.shape() == Shape{4}) && approx(cols[0], 1.0, 1e-6) && approx(cols[3], std::sqrt(7.0), 1e-6));
+    auto ks = kurtosis(m, -1);
+    assert(approx(ks[0], -1.36, 1e-5));
+    auto sk = skew(m, 0);
+    assert(approx(sk[3], skew(ndarray<float>({3}, {4, 8, 9})), 1e-5));
+
+    // Strided lanes wider than one lane group
+    ndarray<double> wide(Shape{7, 600});
+    for (size_t i = 0; i < wide.size(); ++i) wide[i] = static_cast<double>((i * 31) % 17);
+    auto wv = var(wide, 0, 1);
+    auto ws = skew(wide, 0);
+    for (size_t c = 0; c < 600; c += 37) {
+        std::vector<double> col(7);
+        for (size_t r = 0; r < 7; ++r) col[r] = wide(r, c);
+        assert(approx(wv[c], central_sum(col, 2) / 6.0));
+        assert(approx(ws[c], std::sqrt(7.0) * central_sum(col, 3) / std::pow(central_sum(col, 2), 1.5), 1e-9));
+    }
+
+    // Reducing an empty axis gives NaN for every output lane
+    ndarray<float> hollow(Shape{3, 0});
+    auto ev = var(hollow, 1);
+    assert((ev.shape() == Shape{3}) && std::isnan(ev[0]) && std::isnan(ev[2]));
+    assert(std::isnan(numbits::std(hollow, 1)[1]) && std::isnan(skew(hollow, -1)[0]));
+    assert(std::isnan(kurtosis(ndarray<double>(Shape{0, 2, 4}), 0)[7]));
+    assert(var(hollow, 0).size() == 0);
+
+    bool threw = false;
+    try { var(m, 2); } catch (const std::runtime_error&) { threw = true; }
+    assert(threw);
+}
+
+int main() {
+    std::cout << "=== NumBits Statistics Tests ===\n\n";
+
+    RUN_TEST(test_quantiles);
+    RUN_TEST(test_quantiles_along_axis);
+    RUN_TEST(test_histogram);
+    RUN_TEST(test_bincount);
+    RUN_TEST(test_moments);
+
+    std::cout << "\nAll tests passed!\n";
+    return 0;
+}